@@ -196,6 +196,8 @@ int32_t colDataSetVal(SColumnInfoData* pColumnInfoData, uint32_t rowIndex, const
 // it will be inserted at the original position and the old data will be overwritten.
 int32_t colDataSetValOrCover(SColumnInfoData* pColumnInfoData, uint32_t rowIndex, const char* pData, bool isNull);
 int32_t colDataReassignVal(SColumnInfoData* pColumnInfoData, uint32_t dstRowIdx, uint32_t srcRowIdx, const char* pData);
+// Make sure the buffer of a VAR_DATA_TYPE column is at least newSize bytes, no-op for other types.
+int32_t colDataReserve(SColumnInfoData* pColumnInfoData, size_t newSize);
 int32_t colDataSetNItems(SColumnInfoData* pColumnInfoData, uint32_t rowIndex, const char* pData, uint32_t numOfRows,
                          bool trimValue);
 void    colDataSetNItemsNull(SColumnInfoData* pColumnInfoData, uint32_t currentRow, uint32_t numOfRows);
@@ -234,6 +236,10 @@ double blockDataGetSerialRowSize(const SSDataBlock* pBlock);
 size_t blockDataGetSerialMetaSize(uint32_t numOfCols);
 
 int32_t blockDataSort(SSDataBlock* pDataBlock, SArray* pOrderInfo);
+/**
+ * @brief rearrange the rows of the block, row i of the result is row index[i] of the input
+ */
+int32_t blockDataReorder(SSDataBlock* pDataBlock, const int32_t* index);
 /**
  * @brief find how many rows already in order start from first row
  */
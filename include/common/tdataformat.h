@@ -190,6 +190,7 @@ void    tColDataArrGetRowKey(SColData *aColData, int32_t nColData, int32_t iRow,
 extern void (*tColDataCalcSMA[])(SColData *pColData, int64_t *sum, int64_t *max, int64_t *min, int16_t *numOfNull);
 
 int32_t tColDataCompress(SColData *colData, SColDataCompressInfo *info, SBuffer *output, SBuffer *assist);
+int32_t tColDataSelectCmprAlg(SColData *colData, uint32_t *cmprAlg, SBuffer *assist);
 int32_t tColDataDecompress(void *input, SColDataCompressInfo *info, SColData *colData, SBuffer *assist);
 
 // for stmt bind
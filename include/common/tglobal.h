@@ -266,6 +266,21 @@ extern int64_t tsmaDataDeleteMark;
 // wal
 extern int64_t tsWalFsyncDataSizeLimit;
 
+// tsdb
+extern bool    tsTsdbBloomFilter;               // build per-block bloom filters of the timestamps in data files
+extern int32_t tsTsdbPrefetchBlocks;            // number of data blocks to read ahead when scanning data files
+extern int32_t tsTsdbParallelScanThreads;       // threads of the dnode-wide pool scanning tables in parallel
+extern int32_t tsTsdbParallelScanMinTables;     // min number of tables for each parallel scan worker
+extern int32_t tsTsdbParallelScanVnodeWorkers;  // max parallel scan workers of all queries in one vnode
+extern bool    tsTsdbAdaptiveCompress;          // pick the compression algorithm of each column block by sampling
+extern bool    tsTsdbMemColumnar;               // store the rows of row-format submits as column blocks in the memtable
+extern int32_t tsTsdbCommitThreads;             // max number of threads committing the file sets of one vnode
+extern int32_t tsTsdbBlockCacheSize;            // MB of decompressed column chunks of data files cached by each vnode
+extern bool    tsTsdbZoneMap;                   // write per-block column min/max into .head files for query pruning
+extern int32_t tsTsdbDisorderWatermark;         // seconds, older file sets merge stt files with a larger trigger
+extern int32_t tsTsdbRollupInterval;            // seconds, data file blocks are cut at the boundaries of this interval
+extern bool    tsTsdbCacheWarmup;               // load the persisted last cache into memory in background at vnode open
+
 // internal
 extern bool    tsDiskIDCheckEnabled;
 extern int32_t tsTransPullupInterval;
@@ -290,6 +305,7 @@ extern int     tsStreamAggCnt;
 extern bool    tsFilterScalarMode;
 extern int32_t tsMaxStreamBackendCache;
 extern int32_t tsPQSortMemThreshold;
+extern int32_t tsHashJoinMemThreshold;
 extern bool    tsStreamCoverage;
 extern int8_t  tsS3EpNum;
 
@@ -2387,6 +2387,7 @@ typedef struct STableScanAnalyzeInfo {
   uint32_t filterOutBlocks;
   double   elapsedTime;
   double   filterTime;
+  uint32_t filterSkipBlocks;  // clean file blocks dropped by the reader on the filter columns, the others not loaded
 } STableScanAnalyzeInfo;
 
 int32_t tSerializeSExplainRsp(void* buf, int32_t bufLen, SExplainRsp* pRsp);
@@ -192,6 +192,7 @@ typedef struct TsdReader {
   void         (*tsdReaderNotifyClosing)();
 
   void         (*tsdSetFilesetDelimited)(void* pReader);
+  void         (*tsdSetBlockFilter)(void* pReader, void* pFilterInfo, const SArray* pFilterCols);
   void         (*tsdSetSetNotifyCb)(void* pReader, TsdReaderNotifyCbFn notifyFn, void* param);
 
   // for fileset query
@@ -95,6 +95,7 @@ int32_t taosFsyncFile(TdFilePtr pFile);
 
 int64_t taosReadFile(TdFilePtr pFile, void *buf, int64_t count);
 int64_t taosPReadFile(TdFilePtr pFile, void *buf, int64_t count, int64_t offset);
+int32_t taosReadAheadFile(TdFilePtr pFile, int64_t offset, int64_t count);
 int64_t taosWriteFile(TdFilePtr pFile, const void *buf, int64_t count);
 int64_t taosPWriteFile(TdFilePtr pFile, const void *buf, int64_t count, int64_t offset);
 void    taosFprintfFile(TdFilePtr pFile, const char *format, ...);
@@ -158,6 +158,9 @@ int32_t tsDecompressDoubleImpAvx2(const char *input, int32_t nelements, char *ou
 int32_t tsDecompressTimestampAvx2(const char *input, int32_t nelements, char *output, bool bigEndian);
 int32_t tsDecompressTimestampAvx512(const char *const input, const int32_t nelements, char *const output,
                                     bool bigEndian);
+int32_t tsCompressTimestampDeltaAvx2(const int64_t *input, int32_t start, int32_t nelements, uint64_t *output);
+int32_t tsCompressBoolImpAvx2(const char *const input, const int32_t nelements, char *const output);
+int32_t tsDecompressBoolImpAvx2(const char *const input, const int32_t nelements, char *const output);
 
 /*************************************************************************
  *                  REGULAR COMPRESSION 2
@@ -242,6 +245,7 @@ typedef enum {
   L1_XOR,
   L1_RLE,
   L1_DELTAD,
+  L1_DICT,  // dictionary of var data values, only chosen by tsdb for var data types
   L1_DISABLED = 0xFF,
 } TCmprL1Type;
 
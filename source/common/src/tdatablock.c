@@ -179,7 +179,7 @@ int32_t colDataReassignVal(SColumnInfoData* pColumnInfoData, uint32_t dstRowIdx,
   return 0;
 }
 
-static int32_t colDataReserve(SColumnInfoData* pColumnInfoData, size_t newSize) {
+int32_t colDataReserve(SColumnInfoData* pColumnInfoData, size_t newSize) {
   if (!IS_VAR_DATA_TYPE(pColumnInfoData->info.type)) {
     return TSDB_CODE_SUCCESS;
   }
@@ -1490,6 +1490,22 @@ int32_t blockDataSort(SSDataBlock* pDataBlock, SArray* pOrderInfo) {
   return TSDB_CODE_SUCCESS;
 }
 
+int32_t blockDataReorder(SSDataBlock* pDataBlock, const int32_t* index) {
+  if (pDataBlock->info.rows <= 1) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  SColumnInfoData* pCols = NULL;
+  int32_t          code = createHelpColInfoData(pDataBlock, &pCols);
+  if (code != 0) {
+    return code;
+  }
+
+  blockDataAssign(pCols, pDataBlock, index);
+  copyBackToBlock(pDataBlock, pCols);
+  return TSDB_CODE_SUCCESS;
+}
+
 void blockDataCleanup(SSDataBlock* pDataBlock) {
   blockDataEmpty(pDataBlock);
   SDataBlockInfo* pInfo = &pDataBlock->info;
@@ -2760,9 +2760,196 @@ _exit:
   return code;
 }
 
-int32_t tColDataCompress(SColData *colData, SColDataCompressInfo *info, SBuffer *output, SBuffer *assist) {
+#define COL_DATA_DICT_MAX_VALUES 4096  // distinct values of a block in a dictionary, besides the empty one
+
+typedef struct {
+  int32_t offset;
+  int32_t length;
+} SColDataDictEntry;
+
+static FORCE_INLINE int32_t tColDataVarValueLen(SColData *colData, int32_t iVal) {
+  return ((iVal + 1 < colData->nVal) ? colData->aOffset[iVal + 1] : colData->nData) - colData->aOffset[iVal];
+}
+
+/**
+ * Map the var data values of a column to dictionary codes. Code 0 is always the empty value, so rows without a
+ * value need no entry of their own. *nDict is set to -1 if more than maxDict other values are found. The codes and
+ * the dictionary (number of entries, end offset of each entry, then the value bytes) are only built if not NULL.
+ */
+static int32_t tColDataDictEncode(SColData *colData, int32_t maxDict, int32_t *codes, SBuffer *dict, int32_t *nDict) {
+  int32_t   code = 0;
+  SHashObj *hash = NULL;
+  SArray   *entries = NULL;
+
+  *nDict = -1;
+
+  hash = taosHashInit(64, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), false, HASH_NO_LOCK);
+  entries = taosArrayInit(64, sizeof(SColDataDictEntry));
+  if (hash == NULL || entries == NULL) {
+    code = terrno;
+    goto _exit;
+  }
+
+  SColDataDictEntry empty = {0};
+  if (taosArrayPush(entries, &empty) == NULL) {
+    code = terrno;
+    goto _exit;
+  }
+
+  for (int32_t iVal = 0; iVal < colData->nVal; iVal++) {
+    int32_t length = tColDataVarValueLen(colData, iVal);
+    int32_t dictCode = 0;
+
+    if (length > 0) {
+      uint8_t *value = colData->pData + colData->aOffset[iVal];
+      int32_t *pCode = (int32_t *)taosHashGet(hash, value, length);
+      if (pCode) {
+        dictCode = *pCode;
+      } else {
+        dictCode = (int32_t)taosArrayGetSize(entries);
+        if (dictCode > maxDict) {
+          goto _exit;
+        }
+
+        SColDataDictEntry entry = {.offset = colData->aOffset[iVal], .length = length};
+        if (taosArrayPush(entries, &entry) == NULL) {
+          code = terrno;
+          goto _exit;
+        }
+        code = taosHashPut(hash, value, length, &dictCode, sizeof(dictCode));
+        if (code) goto _exit;
+      }
+    }
+
+    if (codes) {
+      codes[iVal] = dictCode;
+    }
+  }
+
+  *nDict = (int32_t)taosArrayGetSize(entries);
+
+  if (dict) {
+    int32_t end = 0;
+
+    if ((code = tBufferPutI32(dict, *nDict))) goto _exit;
+    for (int32_t i = 0; i < *nDict; i++) {
+      end += ((SColDataDictEntry *)taosArrayGet(entries, i))->length;
+      if ((code = tBufferPutI32(dict, end))) goto _exit;
+    }
+    for (int32_t i = 0; i < *nDict; i++) {
+      SColDataDictEntry *entry = (SColDataDictEntry *)taosArrayGet(entries, i);
+      if ((code = tBufferPut(dict, colData->pData + entry->offset, entry->length))) goto _exit;
+    }
+  }
+
+_exit:
+  taosHashCleanup(hash);
+  taosArrayDestroy(entries);
+  return code;
+}
+
+/**
+ * Rebuild the offsets and values of a var data column from the dictionary codes stored in colData->aOffset.
+ */
+static int32_t tColDataDictDecode(SColData *colData, int32_t nCodes, const uint8_t *dict, int32_t dictSize) {
+  int32_t nDict;
+
+  // the codes are read from the offset part, which must hold one code per value
+  if (nCodes < colData->nVal) {
+    return TSDB_CODE_FILE_CORRUPTED;
+  }
+
+  if (dictSize < sizeof(int32_t)) {
+    return TSDB_CODE_FILE_CORRUPTED;
+  }
+  (void)memcpy(&nDict, dict, sizeof(int32_t));
+  if (nDict <= 0 || dictSize < sizeof(int32_t) * (1 + (int64_t)nDict)) {
+    return TSDB_CODE_FILE_CORRUPTED;
+  }
+
+  const int32_t *ends = (const int32_t *)(dict + sizeof(int32_t));
+  const uint8_t *values = dict + sizeof(int32_t) * (1 + nDict);
+  int32_t        valuesSize = dictSize - sizeof(int32_t) * (1 + nDict);
+  if (ends[nDict - 1] != valuesSize) {
+    return TSDB_CODE_FILE_CORRUPTED;
+  }
+  for (int32_t iDict = 0; iDict < nDict; iDict++) {
+    int32_t start = iDict ? ends[iDict - 1] : 0;
+    if (ends[iDict] < start || ends[iDict] > valuesSize) {
+      return TSDB_CODE_FILE_CORRUPTED;
+    }
+  }
+
+  int64_t nData = 0;
+  for (int32_t iVal = 0; iVal < colData->nVal; iVal++) {
+    int32_t dictCode = colData->aOffset[iVal];
+    if (dictCode < 0 || dictCode >= nDict) {
+      return TSDB_CODE_FILE_CORRUPTED;
+    }
+    nData += ends[dictCode] - (dictCode ? ends[dictCode - 1] : 0);
+  }
+  if (nData > INT32_MAX) {
+    return TSDB_CODE_FILE_CORRUPTED;
+  }
+
+  int32_t code = tRealloc(&colData->pData, nData);
+  if (code) return code;
+
+  colData->nData = 0;
+  for (int32_t iVal = 0; iVal < colData->nVal; iVal++) {
+    int32_t dictCode = colData->aOffset[iVal];
+    int32_t start = dictCode ? ends[dictCode - 1] : 0;
+    int32_t length = ends[dictCode] - start;
+
+    colData->aOffset[iVal] = colData->nData;
+    if (length > 0) {
+      (void)memcpy(colData->pData + colData->nData, values + start, length);
+      colData->nData += length;
+    }
+  }
+
+  return 0;
+}
+
+/**
+ * Compress the dictionary codes of a var data column in place of its offsets, and the dictionary in place of its
+ * values.
+ */
+static int32_t tColDataCompressDict(const int32_t *codes, SBuffer *dict, SColDataCompressInfo *info, SBuffer *output,
+                                    SBuffer *assist) {
   int32_t code;
-  SBuffer local;
+
+  info->offsetOriginalSize = sizeof(int32_t) * info->numOfData;
+
+  SCompressInfo cinfo = {
+      .dataType = TSDB_DATA_TYPE_INT,
+      .cmprAlg = info->cmprAlg,
+      .originalSize = info->offsetOriginalSize,
+  };
+  code = tCompressDataToBuffer((void *)codes, &cinfo, output, assist);
+  if (code) return code;
+  info->offsetCompressedSize = cinfo.compressedSize;
+
+  info->dataOriginalSize = dict->size;
+
+  cinfo = (SCompressInfo){
+      .dataType = info->dataType,
+      .cmprAlg = info->cmprAlg,
+      .originalSize = info->dataOriginalSize,
+  };
+  code = tCompressDataToBuffer(dict->data, &cinfo, output, assist);
+  if (code) return code;
+  info->dataCompressedSize = cinfo.compressedSize;
+
+  return 0;
+}
+
+int32_t tColDataCompress(SColData *colData, SColDataCompressInfo *info, SBuffer *output, SBuffer *assist) {
+  int32_t  code = 0;
+  int32_t  nDict = 0;
+  int32_t *codes = NULL;
+  SBuffer  local;
+  SBuffer  dict;
 
   if (!(colData->nVal > 0)) {
     return TSDB_CODE_INVALID_PARA;
@@ -2782,10 +2969,31 @@ int32_t tColDataCompress(SColData *colData, SColDataCompressInfo *info, SBuffer
   }
 
   tBufferInit(&local);
+  tBufferInit(&dict);
   if (assist == NULL) {
     assist = &local;
   }
 
+  // The dictionary is built before anything is written. A block with more distinct values than a dictionary holds is
+  // compressed without one, and info->cmprAlg, which the caller records with the block, is changed to match.
+  if (IS_VAR_DATA_TYPE(colData->type) && COMPRESS_L1_TYPE_U32(info->cmprAlg) == L1_DICT &&
+      colData->flag != (HAS_NONE | HAS_NULL)) {
+    codes = (int32_t *)taosMemoryMalloc(sizeof(int32_t) * colData->nVal);
+    if (codes == NULL) {
+      code = terrno;
+      goto _exit;
+    }
+
+    code = tColDataDictEncode(colData, COL_DATA_DICT_MAX_VALUES, codes, &dict, &nDict);
+    if (code) goto _exit;
+
+    if (nDict < 0) {
+      DEFINE_VAR(info->cmprAlg)
+      SET_COMPRESS(L1_DISABLED, l2, lvl, info->cmprAlg);
+      taosMemoryFreeClear(codes);
+    }
+  }
+
   // bitmap
   if (colData->flag != HAS_VALUE) {
     if (colData->flag == (HAS_NONE | HAS_NULL | HAS_VALUE)) {
@@ -2801,17 +3009,18 @@ int32_t tColDataCompress(SColData *colData, SColDataCompressInfo *info, SBuffer
     };
 
     code = tCompressDataToBuffer(colData->pBitMap, &cinfo, output, assist);
-    if (code) {
-      tBufferDestroy(&local);
-      return code;
-    }
+    if (code) goto _exit;
 
     info->bitmapCompressedSize = cinfo.compressedSize;
   }
 
   if (colData->flag == (HAS_NONE | HAS_NULL)) {
-    tBufferDestroy(&local);
-    return 0;
+    goto _exit;
+  }
+
+  if (codes) {
+    code = tColDataCompressDict(codes, &dict, info, output, assist);
+    goto _exit;
   }
 
   // offset
@@ -2825,10 +3034,7 @@ int32_t tColDataCompress(SColData *colData, SColDataCompressInfo *info, SBuffer
     };
 
     code = tCompressDataToBuffer(colData->aOffset, &cinfo, output, assist);
-    if (code) {
-      tBufferDestroy(&local);
-      return code;
-    }
+    if (code) goto _exit;
 
     info->offsetCompressedSize = cinfo.compressedSize;
   }
@@ -2844,16 +3050,117 @@ int32_t tColDataCompress(SColData *colData, SColDataCompressInfo *info, SBuffer
     };
 
     code = tCompressDataToBuffer(colData->pData, &cinfo, output, assist);
-    if (code) {
-      tBufferDestroy(&local);
-      return code;
-    }
+    if (code) goto _exit;
 
     info->dataCompressedSize = cinfo.compressedSize;
   }
 
+_exit:
+  taosMemoryFree(codes);
+  tBufferDestroy(&dict);
   tBufferDestroy(&local);
-  return 0;
+  return code;
+}
+
+#define COL_DATA_CMPR_SAMPLE_ROWS  1024
+#define COL_DATA_CMPR_SAMPLE_BYTES (16 * 1024)
+
+/**
+ * Choose the compression algorithm of one column block by compressing a sample of its data part with the
+ * candidate encodes and compressions. The algorithm configured for the column is the baseline, and another
+ * candidate only wins if its output is at least 1/16 smaller. Var data columns with few distinct values in the
+ * block are dictionary encoded on top of that. The chosen algorithm is written back to *cmprAlg and must be
+ * recorded with the block, since the bitmap and offset parts are compressed with it too. The trials are not cheap,
+ * so callers should run this once per column of a file and reuse the result rather than call it for every block.
+ */
+int32_t tColDataSelectCmprAlg(SColData *colData, uint32_t *cmprAlg, SBuffer *assist) {
+  int32_t code = 0;
+  SBuffer sample;
+
+  DEFINE_VAR(*cmprAlg)
+  // old style algorithms have no stages to choose from, and lossy compression is a user decision
+  if (l1 == L1_UNKNOWN || l2 == L2_TSZ) {
+    return 0;
+  }
+  if (colData->nVal <= 0 || colData->nData <= 0 || (colData->flag & HAS_VALUE) == 0) {
+    return 0;
+  }
+
+  int32_t sampleSize;
+  if (IS_VAR_DATA_TYPE(colData->type)) {
+    sampleSize = TMIN(colData->nData, COL_DATA_CMPR_SAMPLE_BYTES);
+  } else {
+    int32_t bytes = tDataTypes[colData->type].bytes;
+    sampleSize = TMIN(colData->nData / bytes, COL_DATA_CMPR_SAMPLE_ROWS) * bytes;
+  }
+  if (sampleSize <= 0) {
+    return 0;
+  }
+
+  // only the types below honour the encode in the algorithm, others always use their own one
+  uint8_t l1Candidates[2] = {l1, L1_DISABLED};
+  int32_t nL1 = 1;
+  if (l1 != L1_DISABLED && (colData->type == TSDB_DATA_TYPE_TIMESTAMP || colData->type == TSDB_DATA_TYPE_FLOAT ||
+                            colData->type == TSDB_DATA_TYPE_DOUBLE)) {
+    nL1 = 2;
+  }
+  // xz is left out, it costs too much to try and to decode for what it may save over zstd
+  uint8_t l2Candidates[] = {l2, L2_LZ4, L2_ZSTD, L2_DISABLED};
+
+  tBufferInit(&sample);
+  code = tBufferEnsureCapacity(&sample, sampleSize + COMP_OVERFLOW_BYTES);
+  if (code) {
+    goto _exit;
+  }
+
+  uint32_t bestAlg = *cmprAlg;
+  int32_t  bestSize = -1;
+  for (int32_t i = 0; i < nL1; i++) {
+    for (int32_t j = 0; j < sizeof(l2Candidates) / sizeof(l2Candidates[0]); j++) {
+      if (j > 0 && l2Candidates[j] == l2) {
+        continue;
+      }
+
+      uint32_t      alg = *cmprAlg;
+      SCompressInfo cinfo = {
+          .dataType = colData->type,
+          .originalSize = sampleSize,
+      };
+      SET_COMPRESS(l1Candidates[i], l2Candidates[j], lvl, alg);
+      cinfo.cmprAlg = alg;
+
+      code = tCompressData(colData->pData, &cinfo, sample.data, sample.capacity, assist);
+      if (code) {
+        goto _exit;
+      }
+
+      if (bestSize < 0) {
+        bestSize = cinfo.compressedSize;  // the configured algorithm
+      } else if (cinfo.compressedSize < bestSize - (bestSize >> 4)) {
+        bestSize = cinfo.compressedSize;
+        bestAlg = alg;
+      }
+    }
+  }
+
+  // low cardinality var data is stored as dictionary codes, with the values compressed as chosen above
+  if (IS_VAR_DATA_TYPE(colData->type)) {
+    int32_t nDict = 0;
+
+    code = tColDataDictEncode(colData, COL_DATA_DICT_MAX_VALUES, NULL, NULL, &nDict);
+    if (code) {
+      goto _exit;
+    }
+    if (nDict > 0 && (int64_t)nDict * 4 <= colData->numOfValue) {
+      SET_COMPRESS(L1_DICT, COMPRESS_L2_TYPE_U32(bestAlg), lvl, bestAlg);
+    }
+  }
+
+  *cmprAlg = bestAlg;
+
+_exit:
+  tBufferDestroy(&sample);
+  return code;
 }
 
 int32_t tColDataDecompress(void *input, SColDataCompressInfo *info, SColData *colData, SBuffer *assist) {
@@ -2930,7 +3237,29 @@ int32_t tColDataDecompress(void *input, SColDataCompressInfo *info, SColData *co
   }
 
   // data
-  if (info->dataOriginalSize > 0) {
+  if (IS_VAR_DATA_TYPE(info->dataType) && COMPRESS_L1_TYPE_U32(info->cmprAlg) == L1_DICT) {
+    SCompressInfo cinfo = {
+        .cmprAlg = info->cmprAlg,
+        .dataType = colData->type,
+        .originalSize = info->dataOriginalSize,
+        .compressedSize = info->dataCompressedSize,
+    };
+
+    SBuffer dict;
+
+    tBufferInit(&dict);
+    code = tDecompressDataToBuffer(data, &cinfo, &dict, assist);
+    if (code == 0) {
+      code = tColDataDictDecode(colData, info->offsetOriginalSize / sizeof(int32_t), dict.data, dict.size);
+    }
+    tBufferDestroy(&dict);
+    if (code) {
+      tBufferDestroy(&local);
+      return code;
+    }
+
+    data += cinfo.compressedSize;
+  } else if (info->dataOriginalSize > 0) {
     colData->nData = info->dataOriginalSize;
 
     SCompressInfo cinfo = {
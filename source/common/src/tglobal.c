@@ -100,6 +100,7 @@ int32_t tsNumOfSnodeStreamThreads = 4;
 int32_t tsNumOfSnodeWriteThreads = 1;
 int32_t tsMaxStreamBackendCache = 128;  // M
 int32_t tsPQSortMemThreshold = 16;      // M
+int32_t tsHashJoinMemThreshold = 1024;  // M
 int32_t tsRetentionSpeedLimitMB = 0;    // unlimited
 
 int32_t tsNumOfCompactThreads = 2;
@@ -298,6 +299,21 @@ bool    tsStartUdfd = true;
 // wal
 int64_t tsWalFsyncDataSizeLimit = (100 * 1024 * 1024L);
 
+// tsdb
+bool    tsTsdbBloomFilter = false;
+int32_t tsTsdbPrefetchBlocks = 0;
+int32_t tsTsdbParallelScanThreads = 1;
+int32_t tsTsdbParallelScanMinTables = 10000;
+int32_t tsTsdbParallelScanVnodeWorkers = 4;
+bool    tsTsdbAdaptiveCompress = false;
+bool    tsTsdbMemColumnar = false;
+int32_t tsTsdbCommitThreads = 1;
+int32_t tsTsdbBlockCacheSize = 0;
+bool    tsTsdbZoneMap = false;
+int32_t tsTsdbDisorderWatermark = 0;
+int32_t tsTsdbRollupInterval = 0;
+bool    tsTsdbCacheWarmup = false;
+
 // ttl
 bool    tsTtlChangeOnWrite = false;  // if true, ttl delete time changes on last write
 int32_t tsTtlFlushThreshold = 100;   /* maximum number of dirty items in memory.
@@ -925,6 +941,20 @@ static int32_t taosAddServerCfg(SConfig *pCfg) {
 
   TAOS_CHECK_RETURN(cfgAddInt64(pCfg, "walFsyncDataSizeLimit", tsWalFsyncDataSizeLimit, 100 * 1024 * 1024, INT64_MAX, CFG_SCOPE_SERVER, CFG_DYN_NONE,CFG_CATEGORY_GLOBAL));
 
+  TAOS_CHECK_RETURN(cfgAddBool(pCfg, "tsdbBloomFilter", tsTsdbBloomFilter, CFG_SCOPE_SERVER, CFG_DYN_SERVER,CFG_CATEGORY_LOCAL));
+  TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "tsdbPrefetchBlocks", tsTsdbPrefetchBlocks, 0, 1024, CFG_SCOPE_SERVER, CFG_DYN_SERVER,CFG_CATEGORY_LOCAL));
+  TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "tsdbParallelScanThreads", tsTsdbParallelScanThreads, 1, 64, CFG_SCOPE_SERVER, CFG_DYN_SERVER_LAZY,CFG_CATEGORY_LOCAL));
+  TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "tsdbParallelScanMinTables", tsTsdbParallelScanMinTables, 1, INT32_MAX, CFG_SCOPE_SERVER, CFG_DYN_SERVER,CFG_CATEGORY_LOCAL));
+  TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "tsdbParallelScanVnodeWorkers", tsTsdbParallelScanVnodeWorkers, 2, 64, CFG_SCOPE_SERVER, CFG_DYN_SERVER,CFG_CATEGORY_LOCAL));
+  TAOS_CHECK_RETURN(cfgAddBool(pCfg, "tsdbAdaptiveCompress", tsTsdbAdaptiveCompress, CFG_SCOPE_SERVER, CFG_DYN_SERVER,CFG_CATEGORY_LOCAL));
+  TAOS_CHECK_RETURN(cfgAddBool(pCfg, "tsdbMemColumnar", tsTsdbMemColumnar, CFG_SCOPE_SERVER, CFG_DYN_SERVER,CFG_CATEGORY_LOCAL));
+  TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "tsdbCommitThreads", tsTsdbCommitThreads, 1, 64, CFG_SCOPE_SERVER, CFG_DYN_SERVER,CFG_CATEGORY_LOCAL));
+  TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "tsdbBlockCacheSize", tsTsdbBlockCacheSize, 0, 65536, CFG_SCOPE_SERVER, CFG_DYN_SERVER,CFG_CATEGORY_LOCAL));
+  TAOS_CHECK_RETURN(cfgAddBool(pCfg, "tsdbZoneMap", tsTsdbZoneMap, CFG_SCOPE_SERVER, CFG_DYN_SERVER,CFG_CATEGORY_LOCAL));
+  TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "tsdbDisorderWatermark", tsTsdbDisorderWatermark, 0, 31536000, CFG_SCOPE_SERVER, CFG_DYN_SERVER,CFG_CATEGORY_LOCAL));
+  TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "tsdbRollupInterval", tsTsdbRollupInterval, 0, 86400, CFG_SCOPE_SERVER, CFG_DYN_SERVER,CFG_CATEGORY_LOCAL));
+  TAOS_CHECK_RETURN(cfgAddBool(pCfg, "tsdbCacheWarmup", tsTsdbCacheWarmup, CFG_SCOPE_SERVER, CFG_DYN_SERVER,CFG_CATEGORY_LOCAL));
+
   TAOS_CHECK_RETURN(cfgAddBool(pCfg, "udf", tsStartUdfd, CFG_SCOPE_SERVER, CFG_DYN_SERVER_LAZY,CFG_CATEGORY_GLOBAL));
   TAOS_CHECK_RETURN(cfgAddString(pCfg, "udfdResFuncs", tsUdfdResFuncs, CFG_SCOPE_SERVER, CFG_DYN_SERVER_LAZY,CFG_CATEGORY_GLOBAL));
   TAOS_CHECK_RETURN(cfgAddString(pCfg, "udfdLdLibPath", tsUdfdLdLibPath, CFG_SCOPE_SERVER, CFG_DYN_SERVER_LAZY,CFG_CATEGORY_GLOBAL));
@@ -952,6 +982,7 @@ static int32_t taosAddServerCfg(SConfig *pCfg) {
   TAOS_CHECK_RETURN(cfgAddBool(pCfg, "filterScalarMode", tsFilterScalarMode, CFG_SCOPE_SERVER, CFG_DYN_NONE,CFG_CATEGORY_LOCAL));
   TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "maxStreamBackendCache", tsMaxStreamBackendCache, 16, 1024, CFG_SCOPE_SERVER, CFG_DYN_ENT_SERVER_LAZY,CFG_CATEGORY_LOCAL));
   TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "pqSortMemThreshold", tsPQSortMemThreshold, 1, 10240, CFG_SCOPE_SERVER, CFG_DYN_NONE,CFG_CATEGORY_LOCAL));
+  TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "hashJoinMemThreshold", tsHashJoinMemThreshold, 32, 1048576, CFG_SCOPE_SERVER, CFG_DYN_NONE,CFG_CATEGORY_LOCAL));
 
   TAOS_CHECK_RETURN(cfgAddString(pCfg, "s3Accesskey", tsS3AccessKey[0], CFG_SCOPE_SERVER, CFG_DYN_ENT_SERVER_LAZY,CFG_CATEGORY_GLOBAL));
   TAOS_CHECK_RETURN(cfgAddString(pCfg, "s3Endpoint", tsS3Endpoint[0], CFG_SCOPE_SERVER, CFG_DYN_ENT_SERVER_LAZY,CFG_CATEGORY_GLOBAL));
@@ -1716,6 +1747,45 @@ static int32_t taosSetServerCfg(SConfig *pCfg) {
   TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "walFsyncDataSizeLimit");
   tsWalFsyncDataSizeLimit = pItem->i64;
 
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "tsdbBloomFilter");
+  tsTsdbBloomFilter = pItem->bval;
+
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "tsdbPrefetchBlocks");
+  tsTsdbPrefetchBlocks = pItem->i32;
+
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "tsdbParallelScanThreads");
+  tsTsdbParallelScanThreads = pItem->i32;
+
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "tsdbParallelScanMinTables");
+  tsTsdbParallelScanMinTables = pItem->i32;
+
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "tsdbParallelScanVnodeWorkers");
+  tsTsdbParallelScanVnodeWorkers = pItem->i32;
+
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "tsdbAdaptiveCompress");
+  tsTsdbAdaptiveCompress = pItem->bval;
+
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "tsdbMemColumnar");
+  tsTsdbMemColumnar = pItem->bval;
+
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "tsdbCommitThreads");
+  tsTsdbCommitThreads = pItem->i32;
+
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "tsdbBlockCacheSize");
+  tsTsdbBlockCacheSize = pItem->i32;
+
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "tsdbZoneMap");
+  tsTsdbZoneMap = pItem->bval;
+
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "tsdbDisorderWatermark");
+  tsTsdbDisorderWatermark = pItem->i32;
+
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "tsdbRollupInterval");
+  tsTsdbRollupInterval = pItem->i32;
+
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "tsdbCacheWarmup");
+  tsTsdbCacheWarmup = pItem->bval;
+
   TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "syncElectInterval");
   tsElectInterval = pItem->i32;
 
@@ -1815,6 +1885,9 @@ static int32_t taosSetServerCfg(SConfig *pCfg) {
   TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "pqSortMemThreshold");
   tsPQSortMemThreshold = pItem->i32;
 
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "hashJoinMemThreshold");
+  tsHashJoinMemThreshold = pItem->i32;
+
   TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "minDiskFreeSize");
   tsMinDiskFreeSize = pItem->i64;
 
@@ -2460,6 +2533,18 @@ static int32_t taosCfgDynamicOptionsForServer(SConfig *pCfg, const char *name) {
                                          {"syncHeartbeatTimeout", &tsHeartbeatTimeout},
                                          {"syncSnapReplMaxWaitN", &tsSnapReplMaxWaitN},
                                          {"walFsyncDataSizeLimit", &tsWalFsyncDataSizeLimit},
+                                         {"tsdbBloomFilter", &tsTsdbBloomFilter},
+                                         {"tsdbPrefetchBlocks", &tsTsdbPrefetchBlocks},
+                                         {"tsdbParallelScanMinTables", &tsTsdbParallelScanMinTables},
+                                         {"tsdbParallelScanVnodeWorkers", &tsTsdbParallelScanVnodeWorkers},
+                                         {"tsdbAdaptiveCompress", &tsTsdbAdaptiveCompress},
+                                         {"tsdbMemColumnar", &tsTsdbMemColumnar},
+                                         {"tsdbCommitThreads", &tsTsdbCommitThreads},
+                                         {"tsdbBlockCacheSize", &tsTsdbBlockCacheSize},
+                                         {"tsdbZoneMap", &tsTsdbZoneMap},
+                                         {"tsdbDisorderWatermark", &tsTsdbDisorderWatermark},
+                                         {"tsdbRollupInterval", &tsTsdbRollupInterval},
+                                         {"tsdbCacheWarmup", &tsTsdbCacheWarmup},
 
                                          {"numOfCores", &tsNumOfCores},
 
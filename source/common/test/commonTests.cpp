@@ -304,6 +304,56 @@ TEST(testCase, Datablock_test) {
   taosArrayDestroy(pOrderInfo);
 }
 
+TEST(testCase, Datablock_reorder_test) {
+  SSDataBlock* b = NULL;
+  int32_t      code = createDataBlock(&b);
+  ASSERT(code == 0);
+
+  SColumnInfoData infoData = createColumnInfoData(TSDB_DATA_TYPE_INT, 4, 1);
+  blockDataAppendColInfo(b, &infoData);
+  SColumnInfoData infoData1 = createColumnInfoData(TSDB_DATA_TYPE_BINARY, 40, 2);
+  blockDataAppendColInfo(b, &infoData1);
+  blockDataEnsureCapacity(b, 8);
+
+  SColumnInfoData* p0 = (SColumnInfoData*)taosArrayGet(b->pDataBlock, 0);
+  SColumnInfoData* p1 = (SColumnInfoData*)taosArrayGet(b->pDataBlock, 1);
+
+  char buf[32] = {0};
+  char varbuf[64] = {0};
+  for (int32_t i = 0; i < 8; ++i) {
+    bool isNull = (i % 3 == 0);
+    sprintf(buf, "row-%d", i);
+    STR_TO_VARSTR(varbuf, buf);
+    colDataSetVal(p0, i, (const char*)&i, isNull);
+    colDataSetVal(p1, i, (const char*)varbuf, isNull);
+    b->info.rows++;
+  }
+
+  int32_t index[8] = {7, 5, 3, 1, 0, 2, 4, 6};
+  ASSERT_EQ(blockDataReorder(b, index), 0);
+
+  p0 = (SColumnInfoData*)taosArrayGet(b->pDataBlock, 0);
+  p1 = (SColumnInfoData*)taosArrayGet(b->pDataBlock, 1);
+  for (int32_t i = 0; i < 8; ++i) {
+    int32_t src = index[i];
+    if (src % 3 == 0) {
+      ASSERT_EQ(colDataIsNull(p0, b->info.rows, i, nullptr), true);
+      ASSERT_EQ(colDataIsNull(p1, b->info.rows, i, nullptr), true);
+      continue;
+    }
+
+    ASSERT_EQ(colDataIsNull(p0, b->info.rows, i, nullptr), false);
+    ASSERT_EQ(*(int32_t*)colDataGetData(p0, i), src);
+
+    sprintf(buf, "row-%d", src);
+    char* pData = colDataGetData(p1, i);
+    ASSERT_EQ(varDataLen(pData), strlen(buf));
+    ASSERT_EQ(memcmp(varDataVal(pData), buf, varDataLen(pData)), 0);
+  }
+
+  blockDataDestroy(b);
+}
+
 #if 0
 TEST(testCase, non_var_dataBlock_split_test) {
   SSDataBlock* b = static_cast<SSDataBlock*>(taosMemoryCalloc(1, sizeof(SSDataBlock)));
@@ -464,6 +464,226 @@ TEST(testCase, tColDataGetValue) {
 }
 #endif
 
+TEST(testCase, tColDataSelectCmprAlg) {
+  SColData colData = {0};
+  SColData outData = {0};
+  SBuffer  output;
+  SBuffer  assist;
+  int32_t  nRows = 4096;
+
+  tBufferInit(&output);
+  tBufferInit(&assist);
+  tColDataInit(&colData, 2, TSDB_DATA_TYPE_BIGINT, 0);
+  for (int32_t i = 0; i < nRows; i++) {
+    SValue  value = {.type = TSDB_DATA_TYPE_BIGINT};
+    value.val = (i % 7 == 0) ? 0 : 1000000007LL * (i % 13);
+    SColVal colVal = COL_VAL_VALUE(2, value);
+    if (i % 11 == 0) {
+      colVal = COL_VAL_NULL(2, TSDB_DATA_TYPE_BIGINT);
+    }
+    ASSERT_EQ(tColDataAppendValue(&colData, &colVal), 0);
+  }
+
+  // old style algorithms are left as they are
+  uint32_t alg = TWO_STAGE_COMP;
+  ASSERT_EQ(tColDataSelectCmprAlg(&colData, &alg, &assist), 0);
+  ASSERT_EQ(alg, TWO_STAGE_COMP);
+
+  alg = 0;
+  SET_COMPRESS(L1_SIMPLE_8B, L2_LZ4, L2_LVL_MEDIUM, alg);
+  ASSERT_EQ(tColDataSelectCmprAlg(&colData, &alg, &assist), 0);
+  ASSERT_EQ(COMPRESS_L1_TYPE_U32(alg), L1_SIMPLE_8B);
+  ASSERT_EQ(COMPRESS_L2_TYPE_LEVEL_U32(alg), L2_LVL_MEDIUM);
+  ASSERT_NE(COMPRESS_L2_TYPE_U32(alg), L2_XZ);
+
+  // the block must round trip with whatever algorithm is chosen
+  SColDataCompressInfo info = {.cmprAlg = alg};
+  ASSERT_EQ(tColDataCompress(&colData, &info, &output, &assist), 0);
+  ASSERT_EQ(tColDataDecompress(output.data, &info, &outData, &assist), 0);
+  ASSERT_EQ(outData.nVal, nRows);
+  for (int32_t i = 0; i < nRows; i++) {
+    SColVal cv1, cv2;
+    ASSERT_EQ(tColDataGetValue(&colData, i, &cv1), 0);
+    ASSERT_EQ(tColDataGetValue(&outData, i, &cv2), 0);
+    ASSERT_EQ(cv1.flag, cv2.flag);
+    if (COL_VAL_IS_VALUE(&cv1)) {
+      ASSERT_EQ(cv1.value.val, cv2.value.val);
+    }
+  }
+
+  tColDataDestroy(&colData);
+  tColDataDestroy(&outData);
+  tBufferDestroy(&output);
+  tBufferDestroy(&assist);
+}
+
+TEST(testCase, tColDataDictCompress) {
+  const char *labels[] = {"ok", "warning", "error", "", "timeout", "retry"};
+  SColData    colData = {0};
+  SColData    outData = {0};
+  SBuffer     output;
+  SBuffer     assist;
+  int32_t     nRows = 4096;
+
+  tBufferInit(&output);
+  tBufferInit(&assist);
+  tColDataInit(&colData, 2, TSDB_DATA_TYPE_VARCHAR, 0);
+  for (int32_t i = 0; i < nRows; i++) {
+    const char *label = labels[(i * 7) % 6];
+    SValue      value = {.type = TSDB_DATA_TYPE_VARCHAR};
+    value.pData = (uint8_t *)label;
+    value.nData = strlen(label);
+    SColVal colVal = COL_VAL_VALUE(2, value);
+    if (i % 5 == 0) {
+      colVal = COL_VAL_NONE(2, TSDB_DATA_TYPE_VARCHAR);
+    } else if (i % 9 == 0) {
+      colVal = COL_VAL_NULL(2, TSDB_DATA_TYPE_VARCHAR);
+    }
+    ASSERT_EQ(tColDataAppendValue(&colData, &colVal), 0);
+  }
+
+  uint32_t alg = 0;
+  SET_COMPRESS(L1_DISABLED, L2_ZSTD, L2_LVL_MEDIUM, alg);
+  ASSERT_EQ(tColDataSelectCmprAlg(&colData, &alg, &assist), 0);
+  ASSERT_EQ(COMPRESS_L1_TYPE_U32(alg), L1_DICT);
+
+  SColDataCompressInfo info = {.cmprAlg = alg};
+  ASSERT_EQ(tColDataCompress(&colData, &info, &output, &assist), 0);
+  ASSERT_EQ(tColDataDecompress(output.data, &info, &outData, &assist), 0);
+  ASSERT_EQ(outData.nVal, nRows);
+  ASSERT_EQ(outData.nData, colData.nData);
+  for (int32_t i = 0; i < nRows; i++) {
+    SColVal cv1, cv2;
+    ASSERT_EQ(tColDataGetValue(&colData, i, &cv1), 0);
+    ASSERT_EQ(tColDataGetValue(&outData, i, &cv2), 0);
+    ASSERT_EQ(cv1.flag, cv2.flag);
+    if (COL_VAL_IS_VALUE(&cv1)) {
+      ASSERT_EQ(cv1.value.nData, cv2.value.nData);
+      ASSERT_EQ(memcmp(cv1.value.pData, cv2.value.pData, cv1.value.nData), 0);
+    }
+  }
+
+  tColDataDestroy(&colData);
+  tColDataDestroy(&outData);
+  tBufferDestroy(&output);
+  tBufferDestroy(&assist);
+}
+
+TEST(testCase, tColDataDictFallback) {
+  SColData colData = {0};
+  SColData outData = {0};
+  SBuffer  output;
+  SBuffer  assist;
+  int32_t  nRows = 8192;
+  char     buf[32];
+
+  tBufferInit(&output);
+  tBufferInit(&assist);
+  tColDataInit(&colData, 2, TSDB_DATA_TYPE_VARCHAR, 0);
+  for (int32_t i = 0; i < nRows; i++) {
+    SValue value = {.type = TSDB_DATA_TYPE_VARCHAR};
+    value.nData = snprintf(buf, sizeof(buf), "value-%d", i);
+    value.pData = (uint8_t *)buf;
+    SColVal colVal = COL_VAL_VALUE(2, value);
+    if (i % 10 == 0) {
+      colVal = COL_VAL_NULL(2, TSDB_DATA_TYPE_VARCHAR);
+    }
+    ASSERT_EQ(tColDataAppendValue(&colData, &colVal), 0);
+  }
+
+  // the dictionary was chosen for an earlier block of the column, this one has more distinct values than it holds
+  uint32_t alg = 0;
+  SET_COMPRESS(L1_DICT, L2_ZSTD, L2_LVL_MEDIUM, alg);
+  SColDataCompressInfo info = {.cmprAlg = alg};
+  ASSERT_EQ(tColDataCompress(&colData, &info, &output, &assist), 0);
+  ASSERT_EQ(COMPRESS_L1_TYPE_U32(info.cmprAlg), L1_DISABLED);
+  ASSERT_EQ(COMPRESS_L2_TYPE_U32(info.cmprAlg), L2_ZSTD);
+  ASSERT_EQ(COMPRESS_L2_TYPE_LEVEL_U32(info.cmprAlg), L2_LVL_MEDIUM);
+  ASSERT_EQ(info.dataOriginalSize, colData.nData);
+
+  // and is read back with the algorithm recorded
+  ASSERT_EQ(tColDataDecompress(output.data, &info, &outData, &assist), 0);
+  ASSERT_EQ(outData.nVal, nRows);
+  ASSERT_EQ(outData.nData, colData.nData);
+  for (int32_t i = 0; i < nRows; i++) {
+    SColVal cv1, cv2;
+    ASSERT_EQ(tColDataGetValue(&colData, i, &cv1), 0);
+    ASSERT_EQ(tColDataGetValue(&outData, i, &cv2), 0);
+    ASSERT_EQ(cv1.flag, cv2.flag);
+    if (COL_VAL_IS_VALUE(&cv1)) {
+      ASSERT_EQ(cv1.value.nData, cv2.value.nData);
+      ASSERT_EQ(memcmp(cv1.value.pData, cv2.value.pData, cv1.value.nData), 0);
+    }
+  }
+
+  tColDataDestroy(&colData);
+  tColDataDestroy(&outData);
+  tBufferDestroy(&output);
+  tBufferDestroy(&assist);
+}
+
+TEST(testCase, tColDataDictDecodeCorrupted) {
+  const char *labels[] = {"ok", "warning", "error", "timeout"};
+  SColData    colData = {0};
+  SColData    outData = {0};
+  SBuffer     output;
+  SBuffer     assist;
+  int32_t     nRows = 1024;
+
+  tBufferInit(&output);
+  tBufferInit(&assist);
+  tColDataInit(&colData, 2, TSDB_DATA_TYPE_VARCHAR, 0);
+  for (int32_t i = 0; i < nRows; i++) {
+    const char *label = labels[i % 4];
+    SValue      value = {.type = TSDB_DATA_TYPE_VARCHAR};
+    value.pData = (uint8_t *)label;
+    value.nData = strlen(label);
+    SColVal colVal = COL_VAL_VALUE(2, value);
+    ASSERT_EQ(tColDataAppendValue(&colData, &colVal), 0);
+  }
+
+  // with the second stage disabled the dictionary is stored as it is after a one byte header, at the end of the output
+  uint32_t alg = 0;
+  SET_COMPRESS(L1_DICT, L2_DISABLED, L2_LVL_MEDIUM, alg);
+  SColDataCompressInfo info = {.cmprAlg = alg};
+  ASSERT_EQ(tColDataCompress(&colData, &info, &output, &assist), 0);
+  ASSERT_EQ(tColDataDecompress(output.data, &info, &outData, &assist), 0);
+  ASSERT_EQ(outData.nData, colData.nData);
+
+  uint8_t *dict = (uint8_t *)output.data + output.size - info.dataCompressedSize + 1;
+  int32_t  nDict;
+  memcpy(&nDict, dict, sizeof(nDict));
+  ASSERT_EQ(nDict, 5);  // the empty value and the labels
+  int32_t *ends = (int32_t *)(dict + sizeof(int32_t));
+  int32_t  saved[5];
+  memcpy(saved, ends, sizeof(saved));
+
+  // the end of a value before the end of the previous one
+  ends[2] = ends[1] - 1;
+  ASSERT_EQ(tColDataDecompress(output.data, &info, &outData, &assist), TSDB_CODE_FILE_CORRUPTED);
+  memcpy(ends, saved, sizeof(saved));
+
+  // the end of a value after the end of the dictionary
+  ends[3] = ends[4] + 1;
+  ASSERT_EQ(tColDataDecompress(output.data, &info, &outData, &assist), TSDB_CODE_FILE_CORRUPTED);
+  memcpy(ends, saved, sizeof(saved));
+
+  // the number of values larger than the dictionary holds
+  nDict = 1000;
+  memcpy(dict, &nDict, sizeof(nDict));
+  ASSERT_EQ(tColDataDecompress(output.data, &info, &outData, &assist), TSDB_CODE_FILE_CORRUPTED);
+  nDict = 5;
+  memcpy(dict, &nDict, sizeof(nDict));
+
+  ASSERT_EQ(tColDataDecompress(output.data, &info, &outData, &assist), 0);
+  ASSERT_EQ(outData.nData, colData.nData);
+
+  tColDataDestroy(&colData);
+  tColDataDestroy(&outData);
+  tBufferDestroy(&output);
+  tBufferDestroy(&assist);
+}
+
 TEST(testCase, AllNormTest) {
   int16_t nCols = 14;
   STSRow *row = nullptr;
@@ -180,6 +180,7 @@ uint64_t tsdbGetReaderMaxVersion2(STsdbReader *pReader);
 void     tsdbReaderSetCloseFlag(STsdbReader *pReader);
 int64_t  tsdbGetLastTimestamp2(SVnode *pVnode, void *pTableList, int32_t numOfTables, const char *pIdStr);
 void     tsdbSetFilesetDelimited(STsdbReader *pReader);
+void     tsdbReaderSetBlockFilter(STsdbReader *pReader, SFilterInfo *pFilterInfo, const SArray *pFilterCols);
 void     tsdbReaderSetNotifyCb(STsdbReader *pReader, TsdReaderNotifyCbFn notifyFn, void *param);
 
 int32_t tsdbReuseCacherowsReader(void *pReader, void *pTableIdList, int32_t numOfTables);
@@ -348,6 +348,9 @@ typedef struct {
   tb_uid_t                             uid;
   STSchema                            *pTSchema;
   SArray                              *ctxArray;
+  SVATaskID                            warmupTask;
+  int8_t                               warmupStop;
+  int64_t                              writeVer;  // bumped on every put or delete queued in writebatch
 } SRocksCache;
 
 typedef struct {
@@ -374,6 +377,10 @@ struct STsdb {
   TdThreadMutex        bMutex;
   SLRUCache           *pgCache;
   TdThreadMutex        pgMutex;
+  SLRUCache           *colCache;  // decompressed columns of data file blocks
+  int64_t              colCacheHit;
+  int64_t              colCacheMiss;
+  int32_t              numOfScanWorkers;  // worker readers of the parallel scans running on the vnode
   struct STFileSystem *pFS;  // new
   SRocksCache          rCache;
   SCompMonitor        *pCompMonitor;
@@ -444,6 +451,7 @@ struct TSDBROW {
 
 struct SMemSkipListNode {
   int8_t            level;
+  int32_t           nRow;  // > 1 for a chunk of in-order rows of a block data, starting from row
   TSDBROW           row;
   SMemSkipListNode *forwards[0];
 };
@@ -550,6 +558,7 @@ struct STbDataIter {
   STbData          *pTbData;
   int8_t            backward;
   SMemSkipListNode *pNode;
+  int32_t           iRow;  // index of the current row in pNode
   TSDBROW          *pRow;
   TSDBROW           row;
 };
@@ -664,6 +673,7 @@ typedef struct {
   int32_t     fid;
   int64_t     cid;
   int64_t     blkno;
+  uint8_t    *pReadBuf;  // staging buffer of coalesced multi-page reads, freed after each read
 } STsdbFD;
 
 struct SDelFWriter {
@@ -941,6 +951,7 @@ typedef struct {
 
 int32_t tsdbOpenCache(STsdb *pTsdb);
 void    tsdbCloseCache(STsdb *pTsdb);
+void    tsdbCacheStartWarmup(STsdb *pTsdb);
 int32_t tsdbCacheRowFormatUpdate(STsdb *pTsdb, tb_uid_t suid, tb_uid_t uid, int64_t version, int32_t nRow, SRow **aRow);
 int32_t tsdbCacheColFormatUpdate(STsdb *pTsdb, tb_uid_t suid, tb_uid_t uid, SBlockData *pBlockData);
 int32_t tsdbCacheDel(STsdb *pTsdb, tb_uid_t suid, tb_uid_t uid, TSKEY sKey, TSKEY eKey);
@@ -955,6 +966,9 @@ int32_t tsdbBICacheRelease(SLRUCache *pCache, LRUHandle *h);
 int32_t tsdbCacheGetBlockS3(SLRUCache *pCache, STsdbFD *pFD, LRUHandle **handle);
 int32_t tsdbCacheGetPageS3(SLRUCache *pCache, STsdbFD *pFD, int64_t pgno, LRUHandle **handle);
 void    tsdbCacheSetPageS3(SLRUCache *pCache, STsdbFD *pFD, int64_t pgno, uint8_t *pPage);
+int32_t tsdbCacheGetColData(STsdb *pTsdb, int32_t fid, int64_t commitID, int64_t blockOffset, int16_t cid,
+                            SBlockData *bData, bool *hit);
+void    tsdbCacheSetColData(STsdb *pTsdb, int32_t fid, int64_t commitID, int64_t blockOffset, SColData *pColData);
 
 int32_t tsdbCacheDeleteLastrow(SLRUCache *pCache, tb_uid_t uid, TSKEY eKey);
 int32_t tsdbCacheDeleteLast(SLRUCache *pCache, tb_uid_t uid, TSKEY eKey);
@@ -1004,6 +1018,9 @@ static FORCE_INLINE TSDBROW *tsdbTbDataIterGet(STbDataIter *pIter) {
 
   pIter->pRow = &pIter->row;
   pIter->row = pIter->pNode->row;
+  if (pIter->iRow) {
+    pIter->row.iRow += pIter->iRow;
+  }
 
   return pIter->pRow;
 }
@@ -66,6 +66,7 @@ typedef enum {
 #define MERGE_TASK_ASYNC     2
 #define COMPACT_TASK_ASYNC   3
 #define RETENTION_TASK_ASYNC 4
+#define SCAN_TASK_ASYNC      5
 
 int32_t vnodeAsyncOpen();
 void    vnodeAsyncClose();
@@ -90,6 +90,9 @@ _err:
   TAOS_RETURN(code);
 }
 
+static int32_t tsdbOpenColCache(STsdb *pTsdb);
+static void    tsdbCloseColCache(STsdb *pTsdb);
+
 static void tsdbClosePgCache(STsdb *pTsdb) {
   SLRUCache *pCache = pTsdb->pgCache;
   if (pCache) {
@@ -1008,6 +1011,7 @@ static int32_t tsdbCacheDropTableColumn(STsdb *pTsdb, int64_t uid, int16_t cid,
       }
       if (NULL != pLastCol) {
         rocksdb_writebatch_delete(wb, keys_list[0], klen);
+        (void)atomic_add_fetch_64(&pTsdb->rCache.writeVer, 1);
       }
       taosMemoryFreeClear(pLastCol);
     }
@@ -1022,6 +1026,7 @@ static int32_t tsdbCacheDropTableColumn(STsdb *pTsdb, int64_t uid, int16_t cid,
       }
       if (NULL != pLastCol) {
         rocksdb_writebatch_delete(wb, keys_list[1], klen);
+        (void)atomic_add_fetch_64(&pTsdb->rCache.writeVer, 1);
       }
       taosMemoryFreeClear(pLastCol);
     }
@@ -1358,6 +1363,7 @@ static int32_t tsdbCachePutToRocksdb(STsdb *pTsdb, SLastKey *pLastKey, SLastCol
   rocksdb_writebatch_t *wb = pTsdb->rCache.writebatch;
   (void)taosThreadMutexLock(&pTsdb->rCache.writeBatchMutex);
   rocksdb_writebatch_put(wb, (char *)pLastKey, ROCKS_KEY_LEN, rocks_value, vlen);
+  (void)atomic_add_fetch_64(&pTsdb->rCache.writeVer, 1);
   (void)taosThreadMutexUnlock(&pTsdb->rCache.writeBatchMutex);
 
   taosMemoryFree(rocks_value);
@@ -2769,6 +2775,204 @@ _exit:
   TAOS_RETURN(code);
 }
 
+#define TSDB_CACHE_WARMUP_BATCH (1024)
+#define TSDB_CACHE_WARMUP_RETRY (3)
+
+static void tsdbCacheWarmupFreeValues(int32_t numKeys, char **valuesList, size_t *valuesListSizes) {
+  if (valuesList) {
+    for (int32_t i = 0; i < numKeys; ++i) {
+      rocksdb_free(valuesList[i]);
+    }
+    taosMemoryFree(valuesList);
+  }
+  taosMemoryFree(valuesListSizes);
+}
+
+// Load one batch of keys from rocksdb into the LRU. The values are fetched with a multi-get outside lruMutex, so
+// writers and queries are only blocked for the LRU inserts. The writebatch is flushed first and writeVer taken under
+// the lock; if any put or delete is queued before the lock is taken again, the values may be stale and the batch is
+// fetched again, and after TSDB_CACHE_WARMUP_RETRY attempts the multi-get is done under the lock as
+// tsdbCacheLoadFromRocks does. Keys already in the LRU are newer or equal and are left alone.
+static int32_t tsdbCacheWarmupBatch(STsdb *pTsdb, int32_t numKeys, char **keysList, size_t *keysListSizes,
+                                    int64_t *pLoaded, bool *pFull) {
+  int32_t    code = 0, lino = 0;
+  SLRUCache *pCache = pTsdb->lruCache;
+  size_t     capacity = taosLRUCacheGetCapacity(pCache);
+  char     **valuesList = NULL;
+  size_t    *valuesListSizes = NULL;
+  bool       locked = false;
+
+  for (int32_t retry = 0;; ++retry) {
+    (void)taosThreadMutexLock(&pTsdb->lruMutex);
+    locked = true;
+    rocksMayWrite(pTsdb, true);  // flush writebatch cache
+
+    if (retry >= TSDB_CACHE_WARMUP_RETRY) {
+      TAOS_CHECK_EXIT(tsdbCacheGetValuesFromRocks(pTsdb, numKeys, (const char *const *)keysList, keysListSizes,
+                                                  &valuesList, &valuesListSizes));
+      break;
+    }
+
+    int64_t writeVer = atomic_load_64(&pTsdb->rCache.writeVer);
+    (void)taosThreadMutexUnlock(&pTsdb->lruMutex);
+    locked = false;
+
+    TAOS_CHECK_EXIT(tsdbCacheGetValuesFromRocks(pTsdb, numKeys, (const char *const *)keysList, keysListSizes,
+                                                &valuesList, &valuesListSizes));
+
+    (void)taosThreadMutexLock(&pTsdb->lruMutex);
+    locked = true;
+    if (atomic_load_64(&pTsdb->rCache.writeVer) == writeVer) {
+      break;
+    }
+    (void)taosThreadMutexUnlock(&pTsdb->lruMutex);
+    locked = false;
+
+    tsdbCacheWarmupFreeValues(numKeys, valuesList, valuesListSizes);
+    valuesList = NULL;
+    valuesListSizes = NULL;
+  }
+
+  for (int32_t i = 0; i < numKeys; ++i) {
+    SLastKey key = {0};
+    memcpy(&key, keysList[i], ROCKS_KEY_LEN);
+
+    if (valuesList[i] == NULL) {
+      continue;
+    }
+
+    if (taosLRUCacheGetUsage(pCache) >= capacity) {
+      *pFull = true;
+      break;
+    }
+
+    LRUHandle *h = taosLRUCacheLookup(pCache, &key, ROCKS_KEY_LEN);
+    if (h) {
+      tsdbLRUCacheRelease(pCache, h, false);
+      continue;
+    }
+
+    SLastCol *pLastCol = NULL;
+    TAOS_CHECK_EXIT(tsdbCacheDeserialize(valuesList[i], valuesListSizes[i], &pLastCol));
+
+    if (pLastCol->cacheStatus != TSDB_LAST_CACHE_NO_CACHE) {
+      code = tsdbCachePutToLRU(pTsdb, &key, pLastCol, 0);
+      if (code == TSDB_CODE_SUCCESS) {
+        *pLoaded += 1;
+      }
+    }
+
+    taosMemoryFreeClear(pLastCol);
+    TAOS_CHECK_EXIT(code);
+  }
+
+_exit:
+  if (locked) {
+    (void)taosThreadMutexUnlock(&pTsdb->lruMutex);
+  }
+
+  tsdbCacheWarmupFreeValues(numKeys, valuesList, valuesListSizes);
+
+  if (code) {
+    tsdbError("vgId:%d %s failed at %s:%d since %s", TD_VID(pTsdb->pVnode), __func__, __FILE__, lino, tstrerror(code));
+  }
+  TAOS_RETURN(code);
+}
+
+// After a restart the LRU is empty, and the first last/last_row query on each table has to go to rocksdb, or to the
+// data files for columns missing there. Walk the rocksdb cache sequentially in the background and load it into the
+// LRU in batches until the cache is full, so that the first queries are served from memory.
+static int32_t tsdbCacheWarmup(void *arg) {
+  int32_t             code = 0, lino = 0;
+  STsdb              *pTsdb = (STsdb *)arg;
+  rocksdb_iterator_t *iter = NULL;
+  int64_t             numOfKeys = 0;
+  int64_t             numOfLoaded = 0;
+  bool                full = false;
+  int64_t             st = taosGetTimestampMs();
+
+  char  **keysList = taosMemoryMalloc(TSDB_CACHE_WARMUP_BATCH * sizeof(char *));
+  size_t *keysListSizes = taosMemoryMalloc(TSDB_CACHE_WARMUP_BATCH * sizeof(size_t));
+  char   *keyList = taosMemoryMalloc(TSDB_CACHE_WARMUP_BATCH * ROCKS_KEY_LEN);
+  if (!keysList || !keysListSizes || !keyList) {
+    TAOS_CHECK_EXIT(terrno);
+  }
+
+  for (int32_t i = 0; i < TSDB_CACHE_WARMUP_BATCH; ++i) {
+    keysList[i] = keyList + i * ROCKS_KEY_LEN;
+    keysListSizes[i] = ROCKS_KEY_LEN;
+  }
+
+  iter = rocksdb_create_iterator(pTsdb->rCache.db, pTsdb->rCache.readoptions);
+  if (iter == NULL) {
+    TAOS_CHECK_EXIT(TSDB_CODE_OUT_OF_MEMORY);
+  }
+
+  rocksdb_iter_seek_to_first(iter);
+  while (!full && rocksdb_iter_valid(iter)) {
+    if (atomic_load_8(&pTsdb->rCache.warmupStop) || pTsdb->bgTaskDisabled || !tsTsdbCacheWarmup) {
+      tsdbInfo("vgId:%d, last cache warm-up is stopped", TD_VID(pTsdb->pVnode));
+      break;
+    }
+
+    int32_t numKeys = 0;
+    for (; numKeys < TSDB_CACHE_WARMUP_BATCH && rocksdb_iter_valid(iter); rocksdb_iter_next(iter)) {
+      size_t      klen = 0;
+      const char *key = rocksdb_iter_key(iter, &klen);
+      if (klen == ROCKS_KEY_LEN) {
+        memcpy(keysList[numKeys++], key, ROCKS_KEY_LEN);
+      }
+    }
+
+    if (numKeys > 0) {
+      TAOS_CHECK_EXIT(tsdbCacheWarmupBatch(pTsdb, numKeys, keysList, keysListSizes, &numOfLoaded, &full));
+      numOfKeys += numKeys;
+    }
+  }
+
+  char *err = NULL;
+  rocksdb_iter_get_error(iter, &err);
+  if (err != NULL) {
+    tsdbError("vgId:%d, %s failed to iterate rocksdb since %s", TD_VID(pTsdb->pVnode), __func__, err);
+    rocksdb_free(err);
+  }
+
+  tsdbInfo("vgId:%d, last cache warm-up done, keys scanned:%" PRId64 ", loaded:%" PRId64
+           ", cache usage:%zu/%zu, full:%d, elapsed:%" PRId64 " ms",
+           TD_VID(pTsdb->pVnode), numOfKeys, numOfLoaded, taosLRUCacheGetUsage(pTsdb->lruCache),
+           taosLRUCacheGetCapacity(pTsdb->lruCache), full, taosGetTimestampMs() - st);
+
+_exit:
+  if (iter) {
+    rocksdb_iter_destroy(iter);
+  }
+  taosMemoryFree(keyList);
+  taosMemoryFree(keysList);
+  taosMemoryFree(keysListSizes);
+  if (code) {
+    tsdbError("vgId:%d %s failed at %s:%d since %s", TD_VID(pTsdb->pVnode), __func__, __FILE__, lino, tstrerror(code));
+  }
+  return code;
+}
+
+void tsdbCacheStartWarmup(STsdb *pTsdb) {
+  if (!tsTsdbCacheWarmup || TSDB_CACHE_NO(pTsdb->pVnode->config)) {
+    return;
+  }
+
+  int32_t code = vnodeAsync(RETENTION_TASK_ASYNC, EVA_PRIORITY_LOW, tsdbCacheWarmup, NULL, pTsdb,
+                            &pTsdb->rCache.warmupTask);
+  if (code) {
+    tsdbWarn("vgId:%d, failed to schedule last cache warm-up since %s", TD_VID(pTsdb->pVnode), tstrerror(code));
+  }
+}
+
+static void tsdbCacheStopWarmup(STsdb *pTsdb) {
+  atomic_store_8(&pTsdb->rCache.warmupStop, 1);
+  (void)vnodeACancel(&pTsdb->rCache.warmupTask);
+  vnodeAWait(&pTsdb->rCache.warmupTask);
+}
+
 int32_t tsdbOpenCache(STsdb *pTsdb) {
   int32_t code = 0, lino = 0;
   size_t  cfgCapacity = (size_t)pTsdb->pVnode->config.cacheLastSize * 1024 * 1024;
@@ -2782,6 +2986,8 @@ int32_t tsdbOpenCache(STsdb *pTsdb) {
 
   TAOS_CHECK_GOTO(tsdbOpenPgCache(pTsdb), &lino, _err);
 
+  TAOS_CHECK_GOTO(tsdbOpenColCache(pTsdb), &lino, _err);
+
   TAOS_CHECK_GOTO(tsdbOpenRocksCache(pTsdb), &lino, _err);
 
   taosLRUCacheSetStrictCapacity(pCache, false);
@@ -2799,6 +3005,8 @@ _err:
 }
 
 void tsdbCloseCache(STsdb *pTsdb) {
+  tsdbCacheStopWarmup(pTsdb);
+
   SLRUCache *pCache = pTsdb->lruCache;
   if (pCache) {
     taosLRUCacheEraseUnrefEntries(pCache);
@@ -2810,6 +3018,7 @@ void tsdbCloseCache(STsdb *pTsdb) {
 
   tsdbCloseBCache(pTsdb);
   tsdbClosePgCache(pTsdb);
+  tsdbCloseColCache(pTsdb);
   tsdbCloseRocksCache(pTsdb);
 }
 
@@ -4202,3 +4411,180 @@ void tsdbCacheSetPageS3(SLRUCache *pCache, STsdbFD *pFD, int64_t pgno, uint8_t *
 
   tsdbCacheRelease(pFD->pTsdb->pgCache, handle);
 }
+
+// decompressed column cache
+#define TSDB_COL_CACHE_SHARD_BITS 4
+
+typedef struct {
+  int64_t commitID;
+  int64_t blockOffset;
+  int32_t fid;
+  int16_t cid;
+  int16_t reserved;
+} SColCacheKey;
+
+static int32_t tsdbOpenColCache(STsdb *pTsdb) {
+  int32_t code = 0, lino = 0;
+
+  SLRUCache *pCache = taosLRUCacheInit((size_t)tsTsdbBlockCacheSize * 1024 * 1024, TSDB_COL_CACHE_SHARD_BITS, .5);
+  if (pCache == NULL) {
+    TAOS_CHECK_GOTO(TSDB_CODE_OUT_OF_MEMORY, &lino, _err);
+  }
+
+  pTsdb->colCache = pCache;
+  pTsdb->colCacheHit = 0;
+  pTsdb->colCacheMiss = 0;
+
+_err:
+  if (code) {
+    tsdbError("tsdb/colcache: vgId:%d, open failed at line %d since %s.", TD_VID(pTsdb->pVnode), lino,
+              tstrerror(code));
+  }
+
+  TAOS_RETURN(code);
+}
+
+static void tsdbCloseColCache(STsdb *pTsdb) {
+  SLRUCache *pCache = pTsdb->colCache;
+  if (pCache) {
+    tsdbInfo("vgId:%d, column cache hit:%" PRId64 " miss:%" PRId64 " elems:%d", TD_VID(pTsdb->pVnode),
+             pTsdb->colCacheHit, pTsdb->colCacheMiss, taosLRUCacheGetElems(pCache));
+    taosLRUCacheEraseUnrefEntries(pCache);
+    taosLRUCacheCleanup(pCache);
+    pTsdb->colCache = NULL;
+  }
+}
+
+static void *tsdbColCacheMalloc(void *arg, int32_t size) {
+  (void)arg;
+  return taosMemoryMalloc(size);
+}
+
+static void *tsdbColCacheRealloc(void *arg, int32_t size) {
+  (void)arg;
+  uint8_t *p = NULL;
+  if (tRealloc(&p, size) != 0) {
+    return NULL;
+  }
+  return p;
+}
+
+static void tsdbColCacheFree(void *p) { taosMemoryFree(p); }
+
+static void tsdbColCacheFreeRealloc(void *p) { tFree(p); }
+
+/**
+ * Copy a column with tColDataCopy, which starts from a shallow copy of the source and allocates the buffers one by
+ * one. On failure, only the buffers allocated by the copy are freed and pColData is left untouched, so it never
+ * points at the buffers of the source.
+ */
+static int32_t tsdbColCacheCopy(SColData *pFrom, SColData *pColData, xMallocFn xMalloc, void (*xFree)(void *)) {
+  SColData colData = {0};
+
+  int32_t code = tColDataCopy(pFrom, &colData, xMalloc, NULL);
+  if (code) {
+    if (colData.pBitMap != pFrom->pBitMap) xFree(colData.pBitMap);
+    if (colData.aOffset != pFrom->aOffset) xFree(colData.aOffset);
+    if (colData.pData != pFrom->pData) xFree(colData.pData);
+    return code;
+  }
+
+  *pColData = colData;
+  return code;
+}
+
+static void deleteColCache(const void *key, size_t keyLen, void *value, void *ud) {
+  (void)ud;
+  SColData *pColData = (SColData *)value;
+
+  taosMemoryFree(pColData->pBitMap);
+  taosMemoryFree(pColData->aOffset);
+  taosMemoryFree(pColData->pData);
+  taosMemoryFree(pColData);
+}
+
+/**
+ * Look up a decompressed column of a data file block and append a copy of it to bData on hit. The blocks of a data
+ * file never change once written, so the file id, commit id and block offset identify the block.
+ */
+int32_t tsdbCacheGetColData(STsdb *pTsdb, int32_t fid, int64_t commitID, int64_t blockOffset, int16_t cid,
+                            SBlockData *bData, bool *hit) {
+  int32_t      code = 0;
+  SColCacheKey key = {0};
+  LRUHandle   *h = NULL;
+
+  *hit = false;
+  if (pTsdb->colCache == NULL || tsTsdbBlockCacheSize <= 0) {
+    return code;
+  }
+
+  key.fid = fid;
+  key.cid = cid;
+  key.commitID = commitID;
+  key.blockOffset = blockOffset;
+  h = taosLRUCacheLookup(pTsdb->colCache, &key, sizeof(key));
+  if (h == NULL) {
+    (void)atomic_add_fetch_64(&pTsdb->colCacheMiss, 1);
+    return code;
+  }
+
+  SColData *pCached = (SColData *)taosLRUCacheValue(pTsdb->colCache, h);
+  SColData *pColData = NULL;
+
+  code = tBlockDataAddColData(bData, pCached->cid, pCached->type, pCached->cflag, &pColData);
+  if (code == 0) {
+    code = tsdbColCacheCopy(pCached, pColData, tsdbColCacheRealloc, tsdbColCacheFreeRealloc);
+  }
+  tsdbLRUCacheRelease(pTsdb->colCache, h, false);
+
+  if (code == 0) {
+    (void)atomic_add_fetch_64(&pTsdb->colCacheHit, 1);
+    *hit = true;
+  }
+  return code;
+}
+
+void tsdbCacheSetColData(STsdb *pTsdb, int32_t fid, int64_t commitID, int64_t blockOffset, SColData *pColData) {
+  SColCacheKey key = {0};
+  size_t       capacity = (size_t)tsTsdbBlockCacheSize * 1024 * 1024;
+
+  if (pTsdb->colCache == NULL || capacity == 0) {
+    return;
+  }
+
+  if (taosLRUCacheGetCapacity(pTsdb->colCache) != capacity) {
+    taosLRUCacheSetCapacity(pTsdb->colCache, capacity);
+  }
+
+  SColData *pCached = taosMemoryCalloc(1, sizeof(SColData));
+  if (pCached == NULL) {
+    return;  // ignore error with column cache
+  }
+
+  if (tsdbColCacheCopy(pColData, pCached, tsdbColCacheMalloc, tsdbColCacheFree) != 0) {
+    taosMemoryFree(pCached);
+    return;
+  }
+
+  size_t charge = sizeof(SColData) + pCached->nData;
+  if (pCached->aOffset) {
+    charge += pCached->nVal << 2;
+  }
+  if (pCached->pBitMap) {
+    // the bitmap holds 2 bits a value only if the column has all three flags
+    if (pCached->flag == (HAS_VALUE | HAS_NULL | HAS_NONE)) {
+      charge += BIT2_SIZE(pCached->nVal);
+    } else {
+      charge += BIT1_SIZE(pCached->nVal);
+    }
+  }
+
+  key.fid = fid;
+  key.cid = pColData->cid;
+  key.commitID = commitID;
+  key.blockOffset = blockOffset;
+
+  // the entry is freed by the cache if it can not be held
+  (void)taosLRUCacheInsert(pTsdb->colCache, &key, sizeof(key), pCached, charge, deleteColCache, NULL, NULL,
+                           TAOS_LRU_PRIORITY_LOW, NULL);
+}
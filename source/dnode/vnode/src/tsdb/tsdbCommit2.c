@@ -370,6 +370,16 @@ _exit:
   return code;
 }
 
+static void tsdbCommitFileSetAbort(SCommitter2 *committer) {
+  int32_t code = tsdbFSetWriterClose(&committer->writer, 1, committer->fopArray);
+  if (code) {
+    tsdbError("vgId:%d %s failed to abort writer since %s, fid:%d", TD_VID(committer->tsdb->pVnode), __func__,
+              tstrerror(code), committer->ctx->info->fid);
+  }
+  tsdbCommitCloseIter(committer);
+  tsdbCommitCloseReader(committer);
+}
+
 static int32_t tsdbCommitFileSet(SCommitter2 *committer) {
   int32_t code = 0;
   int32_t lino = 0;
@@ -381,6 +391,7 @@ static int32_t tsdbCommitFileSet(SCommitter2 *committer) {
 
 _exit:
   if (code) {
+    tsdbCommitFileSetAbort(committer);
     tsdbError("vgId:%d %s failed at %s:%d since %s", TD_VID(committer->tsdb->pVnode), __func__, __FILE__, lino,
               tstrerror(code));
   } else {
@@ -648,6 +659,200 @@ _exit:
   return code;
 }
 
+typedef struct {
+  SArray       *infoArr;
+  TFileOpArray *fopArrays;  // file operations of each file set, applied in the order of infoArr
+  int32_t       next;
+  int32_t       code;
+} SCommitParallel;
+
+typedef struct {
+  SCommitParallel *shared;
+  SCommitter2      committer[1];
+  TdThread         thread;
+  bool             started;
+} SCommitWorker;
+
+// number of commit worker threads running in this dnode, bounded by the number of cores
+static int32_t tsdbCommitWorkerThreads = 0;
+
+static int32_t tsdbCommitAcquireThreads(int32_t numOfThreads) {
+  int32_t limit = TMAX((int32_t)tsNumOfCores, 2);
+
+  for (;;) {
+    int32_t used = atomic_load_32(&tsdbCommitWorkerThreads);
+    int32_t num = TMIN(numOfThreads, limit - used);
+    if (num < 2) {
+      return 0;
+    }
+    if (atomic_val_compare_exchange_32(&tsdbCommitWorkerThreads, used, used + num) == used) {
+      return num;
+    }
+  }
+}
+
+static void tsdbCommitReleaseThreads(int32_t numOfThreads) {
+  (void)atomic_sub_fetch_32(&tsdbCommitWorkerThreads, numOfThreads);
+}
+
+static void tsdbCommitWorkerInit(SCommitWorker *worker, SCommitParallel *shared, const SCommitter2 *committer) {
+  SCommitter2 *wcommitter = worker->committer;
+
+  worker->shared = shared;
+
+  // only the configuration is shared, each worker owns its readers, iterators, writer and file operations
+  wcommitter->tsdb = committer->tsdb;
+  wcommitter->minutes = committer->minutes;
+  wcommitter->precision = committer->precision;
+  wcommitter->minRow = committer->minRow;
+  wcommitter->maxRow = committer->maxRow;
+  wcommitter->cmprAlg = committer->cmprAlg;
+  wcommitter->sttTrigger = committer->sttTrigger;
+  wcommitter->szPage = committer->szPage;
+  wcommitter->compactVersion = committer->compactVersion;
+  wcommitter->cid = committer->cid;
+  wcommitter->now = committer->now;
+  TARRAY2_INIT(wcommitter->sttReaderArray);
+  TARRAY2_INIT(wcommitter->dataIterArray);
+  TARRAY2_INIT(wcommitter->tombIterArray);
+  TARRAY2_INIT(wcommitter->fopArray);
+}
+
+static void tsdbCommitRemoveNewFiles(STsdb *tsdb, TFileOpArray *fopArray) {
+  char      fname[TSDB_FILENAME_LEN];
+  STFileOp *op;
+
+  TARRAY2_FOREACH_PTR(fopArray, op) {
+    if (op->optype == TSDB_FOP_CREATE) {
+      tsdbTFileName(tsdb, &op->nf, fname);
+      tsdbRemoveFile(fname);
+    }
+  }
+}
+
+static void tsdbCommitWorkerDestroy(SCommitWorker *worker) {
+  SCommitter2 *committer = worker->committer;
+
+  // only the file set that failed leaves its file operations here
+  tsdbCommitRemoveNewFiles(committer->tsdb, committer->fopArray);
+  TARRAY2_DESTROY(committer->dataIterArray, NULL);
+  TARRAY2_DESTROY(committer->tombIterArray, NULL);
+  TARRAY2_DESTROY(committer->sttReaderArray, NULL);
+  TARRAY2_DESTROY(committer->fopArray, NULL);
+}
+
+static void *tsdbCommitWorkerFn(void *arg) {
+  SCommitWorker   *worker = (SCommitWorker *)arg;
+  SCommitParallel *shared = worker->shared;
+  SCommitter2     *committer = worker->committer;
+
+  setThreadName("vnode-commit-worker");
+
+  for (;;) {
+    if (atomic_load_32(&shared->code)) {
+      break;
+    }
+
+    int32_t i = atomic_fetch_add_32(&shared->next, 1);
+    if (i >= taosArrayGetSize(shared->infoArr)) {
+      break;
+    }
+
+    committer->ctx->info = *(SFileSetCommitInfo **)taosArrayGet(shared->infoArr, i);
+    int32_t code = tsdbCommitFileSet(committer);
+    if (code) {
+      (void)atomic_val_compare_exchange_32(&shared->code, 0, code);
+      break;
+    }
+
+    shared->fopArrays[i] = committer->fopArray[0];
+    TARRAY2_INIT(committer->fopArray);
+  }
+
+  return NULL;
+}
+
+/**
+ * Commit the file sets with up to tsdbCommitThreads threads. A file set is committed by one thread from begin to end
+ * with its own readers, iterators and writer, so the threads only share the frozen memtable and the file operations
+ * are appended to the committer in file set order afterwards.
+ *
+ * The threads are dedicated rather than vnode-commit pool tasks: this function itself runs in a vnode-commit task and
+ * waits for the file sets, so queueing them on the same pool could deadlock once every pool thread is a waiting commit.
+ * The threads of all vnodes together are bounded by the number of cores, and a commit that gets fewer than two threads
+ * falls back to the serial path.
+ */
+static int32_t tsdbCommitFileSetsParallel(SCommitter2 *committer, int32_t numOfThreads) {
+  int32_t          code = 0;
+  int32_t          lino = 0;
+  STsdb           *tsdb = committer->tsdb;
+  SCommitWorker   *workers = NULL;
+  SCommitParallel  shared = {
+       .infoArr = tsdb->commitInfo->arr,
+  };
+  int32_t          nInfo = taosArrayGetSize(shared.infoArr);
+
+  shared.fopArrays = (TFileOpArray *)taosMemoryCalloc(nInfo, sizeof(TFileOpArray));
+  TSDB_CHECK_NULL(shared.fopArrays, code, lino, _exit, terrno);
+
+  workers = (SCommitWorker *)taosMemoryCalloc(numOfThreads, sizeof(SCommitWorker));
+  TSDB_CHECK_NULL(workers, code, lino, _exit, terrno);
+
+  for (int32_t i = 0; i < numOfThreads; i++) {
+    tsdbCommitWorkerInit(&workers[i], &shared, committer);
+  }
+
+  for (int32_t i = 0; i < numOfThreads; i++) {
+    SCommitWorker *worker = &workers[i];
+
+    code = taosThreadCreate(&worker->thread, NULL, tsdbCommitWorkerFn, worker);
+    if (code) {
+      (void)atomic_val_compare_exchange_32(&shared.code, 0, code);
+      code = 0;
+      break;
+    }
+    worker->started = true;
+  }
+
+  for (int32_t i = 0; i < numOfThreads; i++) {
+    if (workers[i].started) {
+      (void)taosThreadJoin(workers[i].thread, NULL);
+    }
+  }
+
+  TAOS_CHECK_GOTO(shared.code, &lino, _exit);
+
+  for (int32_t i = 0; i < nInfo; i++) {
+    STFileOp op;
+    TARRAY2_FOREACH(&shared.fopArrays[i], op) { TAOS_CHECK_GOTO(TARRAY2_APPEND(committer->fopArray, op), &lino, _exit); }
+  }
+
+_exit:
+  if (workers) {
+    for (int32_t i = 0; i < numOfThreads; i++) {
+      tsdbCommitWorkerDestroy(&workers[i]);
+    }
+    taosMemoryFree(workers);
+  }
+  if (shared.fopArrays) {
+    for (int32_t i = 0; i < nInfo; i++) {
+      // the file sets committed before the failure are never applied, drop the files they wrote
+      if (code) {
+        tsdbCommitRemoveNewFiles(tsdb, &shared.fopArrays[i]);
+      }
+      TARRAY2_DESTROY(&shared.fopArrays[i], NULL);
+    }
+    taosMemoryFree(shared.fopArrays);
+  }
+  if (code) {
+    tsdbError("vgId:%d %s failed at %s:%d since %s", TD_VID(tsdb->pVnode), __func__, __FILE__, lino, tstrerror(code));
+  } else {
+    tsdbDebug("vgId:%d %s done, %d file sets committed by %d threads", TD_VID(tsdb->pVnode), __func__, nInfo,
+              numOfThreads);
+  }
+  return code;
+}
+
 int32_t tsdbPreCommit(STsdb *tsdb) {
   (void)taosThreadMutexLock(&tsdb->mutex);
   ASSERT_CORE(tsdb->imem == NULL, "imem should be null to commit mem");
@@ -677,9 +882,19 @@ int32_t tsdbCommitBegin(STsdb *tsdb, SCommitInfo *info) {
 
     TAOS_CHECK_GOTO(tsdbOpenCommitter(tsdb, info, &committer), &lino, _exit);
 
-    for (int32_t i = 0; i < taosArrayGetSize(tsdb->commitInfo->arr); i++) {
-      committer.ctx->info = *(SFileSetCommitInfo **)taosArrayGet(tsdb->commitInfo->arr, i);
-      TAOS_CHECK_GOTO(tsdbCommitFileSet(&committer), &lino, _exit);
+    int32_t numOfThreads = TMIN(tsTsdbCommitThreads, taosArrayGetSize(tsdb->commitInfo->arr));
+    if (numOfThreads > 1) {
+      numOfThreads = tsdbCommitAcquireThreads(numOfThreads);
+    }
+    if (numOfThreads > 1) {
+      code = tsdbCommitFileSetsParallel(&committer, numOfThreads);
+      tsdbCommitReleaseThreads(numOfThreads);
+      TSDB_CHECK_CODE(code, lino, _exit);
+    } else {
+      for (int32_t i = 0; i < taosArrayGetSize(tsdb->commitInfo->arr); i++) {
+        committer.ctx->info = *(SFileSetCommitInfo **)taosArrayGet(tsdb->commitInfo->arr, i);
+        TAOS_CHECK_GOTO(tsdbCommitFileSet(&committer), &lino, _exit);
+      }
     }
 
     TAOS_CHECK_GOTO(tsdbCloseCommitter(&committer, code), &lino, _exit);
@@ -15,6 +15,9 @@
 
 #include "tsdbDataFileRW.h"
 #include "meta.h"
+#include "tbloomfilter.h"
+
+#define TSDB_BLOOM_FILTER_FPP 0.01
 
 // SDataFileReader =============================================
 struct SDataFileReader {
@@ -28,14 +31,22 @@ struct SDataFileReader {
     bool tombFooterLoaded;
     bool brinBlkLoaded;
     bool tombBlkLoaded;
+    bool bloomBlkLoaded;
+    bool zoneBlkLoaded;
   } ctx[1];
 
   STsdbFD *fd[TSDB_FTYPE_MAX];
 
-  SHeadFooter   headFooter[1];
-  STombFooter   tombFooter[1];
-  TBrinBlkArray brinBlkArray[1];
-  TTombBlkArray tombBlkArray[1];
+  SHeadFooter      headFooter[1];
+  STombFooter      tombFooter[1];
+  TBrinBlkArray    brinBlkArray[1];
+  TTombBlkArray    tombBlkArray[1];
+  TBloomBlkArray   bloomBlkArray[1];
+  const SBloomBlk *bloomBlk;  // the bloom filter currently loaded in bloomBuffer
+  SBuffer          bloomBuffer[1];
+  TZoneBlkArray    zoneBlkArray[1];
+  const SZoneBlk  *zoneBlk;  // the zone block currently loaded in zoneMap
+  TZoneRecordArray zoneMap[1];
 };
 
 static int32_t tsdbDataFileReadHeadFooter(SDataFileReader *reader) {
@@ -117,6 +128,7 @@ int32_t tsdbDataFileReaderOpen(const char *fname[], const SDataFileReaderConfig
   for (int32_t i = 0; i < ARRAY_SIZE(reader[0]->local); i++) {
     tBufferInit(reader[0]->local + i);
   }
+  tBufferInit(reader[0]->bloomBuffer);
 
   reader[0]->config[0] = config[0];
   reader[0]->buffers = config->buffers;
@@ -155,8 +167,12 @@ void tsdbDataFileReaderClose(SDataFileReader **reader) {
     return;
   }
 
+  TARRAY2_DESTROY(reader[0]->zoneMap, NULL);
+  TARRAY2_DESTROY(reader[0]->zoneBlkArray, NULL);
+  TARRAY2_DESTROY(reader[0]->bloomBlkArray, NULL);
   TARRAY2_DESTROY(reader[0]->tombBlkArray, NULL);
   TARRAY2_DESTROY(reader[0]->brinBlkArray, NULL);
+  tBufferDestroy(reader[0]->bloomBuffer);
 
   for (int32_t i = 0; i < TSDB_FTYPE_MAX; ++i) {
     if (reader[0]->fd[i]) {
@@ -294,6 +310,343 @@ _exit:
   return code;
 }
 
+int32_t tsdbDataFileReadBloomBlk(SDataFileReader *reader, const TBloomBlkArray **bloomBlkArray) {
+  int32_t code = 0;
+  int32_t lino = 0;
+  void   *data = NULL;
+
+  if (!reader->ctx->bloomBlkLoaded) {
+    TAOS_CHECK_GOTO(tsdbDataFileReadHeadFooter(reader), &lino, _exit);
+
+    if (reader->headFooter->bloomBlkPtr->size > 0) {
+      data = taosMemoryMalloc(reader->headFooter->bloomBlkPtr->size);
+      if (data == NULL) {
+        TAOS_CHECK_GOTO(terrno, &lino, _exit);
+      }
+
+      int32_t encryptAlgorithm = reader->config->tsdb->pVnode->config.tsdbCfg.encryptAlgorithm;
+      char   *encryptKey = reader->config->tsdb->pVnode->config.tsdbCfg.encryptKey;
+
+      TAOS_CHECK_GOTO(tsdbReadFile(reader->fd[TSDB_FTYPE_HEAD], reader->headFooter->bloomBlkPtr->offset, data,
+                                   reader->headFooter->bloomBlkPtr->size, 0, encryptAlgorithm, encryptKey),
+                      &lino, _exit);
+
+      if (reader->headFooter->bloomBlkPtr->size % sizeof(SBloomBlk) != 0) {
+        TAOS_CHECK_GOTO(TSDB_CODE_FILE_CORRUPTED, &lino, _exit);
+      }
+
+      int32_t size = reader->headFooter->bloomBlkPtr->size / sizeof(SBloomBlk);
+      TARRAY2_INIT_EX(reader->bloomBlkArray, size, size, data);
+    } else {
+      TARRAY2_INIT(reader->bloomBlkArray);
+    }
+
+    reader->ctx->bloomBlkLoaded = true;
+  }
+  bloomBlkArray[0] = reader->bloomBlkArray;
+
+_exit:
+  if (code) {
+    tsdbError("vgId:%d %s failed at %s:%d since %s", TD_VID(reader->config->tsdb->pVnode), __func__, __FILE__, lino,
+              tstrerror(code));
+    taosMemoryFree(data);
+  }
+  return code;
+}
+
+static int32_t tBloomBlkCmprFn(const SBloomBlk *blk1, const SBloomBlk *blk2) {
+  if (blk1->blockOffset < blk2->blockOffset) {
+    return -1;
+  } else if (blk1->blockOffset > blk2->blockOffset) {
+    return 1;
+  }
+  return 0;
+}
+
+static int32_t tsdbDataFileLoadBlockBloom(SDataFileReader *reader, const SBrinRecord *record,
+                                          const SBloomBlk **bloomBlk) {
+  int32_t code = 0;
+  int32_t lino = 0;
+
+  const TBloomBlkArray *bloomBlkArray = NULL;
+  SBloomBlk             target = {.blockOffset = record->blockOffset};
+
+  bloomBlk[0] = NULL;
+  TAOS_CHECK_GOTO(tsdbDataFileReadBloomBlk(reader, &bloomBlkArray), &lino, _exit);
+
+  const SBloomBlk *blk = TARRAY2_SEARCH(reader->bloomBlkArray, &target, tBloomBlkCmprFn, TD_EQ);
+  if (blk == NULL) {  // no filter built for this block
+    goto _exit;
+  }
+
+  if (reader->bloomBlk != blk) {
+    int32_t encryptAlgorithm = reader->config->tsdb->pVnode->config.tsdbCfg.encryptAlgorithm;
+    char   *encryptKey = reader->config->tsdb->pVnode->config.tsdbCfg.encryptKey;
+
+    reader->bloomBlk = NULL;
+    tBufferClear(reader->bloomBuffer);
+    TAOS_CHECK_GOTO(tsdbReadFileToBuffer(reader->fd[TSDB_FTYPE_HEAD], blk->offset, blk->size, reader->bloomBuffer, 0,
+                                         encryptAlgorithm, encryptKey),
+                    &lino, _exit);
+    reader->bloomBlk = blk;
+  }
+  bloomBlk[0] = blk;
+
+_exit:
+  if (code) {
+    tsdbError("vgId:%d %s failed at %s:%d since %s", TD_VID(reader->config->tsdb->pVnode), __func__, __FILE__, lino,
+              tstrerror(code));
+  }
+  return code;
+}
+
+int32_t tsdbDataFileBlockMayContain(SDataFileReader *reader, const SBrinRecord *record, const void *key, int32_t len,
+                                    bool *mayContain) {
+  const SBloomBlk *bloomBlk = NULL;
+
+  mayContain[0] = true;
+  TAOS_CHECK_RETURN(tsdbDataFileLoadBlockBloom(reader, record, &bloomBlk));
+  if (bloomBlk == NULL) {
+    return 0;
+  }
+
+  SBloomFilter bf = {
+      .hashFunctions = bloomBlk->hashFuncs,
+      .numUnits = bloomBlk->size / sizeof(uint64_t),
+      .numBits = bloomBlk->size * 8,
+      .buffer = reader->bloomBuffer->data,
+  };
+  uint64_t h1 = (uint64_t)HASH_FUNCTION_1(key, len);
+  uint64_t h2 = (uint64_t)HASH_FUNCTION_2(key, len);
+
+  mayContain[0] = (tBloomFilterNoContain(&bf, h1, h2) != TSDB_CODE_SUCCESS);
+  return 0;
+}
+
+int32_t tPutZoneRecord(uint8_t *p, const SZoneRecord *record) {
+  int32_t n = 0;
+
+  n += tPutI64(p ? p + n : p, record->blockOffset);
+  n += tPutI16(p ? p + n : p, record->cid);
+  n += tPutI16(p ? p + n : p, record->numOfNull);
+  n += tPutI64(p ? p + n : p, record->min);
+  n += tPutI64(p ? p + n : p, record->max);
+  return n;
+}
+
+int32_t tGetZoneRecord(uint8_t *p, SZoneRecord *record) {
+  int32_t n = 0;
+
+  n += tGetI64(p + n, &record->blockOffset);
+  n += tGetI16(p + n, &record->cid);
+  n += tGetI16(p + n, &record->numOfNull);
+  n += tGetI64(p + n, &record->min);
+  n += tGetI64(p + n, &record->max);
+  return n;
+}
+
+int32_t tsdbFileReadZoneBlk(STsdbFD *fd, const SFDataPtr *ptr, TZoneBlkArray *zoneBlkArray, int32_t encryptAlgorithm,
+                            char *encryptKey) {
+  int32_t code = 0;
+  int32_t lino = 0;
+  void   *data = NULL;
+
+  if (ptr->size > 0) {
+    if (ptr->size % sizeof(SZoneBlk) != 0) {
+      TAOS_CHECK_GOTO(TSDB_CODE_FILE_CORRUPTED, &lino, _exit);
+    }
+
+    data = taosMemoryMalloc(ptr->size);
+    if (data == NULL) {
+      TAOS_CHECK_GOTO(terrno, &lino, _exit);
+    }
+
+    TAOS_CHECK_GOTO(tsdbReadFile(fd, ptr->offset, data, ptr->size, 0, encryptAlgorithm, encryptKey), &lino, _exit);
+
+    int32_t size = ptr->size / sizeof(SZoneBlk);
+    TARRAY2_INIT_EX(zoneBlkArray, size, size, data);
+  } else {
+    TARRAY2_INIT(zoneBlkArray);
+  }
+
+_exit:
+  if (code) {
+    tsdbError("%s failed at %s:%d since %s", __func__, __FILE__, lino, tstrerror(code));
+    taosMemoryFree(data);
+  }
+  return code;
+}
+
+int32_t tsdbFileReadZoneBlock(STsdbFD *fd, const SZoneBlk *zoneBlk, SBuffer *buffer, TZoneRecordArray *zoneMap,
+                              int32_t encryptAlgorithm, char *encryptKey) {
+  int32_t     code = 0;
+  int32_t     lino = 0;
+  SZoneRecord record;
+
+  TARRAY2_CLEAR(zoneMap, NULL);
+  if (zoneBlk->numRec <= 0 || zoneBlk->size != zoneBlk->numRec * tPutZoneRecord(NULL, &record)) {
+    TAOS_CHECK_GOTO(TSDB_CODE_FILE_CORRUPTED, &lino, _exit);
+  }
+
+  tBufferClear(buffer);
+  TAOS_CHECK_GOTO(tsdbReadFileToBuffer(fd, zoneBlk->offset, zoneBlk->size, buffer, 0, encryptAlgorithm, encryptKey),
+                  &lino, _exit);
+
+  uint8_t *p = (uint8_t *)buffer->data;
+  for (int32_t i = 0; i < zoneBlk->numRec; i++) {
+    p += tGetZoneRecord(p, &record);
+    if (record.blockOffset < zoneBlk->minBlockOffset || record.blockOffset > zoneBlk->maxBlockOffset) {
+      TAOS_CHECK_GOTO(TSDB_CODE_FILE_CORRUPTED, &lino, _exit);
+    }
+    TAOS_CHECK_GOTO(TARRAY2_APPEND(zoneMap, record), &lino, _exit);
+  }
+
+_exit:
+  if (code) {
+    TARRAY2_CLEAR(zoneMap, NULL);
+    tsdbError("%s failed at %s:%d since %s", __func__, __FILE__, lino, tstrerror(code));
+  }
+  return code;
+}
+
+int32_t tsdbDataFileReadZoneBlk(SDataFileReader *reader, const TZoneBlkArray **zoneBlkArray) {
+  int32_t code = 0;
+  int32_t lino = 0;
+
+  if (!reader->ctx->zoneBlkLoaded) {
+    TAOS_CHECK_GOTO(tsdbDataFileReadHeadFooter(reader), &lino, _exit);
+
+    int32_t encryptAlgorithm = reader->config->tsdb->pVnode->config.tsdbCfg.encryptAlgorithm;
+    char   *encryptKey = reader->config->tsdb->pVnode->config.tsdbCfg.encryptKey;
+
+    TAOS_CHECK_GOTO(tsdbFileReadZoneBlk(reader->fd[TSDB_FTYPE_HEAD], reader->headFooter->zoneMapPtr,
+                                        reader->zoneBlkArray, encryptAlgorithm, encryptKey),
+                    &lino, _exit);
+    reader->ctx->zoneBlkLoaded = true;
+  }
+  zoneBlkArray[0] = reader->zoneBlkArray;
+
+_exit:
+  if (code) {
+    tsdbError("vgId:%d %s failed at %s:%d since %s", TD_VID(reader->config->tsdb->pVnode), __func__, __FILE__, lino,
+              tstrerror(code));
+  }
+  return code;
+}
+
+static int32_t tZoneRecordCmprFn(const SZoneRecord *r1, const SZoneRecord *r2) {
+  if (r1->blockOffset < r2->blockOffset) {
+    return -1;
+  } else if (r1->blockOffset > r2->blockOffset) {
+    return 1;
+  }
+
+  if (r1->cid < r2->cid) {
+    return -1;
+  } else if (r1->cid > r2->cid) {
+    return 1;
+  }
+  return 0;
+}
+
+// the target carries the block offset to look up in minBlockOffset
+static int32_t tZoneBlkSearchFn(const SZoneBlk *target, const SZoneBlk *blk) {
+  if (target->minBlockOffset < blk->minBlockOffset) {
+    return -1;
+  } else if (target->minBlockOffset > blk->maxBlockOffset) {
+    return 1;
+  }
+  return 0;
+}
+
+// index of the first zone record of the block, or the size of the zone map if the block has none
+static int32_t tsdbZoneMapSeek(const TZoneRecordArray *zoneMap, int64_t blockOffset) {
+  int32_t lidx = 0;
+  int32_t ridx = TARRAY2_SIZE(zoneMap);
+
+  while (lidx < ridx) {
+    int32_t midx = (lidx + ridx) >> 1;
+    if (TARRAY2_GET_PTR(zoneMap, midx)->blockOffset < blockOffset) {
+      lidx = midx + 1;
+    } else {
+      ridx = midx;
+    }
+  }
+  return lidx;
+}
+
+// load the zone block covering the data block, zoneMap[0] is NULL if no zone block covers it
+static int32_t tsdbDataFileLoadBlockZone(SDataFileReader *reader, int64_t blockOffset,
+                                         const TZoneRecordArray **zoneMap) {
+  int32_t code = 0;
+  int32_t lino = 0;
+
+  const TZoneBlkArray *zoneBlkArray = NULL;
+  SZoneBlk             target = {.minBlockOffset = blockOffset};
+
+  zoneMap[0] = NULL;
+  TAOS_CHECK_GOTO(tsdbDataFileReadZoneBlk(reader, &zoneBlkArray), &lino, _exit);
+
+  const SZoneBlk *blk = TARRAY2_SEARCH(reader->zoneBlkArray, &target, tZoneBlkSearchFn, TD_EQ);
+  if (blk == NULL) {
+    goto _exit;
+  }
+
+  if (reader->zoneBlk != blk) {
+    int32_t encryptAlgorithm = reader->config->tsdb->pVnode->config.tsdbCfg.encryptAlgorithm;
+    char   *encryptKey = reader->config->tsdb->pVnode->config.tsdbCfg.encryptKey;
+
+    reader->zoneBlk = NULL;
+    TAOS_CHECK_GOTO(tsdbFileReadZoneBlock(reader->fd[TSDB_FTYPE_HEAD], blk, reader->buffers + 0, reader->zoneMap,
+                                          encryptAlgorithm, encryptKey),
+                    &lino, _exit);
+    reader->zoneBlk = blk;
+  }
+  zoneMap[0] = reader->zoneMap;
+
+_exit:
+  if (code) {
+    tsdbError("vgId:%d %s failed at %s:%d since %s", TD_VID(reader->config->tsdb->pVnode), __func__, __FILE__, lino,
+              tstrerror(code));
+  }
+  return code;
+}
+
+int32_t tsdbDataFileReadBlockZone(SDataFileReader *reader, int64_t blockOffset,
+                                  TColumnDataAggArray *columnDataAggArray) {
+  int32_t                 code = 0;
+  int32_t                 lino = 0;
+  const TZoneRecordArray *zoneMap = NULL;
+
+  TARRAY2_CLEAR(columnDataAggArray, NULL);
+  TAOS_CHECK_GOTO(tsdbDataFileLoadBlockZone(reader, blockOffset, &zoneMap), &lino, _exit);
+  if (zoneMap == NULL) {
+    goto _exit;
+  }
+
+  for (int32_t i = tsdbZoneMapSeek(zoneMap, blockOffset); i < TARRAY2_SIZE(zoneMap); i++) {
+    const SZoneRecord *zone = TARRAY2_GET_PTR(zoneMap, i);
+    if (zone->blockOffset != blockOffset) {
+      break;
+    }
+
+    SColumnDataAgg sma[1] = {{
+        .colId = zone->cid,
+        .numOfNull = zone->numOfNull,
+        .max = zone->max,
+        .min = zone->min,
+    }};
+    TAOS_CHECK_GOTO(TARRAY2_APPEND_PTR(columnDataAggArray, sma), &lino, _exit);
+  }
+
+_exit:
+  if (code) {
+    tsdbError("vgId:%d %s failed at %s:%d since %s", TD_VID(reader->config->tsdb->pVnode), __func__, __FILE__, lino,
+              tstrerror(code));
+  }
+  return code;
+}
+
 extern int32_t tBlockDataDecompress(SBufferReader *br, SBlockData *blockData, SBuffer *assist);
 
 int32_t tsdbDataFileReadBlockData(SDataFileReader *reader, const SBrinRecord *record, SBlockData *bData) {
@@ -485,6 +838,16 @@ int32_t tsdbDataFileReadBlockDataByColumn(SDataFileReader *reader, const SBrinRe
       };
       TAOS_CHECK_GOTO(tBlockDataDecompressColData(&hdr, &none, &br, bData, assist), &lino, _exit);
     } else if (cid == blockCol.cid) {
+      // load from the column cache
+      const STFile *file = &reader->config->files[TSDB_FTYPE_DATA].file;
+      bool          hit = false;
+      TAOS_CHECK_GOTO(tsdbCacheGetColData(reader->config->tsdb, file->fid, file->cid, record->blockOffset, cid, bData,
+                                          &hit),
+                      &lino, _exit);
+      if (hit) {
+        continue;
+      }
+
       int32_t encryptAlgorithm = reader->config->tsdb->pVnode->config.tsdbCfg.encryptAlgorithm;
       char   *encryptKey = reader->config->tsdb->pVnode->config.tsdbCfg.encryptKey;
       // load from file
@@ -500,6 +863,9 @@ int32_t tsdbDataFileReadBlockDataByColumn(SDataFileReader *reader, const SBrinRe
       // decode the buffer
       SBufferReader br1 = BUFFER_READER_INITIALIZER(0, buffer1);
       TAOS_CHECK_GOTO(tBlockDataDecompressColData(&hdr, &blockCol, &br1, bData, assist), &lino, _exit);
+
+      tsdbCacheSetColData(reader->config->tsdb, file->fid, file->cid, record->blockOffset,
+                          &bData->aColData[bData->nColData - 1]);
     }
   }
 
@@ -547,6 +913,52 @@ _exit:
   return code;
 }
 
+int32_t tsdbDataFileReadAheadBlock(SDataFileReader *reader, const SBrinRecord *record) {
+  int32_t code = 0;
+  int32_t lino = 0;
+
+  if (reader->fd[TSDB_FTYPE_DATA]) {
+    TAOS_CHECK_GOTO(tsdbPrefetchFile(reader->fd[TSDB_FTYPE_DATA], record->blockOffset, record->blockSize), &lino,
+                    _exit);
+  }
+
+  if (reader->fd[TSDB_FTYPE_SMA] && record->smaSize > 0) {
+    TAOS_CHECK_GOTO(tsdbPrefetchFile(reader->fd[TSDB_FTYPE_SMA], record->smaOffset, record->smaSize), &lino, _exit);
+  }
+
+_exit:
+  if (code) {
+    tsdbError("vgId:%d %s failed at %s:%d since %s", TD_VID(reader->config->tsdb->pVnode), __func__, __FILE__, lino,
+              tstrerror(code));
+  }
+  return code;
+}
+
+// read ahead the whole .head and .tomb files and the first dataSize bytes of the .data file through the reader's fds
+int32_t tsdbDataFileReadAheadFiles(SDataFileReader *reader, int64_t dataSize) {
+  int32_t code = 0;
+  int32_t lino = 0;
+
+  for (int32_t ftype = 0; ftype < TSDB_FTYPE_MAX; ++ftype) {
+    if (reader->fd[ftype] == NULL || ftype == TSDB_FTYPE_SMA) {
+      continue;
+    }
+
+    int64_t size = reader->config->files[ftype].file.size;
+    if (ftype == TSDB_FTYPE_DATA) {
+      size = TMIN(size, dataSize);
+    }
+    TAOS_CHECK_GOTO(tsdbPrefetchFile(reader->fd[ftype], 0, size), &lino, _exit);
+  }
+
+_exit:
+  if (code) {
+    tsdbError("vgId:%d %s failed at %s:%d since %s", TD_VID(reader->config->tsdb->pVnode), __func__, __FILE__, lino,
+              tstrerror(code));
+  }
+  return code;
+}
+
 int32_t tsdbDataFileReadTombBlk(SDataFileReader *reader, const TTombBlkArray **tombBlkArray) {
   int32_t code = 0;
   int32_t lino = 0;
@@ -622,6 +1034,204 @@ _exit:
   return code;
 }
 
+// STombIndex =============================================
+void tsdbTombIndexDestroy(STombIndex *index) {
+  if (index) {
+    TARRAY2_DESTROY(index->records, NULL);
+    TARRAY2_DESTROY(index->latest, NULL);
+    taosMemoryFree(index);
+  }
+}
+
+typedef struct {
+  int64_t skey;
+  int64_t ekey;
+} STombRange;
+
+typedef TARRAY2(STombRange) TTombRangeArray;
+
+static int32_t tsdbTombRangeCmprFn(const STombRange *range1, const STombRange *range2) {
+  if (range1->skey < range2->skey) return -1;
+  if (range1->skey > range2->skey) return 1;
+  return 0;
+}
+
+/* Drop the records of a table in index->latest[tbStart, size) that are covered by a newer record of the table, which
+ * has all of them appended in version order. The records are visited from the newest on, and stairs holds the key
+ * ranges visited so far that no other one covers, sorted by skey and so by ekey as well. A record is covered if the
+ * last of them starting no later than it ends no earlier, so each record takes a binary search.
+ */
+static int32_t tsdbTombIndexPruneTable(STombIndex *index, int32_t tbStart, TTombRangeArray *stairs) {
+  int32_t code = 0;
+  int32_t end = TARRAY2_SIZE(index->latest);
+  int32_t kept = end;
+
+  TARRAY2_CLEAR(stairs, NULL);
+  for (int32_t i = end - 1; i >= tbStart; i--) {
+    STombRecord record = TARRAY2_GET(index->latest, i);
+    STombRange  range = {.skey = record.skey, .ekey = record.ekey};
+
+    int32_t idx = TARRAY2_SEARCH_IDX(stairs, &range, tsdbTombRangeCmprFn, TD_LE);
+    if (idx >= 0 && TARRAY2_GET(stairs, idx).ekey >= range.ekey) {
+      continue;
+    }
+
+    // the ranges covered by this one are the one starting at the same key, if any, and those right after it
+    int32_t first = (idx >= 0 && TARRAY2_GET(stairs, idx).skey == range.skey) ? idx : idx + 1;
+    int32_t last = first;
+    while (last < TARRAY2_SIZE(stairs) && TARRAY2_GET(stairs, last).ekey <= range.ekey) {
+      last++;
+    }
+    if (last > first) {
+      TARRAY2_GET(stairs, first) = range;
+      (void)memmove(TARRAY2_GET_PTR(stairs, first + 1), TARRAY2_GET_PTR(stairs, last),
+                    sizeof(STombRange) * (TARRAY2_SIZE(stairs) - last));
+      TARRAY2_SIZE(stairs) -= last - first - 1;
+    } else if ((code = TARRAY2_INSERT_PTR(stairs, first, &range))) {
+      return code;
+    }
+
+    TARRAY2_GET(index->latest, --kept) = record;
+  }
+
+  if (kept > tbStart) {
+    (void)memmove(TARRAY2_GET_PTR(index->latest, tbStart), TARRAY2_GET_PTR(index->latest, kept),
+                  sizeof(STombRecord) * (end - kept));
+    TARRAY2_SIZE(index->latest) = tbStart + end - kept;
+  }
+  return 0;
+}
+
+// records come in (suid, uid, version) order, the ones of a table are pruned together once the next table starts
+static int32_t tsdbTombIndexPutLatest(STombIndex *index, int32_t *tbStart, const STombRecord *record,
+                                      TTombRangeArray *stairs) {
+  int32_t code;
+
+  if (TARRAY2_SIZE(index->latest) > 0) {
+    const STombRecord *last = TARRAY2_GET_PTR(index->latest, TARRAY2_SIZE(index->latest) - 1);
+    if (last->suid != record->suid || last->uid != record->uid) {
+      if ((code = tsdbTombIndexPruneTable(index, *tbStart, stairs))) {
+        return code;
+      }
+      *tbStart = TARRAY2_SIZE(index->latest);
+    }
+  }
+
+  return TARRAY2_APPEND_PTR(index->latest, record);
+}
+
+static int32_t tsdbTombIndexBuild(SDataFileReader *reader, STombIndex **index) {
+  int32_t              code = 0;
+  int32_t              lino = 0;
+  const TTombBlkArray *tombBlkArray = NULL;
+  STombBlock           tombBlock[1] = {0};
+  TTombRangeArray      stairs[1] = {0};
+  int32_t              tbStart = 0;
+
+  if ((index[0] = taosMemoryCalloc(1, sizeof(STombIndex))) == NULL) {
+    TAOS_CHECK_GOTO(terrno, &lino, _exit);
+  }
+  index[0]->maxVer = VERSION_MIN;
+  TARRAY2_INIT(index[0]->records);
+  TARRAY2_INIT(index[0]->latest);
+
+  TAOS_CHECK_GOTO(tsdbDataFileReadTombBlk(reader, &tombBlkArray), &lino, _exit);
+
+  tTombBlockInit(tombBlock);
+  for (int32_t i = 0; i < TARRAY2_SIZE(tombBlkArray); i++) {
+    TAOS_CHECK_GOTO(tsdbDataFileReadTombBlock(reader, TARRAY2_GET_PTR(tombBlkArray, i), tombBlock), &lino, _exit);
+
+    for (int32_t j = 0; j < TOMB_BLOCK_SIZE(tombBlock); j++) {
+      STombRecord record[1];
+      TAOS_CHECK_GOTO(tTombBlockGet(tombBlock, j, record), &lino, _exit);
+      TAOS_CHECK_GOTO(TARRAY2_APPEND_PTR(index[0]->records, record), &lino, _exit);
+      TAOS_CHECK_GOTO(tsdbTombIndexPutLatest(index[0], &tbStart, record, stairs), &lino, _exit);
+      index[0]->maxVer = TMAX(index[0]->maxVer, record->version);
+    }
+  }
+  TAOS_CHECK_GOTO(tsdbTombIndexPruneTable(index[0], tbStart, stairs), &lino, _exit);
+
+_exit:
+  tTombBlockDestroy(tombBlock);
+  TARRAY2_DESTROY(stairs, NULL);
+  if (code) {
+    tsdbError("vgId:%d %s failed at %s:%d since %s", TD_VID(reader->config->tsdb->pVnode), __func__, __FILE__, lino,
+              tstrerror(code));
+    tsdbTombIndexDestroy(index[0]);
+    index[0] = NULL;
+  }
+  return code;
+}
+
+int32_t tsdbDataFileReadTombIndex(SDataFileReader *reader, STFileObj *fobj, const STombIndex **index) {
+  int32_t     code = 0;
+  int32_t     lino = 0;
+  STombIndex *newIndex = NULL;
+
+  (void)taosThreadMutexLock(&fobj->mutex);
+  index[0] = fobj->tombIndex;
+  (void)taosThreadMutexUnlock(&fobj->mutex);
+
+  if (index[0] == NULL) {
+    // build without holding the lock, the first one to finish wins
+    TAOS_CHECK_GOTO(tsdbTombIndexBuild(reader, &newIndex), &lino, _exit);
+
+    (void)taosThreadMutexLock(&fobj->mutex);
+    if (fobj->tombIndex == NULL) {
+      fobj->tombIndex = newIndex;
+      newIndex = NULL;
+    }
+    index[0] = fobj->tombIndex;
+    (void)taosThreadMutexUnlock(&fobj->mutex);
+
+    tsdbTombIndexDestroy(newIndex);
+  }
+
+_exit:
+  if (code) {
+    tsdbError("vgId:%d %s failed at %s:%d since %s", TD_VID(reader->config->tsdb->pVnode), __func__, __FILE__, lino,
+              tstrerror(code));
+  }
+  return code;
+}
+
+const TTombRecordArray *tsdbTombIndexGetRecords(const STombIndex *index, int64_t maxVer) {
+  // the pruned records are only exact when every tomb record is visible to the reader
+  return (maxVer >= index->maxVer) ? index->latest : index->records;
+}
+
+int32_t tsdbTombIndexSeek(const TTombRecordArray *records, int64_t suid, int64_t uid) {
+  int32_t lidx = 0;
+  int32_t ridx = TARRAY2_SIZE(records);
+
+  while (lidx < ridx) {
+    int32_t            midx = (lidx + ridx) >> 1;
+    const STombRecord *record = TARRAY2_GET_PTR(records, midx);
+    if (record->suid < suid || (record->suid == suid && record->uid < uid)) {
+      lidx = midx + 1;
+    } else {
+      ridx = midx;
+    }
+  }
+
+  return lidx;
+}
+
+bool tsdbTombIndexCovered(const TTombRecordArray *records, int64_t suid, int64_t uid, int64_t skey, int64_t ekey,
+                          int64_t minVer, int64_t maxVer) {
+  for (int32_t i = tsdbTombIndexSeek(records, suid, uid); i < TARRAY2_SIZE(records); i++) {
+    const STombRecord *record = TARRAY2_GET_PTR(records, i);
+    if (record->suid != suid || record->uid != uid) {
+      break;
+    }
+
+    if (record->version >= minVer && record->version <= maxVer && record->skey <= skey && record->ekey >= ekey) {
+      return true;
+    }
+  }
+  return false;
+}
+
 // SDataFileWriter =============================================
 struct SDataFileWriter {
   SDataFileWriterConfig config[1];
@@ -662,9 +1272,12 @@ struct SDataFileWriter {
   SHeadFooter headFooter[1];
   STombFooter tombFooter[1];
 
-  TBrinBlkArray brinBlkArray[1];
-  SBrinBlock    brinBlock[1];
-  SBlockData    blockData[1];
+  TBrinBlkArray    brinBlkArray[1];
+  SBrinBlock       brinBlock[1];
+  SBlockData       blockData[1];
+  TBloomBlkArray   bloomBlkArray[1];
+  TZoneRecordArray zoneMap[1];
+  SHashObj        *adaptCmpr;
 
   TTombBlkArray tombBlkArray[1];
   STombBlock    tombBlock[1];
@@ -683,6 +1296,9 @@ static void tsdbDataFileWriterDoClose(SDataFileWriter *writer) {
 
   tTombBlockDestroy(writer->tombBlock);
   TARRAY2_DESTROY(writer->tombBlkArray, NULL);
+  TARRAY2_DESTROY(writer->bloomBlkArray, NULL);
+  TARRAY2_DESTROY(writer->zoneMap, NULL);
+  taosHashCleanup(writer->adaptCmpr);
   tBlockDataDestroy(writer->blockData);
   tBrinBlockDestroy(writer->brinBlock);
   TARRAY2_DESTROY(writer->brinBlkArray, NULL);
@@ -807,6 +1423,12 @@ static int32_t tsdbDataFileWriterDoOpen(SDataFileWriter *writer) {
   writer->ctx->range = (SVersionRange){.minVer = VERSION_MAX, .maxVer = VERSION_MIN};
   writer->ctx->tombRange = (SVersionRange){.minVer = VERSION_MAX, .maxVer = VERSION_MIN};
 
+  // algorithms chosen by tsdbAdaptiveCompress for the columns of this file set
+  writer->adaptCmpr = taosHashInit(64, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), false, HASH_NO_LOCK);
+  if (writer->adaptCmpr == NULL) {
+    TAOS_CHECK_GOTO(terrno, &lino, _exit);
+  }
+
   writer->ctx->opened = true;
 
 _exit:
@@ -984,6 +1606,115 @@ _exit:
   return code;
 }
 
+static int32_t tsdbDataFileWriteBloomData(SDataFileWriter *writer, SBloomBlk *bloomBlk, const void *data) {
+  int32_t code = 0;
+  int32_t lino = 0;
+
+  int32_t encryptAlgorithm = writer->config->tsdb->pVnode->config.tsdbCfg.encryptAlgorithm;
+  char   *encryptKey = writer->config->tsdb->pVnode->config.tsdbCfg.encryptKey;
+
+  TAOS_CHECK_GOTO(tsdbFileWriteBloomData(writer->fd[TSDB_FTYPE_HEAD], bloomBlk, data, writer->bloomBlkArray,
+                                         &writer->files[TSDB_FTYPE_HEAD].size, encryptAlgorithm, encryptKey),
+                  &lino, _exit);
+
+_exit:
+  if (code) {
+    tsdbError("vgId:%d %s failed at %s:%d since %s", TD_VID(writer->config->tsdb->pVnode), __func__, __FILE__, lino,
+              tstrerror(code));
+  }
+  return code;
+}
+
+// build the bloom filter of the timestamps of a newly written data block, which point queries on ts look up
+static int32_t tsdbDataFileDoWriteBlockBloom(SDataFileWriter *writer, SBlockData *bData, int64_t blockOffset) {
+  if (!tsTsdbBloomFilter) {
+    return 0;
+  }
+
+  int32_t       code = 0;
+  int32_t       lino = 0;
+  SBloomFilter *bf = NULL;
+
+  TAOS_CHECK_GOTO(tBloomFilterInit(bData->nRow, TSDB_BLOOM_FILTER_FPP, &bf), &lino, _exit);
+
+  for (int32_t iRow = 0; iRow < bData->nRow; iRow++) {
+    // put returns failure if the key is already in the filter, which is fine here
+    (void)tBloomFilterPut(bf, &bData->aTSKEY[iRow], sizeof(TSKEY));
+  }
+
+  SBloomBlk bloomBlk = {
+      .blockOffset = blockOffset,
+      .size = bf->numUnits * sizeof(uint64_t),
+      .hashFuncs = bf->hashFunctions,
+  };
+  TAOS_CHECK_GOTO(tsdbDataFileWriteBloomData(writer, &bloomBlk, bf->buffer), &lino, _exit);
+
+_exit:
+  if (code) {
+    tsdbError("vgId:%d %s failed at %s:%d since %s", TD_VID(writer->config->tsdb->pVnode), __func__, __FILE__, lino,
+              tstrerror(code));
+  }
+  tBloomFilterDestroy(bf);
+  return code;
+}
+
+// keep the bloom filter of a data block which is moved from the old .head file to the new one as is
+static int32_t tsdbDataFileCopyBlockBloom(SDataFileWriter *writer, const SBrinRecord *record) {
+  if (writer->ctx->reader == NULL) {
+    return 0;
+  }
+
+  int32_t          code = 0;
+  int32_t          lino = 0;
+  const SBloomBlk *blk = NULL;
+
+  TAOS_CHECK_GOTO(tsdbDataFileLoadBlockBloom(writer->ctx->reader, record, &blk), &lino, _exit);
+  if (blk == NULL) {
+    goto _exit;
+  }
+
+  SBloomBlk bloomBlk = *blk;
+  TAOS_CHECK_GOTO(tsdbDataFileWriteBloomData(writer, &bloomBlk, writer->ctx->reader->bloomBuffer->data), &lino, _exit);
+
+_exit:
+  if (code) {
+    tsdbError("vgId:%d %s failed at %s:%d since %s", TD_VID(writer->config->tsdb->pVnode), __func__, __FILE__, lino,
+              tstrerror(code));
+  }
+  return code;
+}
+
+// keep the zone records of a data block which is moved from the old .head file to the new one
+static int32_t tsdbDataFileCopyBlockZone(SDataFileWriter *writer, const SBrinRecord *record) {
+  if (writer->ctx->reader == NULL) {
+    return 0;
+  }
+
+  int32_t                 code = 0;
+  int32_t                 lino = 0;
+  const TZoneRecordArray *zoneMap = NULL;
+
+  TAOS_CHECK_GOTO(tsdbDataFileLoadBlockZone(writer->ctx->reader, record->blockOffset, &zoneMap), &lino, _exit);
+  if (zoneMap == NULL) {
+    goto _exit;
+  }
+
+  for (int32_t i = tsdbZoneMapSeek(zoneMap, record->blockOffset); i < TARRAY2_SIZE(zoneMap); i++) {
+    const SZoneRecord *zone = TARRAY2_GET_PTR(zoneMap, i);
+    if (zone->blockOffset != record->blockOffset) {
+      break;
+    }
+    TAOS_CHECK_GOTO(TARRAY2_APPEND_PTR(writer->zoneMap, zone), &lino, _exit);
+  }
+
+_exit:
+  if (code) {
+    tsdbError("vgId:%d %s failed at %s:%d since %s", TD_VID(writer->config->tsdb->pVnode), __func__, __FILE__, lino,
+              tstrerror(code));
+  }
+  return code;
+}
+
 static int32_t tsdbDataFileDoWriteBlockData(SDataFileWriter *writer, SBlockData *bData) {
   if (bData->nRow == 0) {
     return 0;
@@ -998,7 +1729,8 @@ static int32_t tsdbDataFileDoWriteBlockData(SDataFileWriter *writer, SBlockData
   SBuffer *buffers = writer->buffers;
   SBuffer *assist = writer->buffers + 4;
 
-  SColCompressInfo cmprInfo = {.pColCmpr = NULL, .defaultCmprAlg = writer->config->cmprAlg};
+  SColCompressInfo cmprInfo = {
+      .pColCmpr = NULL, .defaultCmprAlg = writer->config->cmprAlg, .pAdaptCmpr = writer->adaptCmpr};
 
   SBrinRecord record[1] = {{
       .suid = bData->suid,
@@ -1061,6 +1793,17 @@ static int32_t tsdbDataFileDoWriteBlockData(SDataFileWriter *writer, SBlockData
     tColDataCalcSMA[colData->type](colData, &sma->sum, &sma->max, &sma->min, &sma->numOfNull);
 
     TAOS_CHECK_GOTO(tPutColumnDataAgg(&buffers[0], sma), &lino, _exit);
+
+    if (tsTsdbZoneMap) {
+      SZoneRecord zone = {
+          .blockOffset = record->blockOffset,
+          .cid = sma->colId,
+          .numOfNull = sma->numOfNull,
+          .min = sma->min,
+          .max = sma->max,
+      };
+      TAOS_CHECK_GOTO(TARRAY2_APPEND(writer->zoneMap, zone), &lino, _exit);
+    }
   }
   record->smaSize = buffers[0].size;
 
@@ -1071,6 +1814,9 @@ static int32_t tsdbDataFileDoWriteBlockData(SDataFileWriter *writer, SBlockData
     writer->files[TSDB_FTYPE_SMA].size += record->smaSize;
   }
 
+  // to .head file
+  TAOS_CHECK_GOTO(tsdbDataFileDoWriteBlockBloom(writer, bData, record->blockOffset), &lino, _exit);
+
   // append SBrinRecord
   TAOS_CHECK_GOTO(tsdbDataFileWriteBrinRecord(writer, record), &lino, _exit);
 
@@ -1085,6 +1831,33 @@ _exit:
   return code;
 }
 
+// Blocks of data files are cut at the boundaries of the rollup interval, so that each block lies in one window of an
+// INTERVAL query whose interval is a multiple of the rollup interval, without offset or sliding. Such windows start at
+// multiples of the interval since the epoch, and windows of whole days are shifted by the server timezone as in
+// taosTimeTruncate. Only queries that take the SMA of a block and have no filter skip loading it.
+static bool tsdbDataFileCrossRollupWindow(SDataFileWriter *writer, TSDBROW *row) {
+  if (tsTsdbRollupInterval <= 0 || writer->blockData->nRow == 0) {
+    return false;
+  }
+
+  int64_t ticks = TSDB_TICK_PER_SECOND(writer->config->tsdb->keepCfg.precision);
+  int64_t interval = (int64_t)tsTsdbRollupInterval * ticks;
+  int64_t lastKey = writer->blockData->aTSKEY[writer->blockData->nRow - 1];
+  int64_t key = TSDBROW_TS(row);
+
+  if (interval % (86400 * ticks) == 0) {
+#if defined(WINDOWS) && _MSC_VER >= 1900
+    int64_t timezone = _timezone;
+#endif
+    lastKey -= (int64_t)timezone * ticks;
+    key -= (int64_t)timezone * ticks;
+  }
+
+  lastKey = lastKey - ((lastKey % interval) + interval) % interval;
+  key = key - ((key % interval) + interval) % interval;
+  return key != lastKey;
+}
+
 static int32_t tsdbDataFileDoWriteTSRow(SDataFileWriter *writer, TSDBROW *row) {
   int32_t code = 0;
   int32_t lino = 0;
@@ -1103,7 +1876,7 @@ static int32_t tsdbDataFileDoWriteTSRow(SDataFileWriter *writer, TSDBROW *row) {
   ) {
     TAOS_CHECK_GOTO(tBlockDataUpdateRow(writer->blockData, row, writer->config->skmRow->pTSchema), &lino, _exit);
   } else {
-    if (writer->blockData->nRow >= writer->config->maxRow) {
+    if (writer->blockData->nRow >= writer->config->maxRow || tsdbDataFileCrossRollupWindow(writer, row)) {
       TAOS_CHECK_GOTO(tsdbDataFileDoWriteBlockData(writer, writer->blockData), &lino, _exit);
     }
 
@@ -1178,6 +1951,8 @@ static int32_t tsdbDataFileDoWriteTableOldData(SDataFileWriter *writer, const ST
               TAOS_CHECK_GOTO(tsdbDataFileDoWriteBlockData(writer, writer->blockData), &lino, _exit);
             }
 
+            TAOS_CHECK_GOTO(tsdbDataFileCopyBlockBloom(writer, record), &lino, _exit);
+            TAOS_CHECK_GOTO(tsdbDataFileCopyBlockZone(writer, record), &lino, _exit);
             TAOS_CHECK_GOTO(tsdbDataFileWriteBrinRecord(writer, record), &lino, _exit);
           } else {
             TAOS_CHECK_GOTO(tsdbDataFileReadBlockData(writer->ctx->reader, record, writer->ctx->blockData), &lino,
@@ -1295,6 +2070,8 @@ static int32_t tsdbDataFileWriteTableDataBegin(SDataFileWriter *writer, const TA
           }
         }
 
+        TAOS_CHECK_GOTO(tsdbDataFileCopyBlockBloom(writer, &record), &lino, _exit);
+        TAOS_CHECK_GOTO(tsdbDataFileCopyBlockZone(writer, &record), &lino, _exit);
         TAOS_CHECK_GOTO(tsdbDataFileWriteBrinRecord(writer, &record), &lino, _exit);
       }
     }
@@ -1614,6 +2391,140 @@ _exit:
   return code;
 }
 
+static int32_t tsdbDataFileWriteBloomBlk(SDataFileWriter *writer) {
+  if (TARRAY2_SIZE(writer->bloomBlkArray) == 0) {
+    return 0;
+  }
+
+  int32_t code = 0;
+  int32_t lino = 0;
+
+  int32_t encryptAlgorithm = writer->config->tsdb->pVnode->config.tsdbCfg.encryptAlgorithm;
+  char   *encryptKey = writer->config->tsdb->pVnode->config.tsdbCfg.encryptKey;
+
+  TAOS_CHECK_GOTO(tsdbFileWriteBloomBlk(writer->fd[TSDB_FTYPE_HEAD], writer->bloomBlkArray,
+                                        writer->headFooter->bloomBlkPtr, &writer->files[TSDB_FTYPE_HEAD].size,
+                                        encryptAlgorithm, encryptKey),
+                  &lino, _exit);
+
+_exit:
+  if (code) {
+    tsdbError("vgId:%d %s failed at %s:%d since %s", TD_VID(writer->config->tsdb->pVnode), __func__, __FILE__, lino,
+              tstrerror(code));
+  }
+  return code;
+}
+
+int32_t tsdbFileWriteBloomData(STsdbFD *fd, SBloomBlk *bloomBlk, const void *data, TBloomBlkArray *bloomBlkArray,
+                               int64_t *fileSize, int32_t encryptAlgorithm, char *encryptKey) {
+  bloomBlk->offset = *fileSize;
+  TAOS_CHECK_RETURN(tsdbWriteFile(fd, bloomBlk->offset, data, bloomBlk->size, encryptAlgorithm, encryptKey));
+  *fileSize += bloomBlk->size;
+
+  TAOS_CHECK_RETURN(TARRAY2_APPEND_PTR(bloomBlkArray, bloomBlk));
+  return 0;
+}
+
+int32_t tsdbFileWriteBloomBlk(STsdbFD *fd, TBloomBlkArray *bloomBlkArray, SFDataPtr *ptr, int64_t *fileSize,
+                              int32_t encryptAlgorithm, char *encryptKey) {
+  // sorted by block offset for binary search when reading
+  TARRAY2_SORT(bloomBlkArray, tBloomBlkCmprFn);
+
+  ptr->offset = *fileSize;
+  ptr->size = TARRAY2_DATA_LEN(bloomBlkArray);
+  TAOS_CHECK_RETURN(tsdbWriteFile(fd, ptr->offset, (const uint8_t *)TARRAY2_DATA(bloomBlkArray), ptr->size,
+                                  encryptAlgorithm, encryptKey));
+  *fileSize += ptr->size;
+  return 0;
+}
+
+int32_t tsdbFileWriteZoneMap(STsdbFD *fd, TZoneRecordArray *zoneMap, int32_t maxBlocks, SFDataPtr *ptr,
+                             int64_t *fileSize, int32_t encryptAlgorithm, char *encryptKey) {
+  int32_t       code = 0;
+  int32_t       lino = 0;
+  TZoneBlkArray zoneBlkArray[1];
+  uint8_t      *data = NULL;
+
+  TARRAY2_INIT(zoneBlkArray);
+  if (TARRAY2_SIZE(zoneMap) <= 0 || maxBlocks <= 0) {
+    TAOS_CHECK_GOTO(TSDB_CODE_INVALID_PARA, &lino, _exit);
+  }
+
+  // sorted by block offset for binary search when reading
+  TARRAY2_SORT(zoneMap, tZoneRecordCmprFn);
+
+  int32_t szRecord = tPutZoneRecord(NULL, TARRAY2_GET_PTR(zoneMap, 0));
+  if ((data = taosMemoryMalloc((int64_t)szRecord * TARRAY2_SIZE(zoneMap))) == NULL) {
+    TAOS_CHECK_GOTO(terrno, &lino, _exit);
+  }
+
+  // each zone block takes the records of up to maxBlocks data blocks
+  for (int32_t i = 0; i < TARRAY2_SIZE(zoneMap);) {
+    SZoneBlk zoneBlk = {
+        .minBlockOffset = TARRAY2_GET_PTR(zoneMap, i)->blockOffset,
+        .offset = *fileSize,
+    };
+    int32_t numOfBlocks = 0;
+    int32_t j = i;
+    for (; j < TARRAY2_SIZE(zoneMap); j++) {
+      const SZoneRecord *record = TARRAY2_GET_PTR(zoneMap, j);
+      if (j == i || record->blockOffset != zoneBlk.maxBlockOffset) {
+        if (numOfBlocks == maxBlocks) {
+          break;
+        }
+        numOfBlocks++;
+        zoneBlk.maxBlockOffset = record->blockOffset;
+      }
+      zoneBlk.size += tPutZoneRecord(data + zoneBlk.size, record);
+    }
+    zoneBlk.numRec = j - i;
+
+    TAOS_CHECK_GOTO(tsdbWriteFile(fd, zoneBlk.offset, data, zoneBlk.size, encryptAlgorithm, encryptKey), &lino, _exit);
+    *fileSize += zoneBlk.size;
+    TAOS_CHECK_GOTO(TARRAY2_APPEND(zoneBlkArray, zoneBlk), &lino, _exit);
+    i = j;
+  }
+
+  ptr->offset = *fileSize;
+  ptr->size = TARRAY2_DATA_LEN(zoneBlkArray);
+  TAOS_CHECK_GOTO(tsdbWriteFile(fd, ptr->offset, (const uint8_t *)TARRAY2_DATA(zoneBlkArray), ptr->size,
+                                encryptAlgorithm, encryptKey),
+                  &lino, _exit);
+  *fileSize += ptr->size;
+
+_exit:
+  if (code) {
+    tsdbError("%s failed at %s:%d since %s", __func__, __FILE__, lino, tstrerror(code));
+  }
+  taosMemoryFree(data);
+  TARRAY2_DESTROY(zoneBlkArray, NULL);
+  return code;
+}
+
+static int32_t tsdbDataFileWriteZoneMap(SDataFileWriter *writer) {
+  if (TARRAY2_SIZE(writer->zoneMap) == 0) {
+    return 0;
+  }
+
+  int32_t code = 0;
+  int32_t lino = 0;
+
+  int32_t encryptAlgorithm = writer->config->tsdb->pVnode->config.tsdbCfg.encryptAlgorithm;
+  char   *encryptKey = writer->config->tsdb->pVnode->config.tsdbCfg.encryptKey;
+
+  TAOS_CHECK_GOTO(tsdbFileWriteZoneMap(writer->fd[TSDB_FTYPE_HEAD], writer->zoneMap, writer->config->maxRow,
+                                       writer->headFooter->zoneMapPtr, &writer->files[TSDB_FTYPE_HEAD].size,
+                                       encryptAlgorithm, encryptKey),
+                  &lino, _exit);
+
+_exit:
+  if (code) {
+    tsdbError("vgId:%d %s failed at %s:%d since %s", TD_VID(writer->config->tsdb->pVnode), __func__, __FILE__, lino,
+              tstrerror(code));
+  }
+  return code;
+}
+
 void tsdbTFileUpdVerRange(STFile *f, SVersionRange range) {
   f->minVer = TMIN(f->minVer, range.minVer);
   f->maxVer = TMAX(f->maxVer, range.maxVer);
@@ -1636,6 +2547,8 @@ static int32_t tsdbDataFileWriterCloseCommit(SDataFileWriter *writer, TFileOpArr
     TAOS_CHECK_GOTO(tsdbDataFileWriteTableDataBegin(writer, tbid), &lino, _exit);
     TAOS_CHECK_GOTO(tsdbDataFileWriteBrinBlock(writer), &lino, _exit);
     TAOS_CHECK_GOTO(tsdbDataFileWriteBrinBlk(writer), &lino, _exit);
+    TAOS_CHECK_GOTO(tsdbDataFileWriteBloomBlk(writer), &lino, _exit);
+    TAOS_CHECK_GOTO(tsdbDataFileWriteZoneMap(writer), &lino, _exit);
     TAOS_CHECK_GOTO(tsdbDataFileWriteHeadFooter(writer), &lino, _exit);
 
     SVersionRange ofRange = {.minVer = VERSION_MAX, .maxVer = VERSION_MIN};
@@ -29,9 +29,49 @@ typedef TARRAY2(SColumnDataAgg) TColumnDataAggArray;
 
 typedef struct {
   SFDataPtr brinBlkPtr[1];
-  char      rsrvd[32];
+  SFDataPtr bloomBlkPtr[1];
+  SFDataPtr zoneMapPtr[1];
 } SHeadFooter;
 
+// per data block bloom filter of the timestamps, stored in .head file and keyed by the block offset in .data file
+typedef struct {
+  int64_t  blockOffset;
+  int64_t  offset;
+  int32_t  size;
+  uint32_t hashFuncs;
+  int8_t   rsvd[8];
+} SBloomBlk;
+
+typedef TARRAY2(SBloomBlk) TBloomBlkArray;
+
+// per data block min/max of the columns with SMA, stored in .head file and sorted by (blockOffset, cid), so that
+// blocks can be filtered without reading the .sma file
+typedef struct {
+  int64_t blockOffset;
+  int16_t cid;
+  int16_t numOfNull;
+  int64_t min;
+  int64_t max;
+} SZoneRecord;
+
+typedef TARRAY2(SZoneRecord) TZoneRecordArray;
+
+int32_t tPutZoneRecord(uint8_t *p, const SZoneRecord *record);
+int32_t tGetZoneRecord(uint8_t *p, SZoneRecord *record);
+
+// index of a zone block, which holds the encoded zone records of at most maxRow data blocks, the same number of
+// records as a BRIN block, so a reader only loads the zone records around the data block it checks
+typedef struct {
+  int64_t minBlockOffset;
+  int64_t maxBlockOffset;
+  int64_t offset;
+  int32_t size;
+  int32_t numRec;
+  int8_t  rsvd[8];
+} SZoneBlk;
+
+typedef TARRAY2(SZoneBlk) TZoneBlkArray;
+
 typedef struct {
   SFDataPtr tombBlkPtr[1];
   char      rsrvd[32];
@@ -55,6 +95,11 @@ void    tsdbDataFileReaderClose(SDataFileReader **reader);
 // .head
 int32_t tsdbDataFileReadBrinBlk(SDataFileReader *reader, const TBrinBlkArray **brinBlkArray);
 int32_t tsdbDataFileReadBrinBlock(SDataFileReader *reader, const SBrinBlk *brinBlk, SBrinBlock *brinBlock);
+int32_t tsdbDataFileReadBloomBlk(SDataFileReader *reader, const TBloomBlkArray **bloomBlkArray);
+int32_t tsdbDataFileBlockMayContain(SDataFileReader *reader, const SBrinRecord *record, const void *key, int32_t len,
+                                    bool *mayContain);
+int32_t tsdbDataFileReadZoneBlk(SDataFileReader *reader, const TZoneBlkArray **zoneBlkArray);
+int32_t tsdbDataFileReadBlockZone(SDataFileReader *reader, int64_t blockOffset, TColumnDataAggArray *columnDataAggArray);
 // .data
 int32_t tsdbDataFileReadBlockData(SDataFileReader *reader, const SBrinRecord *record, SBlockData *bData);
 int32_t tsdbDataFileReadBlockDataByColumn(SDataFileReader *reader, const SBrinRecord *record, SBlockData *bData,
@@ -62,10 +107,30 @@ int32_t tsdbDataFileReadBlockDataByColumn(SDataFileReader *reader, const SBrinRe
 // .sma
 int32_t tsdbDataFileReadBlockSma(SDataFileReader *reader, const SBrinRecord *record,
                                  TColumnDataAggArray *columnDataAggArray);
+// read-ahead of .data and .sma
+int32_t tsdbDataFileReadAheadBlock(SDataFileReader *reader, const SBrinRecord *record);
+int32_t tsdbDataFileReadAheadFiles(SDataFileReader *reader, int64_t dataSize);
 // .tomb
 int32_t tsdbDataFileReadTombBlk(SDataFileReader *reader, const TTombBlkArray **tombBlkArray);
 int32_t tsdbDataFileReadTombBlock(SDataFileReader *reader, const STombBlk *tombBlk, STombBlock *tData);
 
+// .tomb index: all tomb records of the file kept in memory with the file object, together with a pruned copy in which
+// the records covered by a newer record of the same table are dropped, so the delete skyline of each table is not
+// rebuilt from raw tomb blocks on every query
+typedef TARRAY2(STombRecord) TTombRecordArray;
+
+struct STombIndex {
+  int64_t          maxVer;
+  TTombRecordArray records[1];  // sorted by (suid, uid, version)
+  TTombRecordArray latest[1];   // sorted by (suid, uid, version), no record is covered by another of the same table
+};
+
+int32_t                 tsdbDataFileReadTombIndex(SDataFileReader *reader, STFileObj *fobj, const STombIndex **index);
+const TTombRecordArray *tsdbTombIndexGetRecords(const STombIndex *index, int64_t maxVer);
+int32_t                 tsdbTombIndexSeek(const TTombRecordArray *records, int64_t suid, int64_t uid);
+bool tsdbTombIndexCovered(const TTombRecordArray *records, int64_t suid, int64_t uid, int64_t skey, int64_t ekey,
+                          int64_t minVer, int64_t maxVer);
+
 // SDataFileWriter =============================================
 typedef struct SDataFileWriter SDataFileWriter;
 typedef struct SDataFileWriterConfig {
@@ -101,6 +166,16 @@ int32_t tsdbFileWriteBrinBlock(STsdbFD *fd, SBrinBlock *brinBlock, uint32_t cmpr
                                int32_t encryptAlgorithm, char *encryptKey);
 int32_t tsdbFileWriteBrinBlk(STsdbFD *fd, TBrinBlkArray *brinBlkArray, SFDataPtr *ptr, int64_t *fileSize,
                              int32_t encryptAlgorithm, char *encryptKey);
+int32_t tsdbFileWriteBloomData(STsdbFD *fd, SBloomBlk *bloomBlk, const void *data, TBloomBlkArray *bloomBlkArray,
+                               int64_t *fileSize, int32_t encryptAlgorithm, char *encryptKey);
+int32_t tsdbFileWriteBloomBlk(STsdbFD *fd, TBloomBlkArray *bloomBlkArray, SFDataPtr *ptr, int64_t *fileSize,
+                              int32_t encryptAlgorithm, char *encryptKey);
+int32_t tsdbFileWriteZoneMap(STsdbFD *fd, TZoneRecordArray *zoneMap, int32_t maxBlocks, SFDataPtr *ptr,
+                             int64_t *fileSize, int32_t encryptAlgorithm, char *encryptKey);
+int32_t tsdbFileReadZoneBlk(STsdbFD *fd, const SFDataPtr *ptr, TZoneBlkArray *zoneBlkArray, int32_t encryptAlgorithm,
+                            char *encryptKey);
+int32_t tsdbFileReadZoneBlock(STsdbFD *fd, const SZoneBlk *zoneBlk, SBuffer *buffer, TZoneRecordArray *zoneMap,
+                              int32_t encryptAlgorithm, char *encryptKey);
 int32_t tsdbFileWriteHeadFooter(STsdbFD *fd, int64_t *fileSize, const SHeadFooter *footer, int32_t encryptAlgorithm,
                                 char *encryptKey);
 
@@ -40,12 +40,14 @@ extern int32_t tsdbReadFile(STsdbFD *pFD, int64_t offset, uint8_t *pBuf, int64_t
                             int32_t encryptAlgorithm, char *encryptKey);
 extern int32_t tsdbReadFileToBuffer(STsdbFD *pFD, int64_t offset, int64_t size, SBuffer *buffer, int64_t szHint,
                                     int32_t encryptAlgorithm, char *encryptKey);
+extern int32_t tsdbPrefetchFile(STsdbFD *pFD, int64_t offset, int64_t size);
 extern int32_t tsdbFsyncFile(STsdbFD *pFD, int32_t encryptAlgorithm, char *encryptKey);
 
 typedef struct SColCompressInfo SColCompressInfo;
 struct SColCompressInfo {
   SHashObj *pColCmpr;
   uint32_t  defaultCmprAlg;
+  SHashObj *pAdaptCmpr;  // (table, column) -> algorithm chosen by tsdbAdaptiveCompress for the file, may be NULL
 };
 typedef struct SColCompressInfo2 SColCompressInfo2;
 struct SColCompressInfo2 {
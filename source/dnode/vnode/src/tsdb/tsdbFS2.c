@@ -19,6 +19,8 @@
 #include "vnd.h"
 
 #define BLOCK_COMMIT_FACTOR 3
+#define DISORDER_STT_TRIGGER_FACTOR 4
+#define DISORDER_STT_MAX_FILES      16  // stt files of all levels that a reader merges on a cold file set
 
 typedef struct STFileHashEntry {
   struct STFileHashEntry *next;
@@ -918,6 +920,41 @@ void tsdbFSCheckCommit(STsdb *tsdb, int32_t fid) {
   return;
 }
 
+/*
+ * A file set whose time range ends before the disorder watermark only receives late-arriving rows. The stt files of
+ * such a file set work as the disorder buffer: level 0 is merged with a larger trigger, so the disordered rows are
+ * rewritten in fewer and larger batches, and the data files of the file set are rewritten less often.
+ *
+ * A reader merges the stt files of all levels, so the larger trigger is capped to keep at most DISORDER_STT_MAX_FILES
+ * stt files on the file set, and it is never below the sttTrigger of the vnode. The trigger only decides when level 0
+ * is merged, the merger lays out the levels with the sttTrigger of the vnode whether the file set is cold or not.
+ */
+int32_t tsdbFSetSttTrigger(STsdb *tsdb, const STFileSet *fset) {
+  int32_t sttTrigger = tsdb->pVnode->config.sttTrigger;
+  if (sttTrigger <= 1 || tsTsdbDisorderWatermark <= 0) {
+    return sttTrigger;
+  }
+
+  TSKEY   minKey, maxKey;
+  int8_t  precision = tsdb->keepCfg.precision;
+  int64_t watermark = taosGetTimestamp(precision) - (int64_t)tsTsdbDisorderWatermark * TSDB_TICK_PER_SECOND(precision);
+
+  tsdbFidKeyRange(fset->fid, tsdb->keepCfg.days, precision, &minKey, &maxKey);
+  if (maxKey >= watermark) {
+    return sttTrigger;
+  }
+
+  int32_t        numUpperFile = 0;
+  const SSttLvl *lvl;
+  TARRAY2_FOREACH(fset->lvlArr, lvl) {
+    if (lvl->level > 0) {
+      numUpperFile += TARRAY2_SIZE(lvl->fobjArr);
+    }
+  }
+
+  return TMAX(sttTrigger, TMIN(sttTrigger * DISORDER_STT_TRIGGER_FACTOR, DISORDER_STT_MAX_FILES - numUpperFile));
+}
+
 // IMPORTANT: the caller must hold fs->tsdb->mutex
 int32_t tsdbFSEditCommit(STFileSystem *fs) {
   int32_t code = 0;
@@ -945,7 +982,8 @@ int32_t tsdbFSEditCommit(STFileSystem *fs) {
 
       // bool    skipMerge = false;
       int32_t numFile = TARRAY2_SIZE(lvl->fobjArr);
-      if (numFile >= sttTrigger && (!fset->mergeScheduled)) {
+      int32_t fsetSttTrigger = tsdbFSetSttTrigger(fs->tsdb, fset);
+      if (numFile >= fsetSttTrigger && (!fset->mergeScheduled)) {
         SMergeArg *arg = taosMemoryMalloc(sizeof(*arg));
         if (arg == NULL) {
           code = terrno;
@@ -960,7 +998,7 @@ int32_t tsdbFSEditCommit(STFileSystem *fs) {
         fset->mergeScheduled = true;
       }
 
-      if (numFile >= sttTrigger * BLOCK_COMMIT_FACTOR) {
+      if (numFile >= fsetSttTrigger * BLOCK_COMMIT_FACTOR) {
         tsdbFSSetBlockCommit(fset, true);
       } else {
         tsdbFSSetBlockCommit(fset, false);
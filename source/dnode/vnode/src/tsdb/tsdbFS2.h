@@ -64,6 +64,7 @@ void tsdbFSGetFSet(STFileSystem *fs, int32_t fid, STFileSet **fset);
 void tsdbFSCheckCommit(STsdb *tsdb, int32_t fid);
 void tsdbBeginTaskOnFileSet(STsdb *tsdb, int32_t fid, EVATaskT task, STFileSet **fset);
 void tsdbFinishTaskOnFileSet(STsdb *tsdb, int32_t fid, EVATaskT task);
+int32_t tsdbFSetSttTrigger(STsdb *tsdb, const STFileSet *fset);
 // utils
 int32_t save_fs(const TFileSetArray *arr, const char *fname);
 void    current_fname(STsdb *pTsdb, char *fname, EFCurrentT ftype);
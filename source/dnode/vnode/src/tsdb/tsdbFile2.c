@@ -238,6 +238,7 @@ int32_t tsdbTFileObjInit(STsdb *pTsdb, const STFile *f, STFileObj **fobj) {
   fobj[0]->f[0] = f[0];
   fobj[0]->state = TSDB_FSTATE_LIVE;
   fobj[0]->ref = 1;
+  fobj[0]->tombIndex = NULL;
   tsdbTFileName(pTsdb, f, fobj[0]->fname);
   // fobj[0]->nlevel = tfsGetLevel(pTsdb->pVnode->pTfs);
   fobj[0]->nlevel = vnodeNodeId(pTsdb->pVnode);
@@ -275,6 +276,7 @@ int32_t tsdbTFileObjUnref(STFileObj *fobj) {
     if (fobj->state == TSDB_FSTATE_DEAD) {
       tsdbRemoveFile(fobj->fname);
     }
+    tsdbTombIndexDestroy(fobj->tombIndex);
     taosMemoryFree(fobj);
   }
 
@@ -345,6 +347,7 @@ int32_t tsdbTFileObjRemove(STFileObj *fobj) {
   tsdbTrace("remove unref file %s, fobj:%p ref %d", fobj->fname, fobj, nRef);
   if (nRef == 0) {
     tsdbTFileObjRemoveLC(fobj, true);
+    tsdbTombIndexDestroy(fobj->tombIndex);
     taosMemoryFree(fobj);
   }
   return 0;
@@ -365,6 +368,7 @@ int32_t tsdbTFileObjRemoveUpdateLC(STFileObj *fobj) {
   tsdbTrace("remove unref file %s, fobj:%p ref %d", fobj->fname, fobj, nRef);
   if (nRef == 0) {
     tsdbTFileObjRemoveLC(fobj, false);
+    tsdbTombIndexDestroy(fobj->tombIndex);
     taosMemoryFree(fobj);
   }
   return 0;
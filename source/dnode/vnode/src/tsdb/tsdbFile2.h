@@ -24,6 +24,7 @@ extern "C" {
 
 typedef struct STFile    STFile;
 typedef struct STFileObj STFileObj;
+typedef struct STombIndex STombIndex;
 
 typedef enum {
   TSDB_FTYPE_HEAD = 0,                   // .head
@@ -56,6 +57,7 @@ int32_t tsdbTFileObjUnref(STFileObj *fobj);
 int32_t tsdbTFileObjRemove(STFileObj *fobj);
 int32_t tsdbTFileObjRemoveUpdateLC(STFileObj *fobj);
 int32_t tsdbTFileObjCmpr(const STFileObj **fobj1, const STFileObj **fobj2);
+void    tsdbTombIndexDestroy(STombIndex *index);
 
 struct STFile {
   tsdb_ftype_t type;
@@ -80,6 +82,7 @@ struct STFileObj {
   int32_t       ref;
   int32_t       nlevel;
   char          fname[TSDB_FILENAME_LEN];
+  STombIndex   *tombIndex;  // tomb records of a .tomb file, built on first read and shared by all readers
 };
 
 #ifdef __cplusplus
@@ -17,7 +17,8 @@
 #include "util/tsimplehash.h"
 
 #define MEM_MIN_HASH 1024
-#define SL_MAX_LEVEL 5
+// the skiplist of a table starts with the configured number of levels and grows up to SL_MAX_LEVEL as rows come
+#define SL_MAX_LEVEL 8
 
 // sizeof(SMemSkipListNode) + sizeof(SMemSkipListNode *) * (l) * 2
 #define SL_NODE_SIZE(l)               (sizeof(SMemSkipListNode) + ((l) << 4))
@@ -32,11 +33,12 @@
 #define SL_MOVE_FROM_POS 0x2
 
 static void    tbDataMovePosTo(STbData *pTbData, SMemSkipListNode **pos, STsdbRowKey *pKey, int32_t flags);
+static int32_t tbDataNodeSearchRow(SMemSkipListNode *pNode, STsdbRowKey *pKey, bool include);
 static int32_t tsdbGetOrCreateTbData(SMemTable *pMemTable, tb_uid_t suid, tb_uid_t uid, STbData **ppTbData);
 static int32_t tsdbInsertRowDataToTable(SMemTable *pMemTable, STbData *pTbData, int64_t version,
                                         SSubmitTbData *pSubmitTbData, int32_t *affectedRows);
-static int32_t tsdbInsertColDataToTable(SMemTable *pMemTable, STbData *pTbData, int64_t version,
-                                        SSubmitTbData *pSubmitTbData, int32_t *affectedRows);
+static int32_t tsdbInsertColDataToTable(SMemTable *pMemTable, STbData *pTbData, int64_t version, SColData *aColData,
+                                        int32_t nColData, int32_t *affectedRows);
 
 static int32_t tTbDataCmprFn(const SRBTreeNode *n1, const SRBTreeNode *n2) {
   STbData *tbData1 = TCONTAINER_OF(n1, STbData, rbtn);
@@ -134,7 +136,8 @@ int32_t tsdbInsertTableData(STsdb *pTsdb, int64_t version, SSubmitTbData *pSubmi
 
   // do insert impl
   if (pSubmitTbData->flags & SUBMIT_REQ_COLUMN_DATA_FORMAT) {
-    code = tsdbInsertColDataToTable(pMemTable, pTbData, version, pSubmitTbData, affectedRows);
+    code = tsdbInsertColDataToTable(pMemTable, pTbData, version, (SColData *)TARRAY_DATA(pSubmitTbData->aCol),
+                                    TARRAY_SIZE(pSubmitTbData->aCol), affectedRows);
   } else {
     code = tsdbInsertRowDataToTable(pMemTable, pTbData, version, pSubmitTbData, affectedRows);
   }
@@ -246,22 +249,37 @@ void tsdbTbDataIterOpen(STbData *pTbData, STsdbRowKey *pFrom, int8_t backward, S
   pTail = pTbData->sl.pTail;
   pIter->pTbData = pTbData;
   pIter->backward = backward;
+  pIter->iRow = 0;
   pIter->pRow = NULL;
   if (pFrom == NULL) {
     // create from head or tail
     if (backward) {
       pIter->pNode = SL_GET_NODE_BACKWARD(pTbData->sl.pTail, 0);
+      if (pIter->pNode != pHead) {
+        pIter->iRow = pIter->pNode->nRow - 1;
+      }
     } else {
       pIter->pNode = SL_GET_NODE_FORWARD(pTbData->sl.pHead, 0);
     }
   } else {
-    // create from a key
+    // create from a key, which may fall into the chunk before the position
     if (backward) {
       tbDataMovePosTo(pTbData, pos, pFrom, SL_MOVE_BACKWARD);
       pIter->pNode = SL_GET_NODE_BACKWARD(pos[0], 0);
+      if (pIter->pNode != pHead && pIter->pNode->nRow > 1) {
+        pIter->iRow = tbDataNodeSearchRow(pIter->pNode, pFrom, true) - 1;
+      }
     } else {
       tbDataMovePosTo(pTbData, pos, pFrom, 0);
-      pIter->pNode = SL_GET_NODE_FORWARD(pos[0], 0);
+      if (pos[0] != pHead && pos[0]->nRow > 1) {
+        pIter->iRow = tbDataNodeSearchRow(pos[0], pFrom, false);
+      }
+      if (pIter->iRow > 0 && pIter->iRow < pos[0]->nRow) {
+        pIter->pNode = pos[0];
+      } else {
+        pIter->iRow = 0;
+        pIter->pNode = SL_GET_NODE_FORWARD(pos[0], 0);
+      }
     }
   }
 }
@@ -273,16 +291,28 @@ bool tsdbTbDataIterNext(STbDataIter *pIter) {
       return false;
     }
 
+    if (pIter->iRow > 0) {
+      pIter->iRow--;
+      return true;
+    }
+
     pIter->pNode = SL_GET_NODE_BACKWARD(pIter->pNode, 0);
     if (pIter->pNode == pIter->pTbData->sl.pHead) {
       return false;
     }
+    pIter->iRow = pIter->pNode->nRow - 1;
   } else {
     if (pIter->pNode == pIter->pTbData->sl.pTail) {
       return false;
     }
 
+    if (pIter->iRow + 1 < pIter->pNode->nRow) {
+      pIter->iRow++;
+      return true;
+    }
+
     pIter->pNode = SL_GET_NODE_FORWARD(pIter->pNode, 0);
+    pIter->iRow = 0;
     if (pIter->pNode == pIter->pTbData->sl.pTail) {
       return false;
     }
@@ -301,7 +331,7 @@ int64_t tsdbCountTbDataRows(STbData *pTbData) {
       return rowsNum;
     }
 
-    rowsNum++;
+    rowsNum += pNode->nRow;
   }
 
   return rowsNum;
@@ -387,7 +417,7 @@ static int32_t tsdbGetOrCreateTbData(SMemTable *pMemTable, tb_uid_t suid, tb_uid
 
   // create
   SVBufPool *pPool = pMemTable->pTsdb->pVnode->inUse;
-  int8_t     maxLevel = pMemTable->pTsdb->pVnode->config.tsdbCfg.slLevel;
+  int8_t     maxLevel = SL_MAX_LEVEL;
 
   pTbData = vnodeBufPoolMallocAligned(pPool, sizeof(*pTbData) + SL_NODE_SIZE(maxLevel) * 2);
   if (pTbData == NULL) {
@@ -402,12 +432,14 @@ static int32_t tsdbGetOrCreateTbData(SMemTable *pMemTable, tb_uid_t suid, tb_uid
   pTbData->pTail = NULL;
   pTbData->sl.seed = taosRand();
   pTbData->sl.size = 0;
-  pTbData->sl.maxLevel = maxLevel;
+  pTbData->sl.maxLevel = TMAX(TMIN(pMemTable->pTsdb->pVnode->config.tsdbCfg.slLevel, maxLevel), 1);
   pTbData->sl.level = 0;
   pTbData->sl.pHead = (SMemSkipListNode *)&pTbData[1];
   pTbData->sl.pTail = (SMemSkipListNode *)POINTER_SHIFT(pTbData->sl.pHead, SL_NODE_SIZE(maxLevel));
   pTbData->sl.pHead->level = maxLevel;
   pTbData->sl.pTail->level = maxLevel;
+  pTbData->sl.pHead->nRow = 1;
+  pTbData->sl.pTail->nRow = 1;
   for (int8_t iLevel = 0; iLevel < maxLevel; iLevel++) {
     SL_NODE_FORWARD(pTbData->sl.pHead, iLevel) = pTbData->sl.pTail;
     SL_NODE_BACKWARD(pTbData->sl.pTail, iLevel) = pTbData->sl.pHead;
@@ -517,6 +549,48 @@ static void tbDataMovePosTo(STbData *pTbData, SMemSkipListNode **pos, STsdbRowKe
   }
 }
 
+static FORCE_INLINE void tbDataNodeGetKey(SMemSkipListNode *pNode, int32_t iRow, STsdbRowKey *pKey) {
+  TSDBROW row = pNode->row;
+  if (iRow) {
+    row.iRow += iRow;
+  }
+  tsdbRowGetKey(&row, pKey);
+}
+
+/**
+ * Return the number of rows in a chunk node whose key is less than (or equal to if include) the given key.
+ */
+static int32_t tbDataNodeSearchRow(SMemSkipListNode *pNode, STsdbRowKey *pKey, bool include) {
+  STsdbRowKey tKey;
+  int32_t     lidx = 0;
+  int32_t     ridx = pNode->nRow;
+
+  while (lidx < ridx) {
+    int32_t midx = (lidx + ridx) >> 1;
+
+    tbDataNodeGetKey(pNode, midx, &tKey);
+    int32_t c = tsdbRowKeyCmpr(&tKey, pKey);
+    if (c < 0 || (c == 0 && include)) {
+      lidx = midx + 1;
+    } else {
+      ridx = midx;
+    }
+  }
+
+  return lidx;
+}
+
+/**
+ * Let the skiplist grow one level each time it holds 4^maxLevel rows, which keeps the number of nodes on the top
+ * level small for tables receiving millions of rows. The head and tail are allocated with all the levels, and the
+ * level only changes before the positions of a batch are searched, so the pos arrays of the batch stay valid.
+ */
+static FORCE_INLINE void tsdbMemSkipListAdjustLevel(SMemSkipList *pSl) {
+  while (pSl->maxLevel < pSl->pHead->level && pSl->size >= (((int64_t)1) << (pSl->maxLevel << 1))) {
+    pSl->maxLevel++;
+  }
+}
+
 static FORCE_INLINE int8_t tsdbMemSkipListRandLevel(SMemSkipList *pSl) {
   int8_t level = 1;
   int8_t tlevel = TMIN(pSl->maxLevel, pSl->level + 1);
@@ -528,7 +602,7 @@ static FORCE_INLINE int8_t tsdbMemSkipListRandLevel(SMemSkipList *pSl) {
   return level;
 }
 static int32_t tbDataDoPut(SMemTable *pMemTable, STbData *pTbData, SMemSkipListNode **pos, TSDBROW *pRow,
-                           int8_t forward) {
+                           int32_t nRow, int8_t forward) {
   int32_t           code = 0;
   int8_t            level;
   SMemSkipListNode *pNode = NULL;
@@ -549,6 +623,7 @@ static int32_t tbDataDoPut(SMemTable *pMemTable, STbData *pTbData, SMemSkipListN
   }
 
   pNode->level = level;
+  pNode->nRow = nRow;
   pNode->row = *pRow;
   if (pRow->type == TSDBROW_ROW_FMT) {
     pNode->row.pTSRow = (SRow *)((char *)pNode + nSize);
@@ -589,7 +664,7 @@ static int32_t tbDataDoPut(SMemTable *pMemTable, STbData *pTbData, SMemSkipListN
     }
   }
 
-  pTbData->sl.size++;
+  pTbData->sl.size += nRow;
   if (pTbData->sl.level < pNode->level) {
     pTbData->sl.level = pNode->level;
   }
@@ -598,13 +673,148 @@ _exit:
   return code;
 }
 
-static int32_t tsdbInsertColDataToTable(SMemTable *pMemTable, STbData *pTbData, int64_t version,
-                                        SSubmitTbData *pSubmitTbData, int32_t *affectedRows) {
+/**
+ * A row to put after pNode falls into the chunk pNode holds, so replace the chunk with two nodes holding the rows
+ * before and after the key. The replaced node is left untouched for the iterators still on it.
+ */
+static int32_t tbDataSplitChunk(SMemTable *pMemTable, STbData *pTbData, SMemSkipListNode *pNode, STsdbRowKey *pKey,
+                                bool *split) {
+  int32_t           code = 0;
+  SVBufPool        *pPool = pMemTable->pTsdb->pVnode->inUse;
+  SMemSkipListNode *pNode1 = NULL;
+  SMemSkipListNode *pNode2 = NULL;
+  STsdbRowKey       tKey;
+  int32_t           iRow;
+  int8_t            level1, level2;
+
+  *split = false;
+  if (pNode == pTbData->sl.pHead || pNode->nRow <= 1) {
+    goto _exit;
+  }
+
+  tbDataNodeGetKey(pNode, pNode->nRow - 1, &tKey);
+  if (tsdbRowKeyCmpr(&tKey, pKey) <= 0) {
+    goto _exit;
+  }
+  iRow = tbDataNodeSearchRow(pNode, pKey, true);
+
+  level1 = pNode->level;
+  level2 = TMIN(tsdbMemSkipListRandLevel(&pTbData->sl), level1);
+  pNode1 = (SMemSkipListNode *)vnodeBufPoolMallocAligned(pPool, SL_NODE_SIZE(level1));
+  pNode2 = (SMemSkipListNode *)vnodeBufPoolMallocAligned(pPool, SL_NODE_SIZE(level2));
+  if (pNode1 == NULL || pNode2 == NULL) {
+    code = terrno;
+    goto _exit;
+  }
+
+  pNode1->level = level1;
+  pNode1->nRow = iRow;
+  pNode1->row = pNode->row;
+  pNode2->level = level2;
+  pNode2->nRow = pNode->nRow - iRow;
+  pNode2->row = pNode->row;
+  pNode2->row.iRow += iRow;
+  for (int8_t iLevel = 0; iLevel < level1; iLevel++) {
+    SL_NODE_BACKWARD(pNode1, iLevel) = SL_NODE_BACKWARD(pNode, iLevel);
+    if (iLevel < level2) {
+      SL_NODE_FORWARD(pNode1, iLevel) = pNode2;
+      SL_NODE_BACKWARD(pNode2, iLevel) = pNode1;
+      SL_NODE_FORWARD(pNode2, iLevel) = SL_NODE_FORWARD(pNode, iLevel);
+    } else {
+      SL_NODE_FORWARD(pNode1, iLevel) = SL_NODE_FORWARD(pNode, iLevel);
+    }
+  }
+
+  for (int8_t iLevel = level1 - 1; iLevel >= 0; iLevel--) {
+    SMemSkipListNode *pPrev = SL_NODE_BACKWARD(pNode, iLevel);
+    SMemSkipListNode *pNext = SL_NODE_FORWARD(pNode, iLevel);
+
+    SL_SET_NODE_BACKWARD(pNext, iLevel, iLevel < level2 ? pNode2 : pNode1);
+    SL_SET_NODE_FORWARD(pPrev, iLevel, pNode1);
+  }
+  *split = true;
+
+_exit:
+  return code;
+}
+
+static bool tbDataBlockInOrder(SBlockData *pBlockData) {
+  if (pBlockData->nColData == 0 || !(pBlockData->aColData[0].cflag & COL_IS_KEY)) {
+    for (int32_t iRow = 1; iRow < pBlockData->nRow; iRow++) {
+      if (pBlockData->aTSKEY[iRow - 1] >= pBlockData->aTSKEY[iRow]) {
+        return false;
+      }
+    }
+  } else {
+    STsdbRowKey key1, key2;
+    TSDBROW     row = tsdbRowFromBlockData(pBlockData, 0);
+
+    tsdbRowGetKey(&row, &key1);
+    for (row.iRow = 1; row.iRow < pBlockData->nRow; row.iRow++) {
+      tsdbRowGetKey(&row, &key2);
+      if (tsdbRowKeyCmpr(&key1, &key2) >= 0) {
+        return false;
+      }
+      key1 = key2;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * Most tables receive rows in order, so keep a block of strictly ascending rows, which does not interleave with
+ * the rows already in the table, as one chunk node instead of one node per row. It saves the position search and
+ * the node allocation of each row, and readers and commit walk the chunk through the table data iterator.
+ */
+static int32_t tbDataPutChunk(SMemTable *pMemTable, STbData *pTbData, SBlockData *pBlockData, bool *put) {
+  int32_t           code = 0;
+  SMemSkipListNode *pos[SL_MAX_LEVEL];
+  SMemSkipListNode *pPrev;
+  TSDBROW           row = tsdbRowFromBlockData(pBlockData, pBlockData->nRow - 1);
+  STsdbRowKey       fKey, lKey, tKey;
+
+  *put = false;
+  if (pBlockData->nRow <= 1 || !tbDataBlockInOrder(pBlockData)) {
+    goto _exit;
+  }
+
+  tsdbRowGetKey(&row, &lKey);
+  row.iRow = 0;
+  tsdbRowGetKey(&row, &fKey);
+  tbDataMovePosTo(pTbData, pos, &fKey, SL_MOVE_BACKWARD);
+
+  if (pos[0] != pTbData->sl.pTail) {
+    tbDataNodeGetKey(pos[0], 0, &tKey);
+    if (tsdbRowKeyCmpr(&tKey, &lKey) <= 0) {
+      goto _exit;
+    }
+  }
+
+  pPrev = SL_NODE_BACKWARD(pos[0], 0);
+  if (pPrev != pTbData->sl.pHead) {
+    tbDataNodeGetKey(pPrev, pPrev->nRow - 1, &tKey);
+    if (tsdbRowKeyCmpr(&tKey, &fKey) >= 0) {
+      goto _exit;
+    }
+  }
+
+  code = tbDataDoPut(pMemTable, pTbData, pos, &row, pBlockData->nRow, 0);
+  if (code) goto _exit;
+
+  *put = true;
+
+_exit:
+  return code;
+}
+
+static int32_t tsdbInsertColDataToTable(SMemTable *pMemTable, STbData *pTbData, int64_t version, SColData *aColData,
+                                        int32_t nColData, int32_t *affectedRows) {
   int32_t code = 0;
+  bool    put = false;
+  bool    split = false;
 
   SVBufPool *pPool = pMemTable->pTsdb->pVnode->inUse;
-  int32_t    nColData = TARRAY_SIZE(pSubmitTbData->aCol);
-  SColData  *aColData = (SColData *)TARRAY_DATA(pSubmitTbData->aCol);
 
   // copy and construct block data
   SBlockData *pBlockData = vnodeBufPoolMalloc(pPool, sizeof(*pBlockData));
@@ -645,34 +855,50 @@ static int32_t tsdbInsertColDataToTable(SMemTable *pMemTable, STbData *pTbData,
     if (code) goto _exit;
   }
 
-  // loop to add each row to the skiplist
   SMemSkipListNode *pos[SL_MAX_LEVEL];
   TSDBROW           tRow = tsdbRowFromBlockData(pBlockData, 0);
   STsdbRowKey       key;
 
-  // first row
-  tsdbRowGetKey(&tRow, &key);
-  tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_BACKWARD);
-  if ((code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 0))) goto _exit;
-  pTbData->minKey = TMIN(pTbData->minKey, key.key.ts);
-
-  // remain row
-  ++tRow.iRow;
-  if (tRow.iRow < pBlockData->nRow) {
-    for (int8_t iLevel = pos[0]->level; iLevel < pTbData->sl.maxLevel; iLevel++) {
-      pos[iLevel] = SL_NODE_BACKWARD(pos[iLevel], iLevel);
+  // put the block as one chunk if it is in order
+  tsdbMemSkipListAdjustLevel(&pTbData->sl);
+  if ((code = tbDataPutChunk(pMemTable, pTbData, pBlockData, &put))) goto _exit;
+  if (put) {
+    pTbData->minKey = TMIN(pTbData->minKey, pBlockData->aTSKEY[0]);
+    tRow.iRow = pBlockData->nRow - 1;
+    tsdbRowGetKey(&tRow, &key);
+  } else {
+    // loop to add each row to the skiplist, first row
+    tsdbRowGetKey(&tRow, &key);
+    tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_BACKWARD);
+    if ((code = tbDataSplitChunk(pMemTable, pTbData, SL_NODE_BACKWARD(pos[0], 0), &key, &split))) goto _exit;
+    if (split) {
+      tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_BACKWARD);
     }
+    if ((code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 1, 0))) goto _exit;
+    pTbData->minKey = TMIN(pTbData->minKey, key.key.ts);
+
+    // remain row
+    ++tRow.iRow;
+    if (tRow.iRow < pBlockData->nRow) {
+      for (int8_t iLevel = pos[0]->level; iLevel < pTbData->sl.maxLevel; iLevel++) {
+        pos[iLevel] = SL_NODE_BACKWARD(pos[iLevel], iLevel);
+      }
 
-    while (tRow.iRow < pBlockData->nRow) {
-      tsdbRowGetKey(&tRow, &key);
+      while (tRow.iRow < pBlockData->nRow) {
+        tsdbRowGetKey(&tRow, &key);
 
-      if (SL_NODE_FORWARD(pos[0], 0) != pTbData->sl.pTail) {
-        tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_FROM_POS);
-      }
+        if (SL_NODE_FORWARD(pos[0], 0) != pTbData->sl.pTail) {
+          tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_FROM_POS);
+        }
+        if ((code = tbDataSplitChunk(pMemTable, pTbData, pos[0], &key, &split))) goto _exit;
+        if (split) {
+          tbDataMovePosTo(pTbData, pos, &key, 0);
+        }
 
-      if ((code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 1))) goto _exit;
+        if ((code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 1, 1))) goto _exit;
 
-      ++tRow.iRow;
+        ++tRow.iRow;
+      }
     }
   }
 
@@ -698,22 +924,105 @@ _exit:
   return code;
 }
 
+/**
+ * Convert the rows of a row-format submit to columns, so they are kept in the memtable the same way as a
+ * column-format submit and queries and commit read them without decoding rows. *paColData is left NULL if the rows
+ * can not be converted, e.g. they are not of the current schema version.
+ */
+static int32_t tsdbRowDataToColData(STsdb *pTsdb, SSubmitTbData *pSubmitTbData, SColData **paColData,
+                                    int32_t *nColData) {
+  int32_t   code = 0;
+  int32_t   lino = 0;
+  int32_t   nRow = TARRAY_SIZE(pSubmitTbData->aRowP);
+  SRow    **aRow = (SRow **)TARRAY_DATA(pSubmitTbData->aRowP);
+  STSchema *pTSchema = NULL;
+  SColData *aColData = NULL;
+
+  *paColData = NULL;
+  *nColData = 0;
+
+  if (metaGetTbTSchemaEx(pTsdb->pVnode->pMeta, pSubmitTbData->suid, pSubmitTbData->uid, pSubmitTbData->sver,
+                         &pTSchema) != 0) {
+    goto _exit;
+  }
+
+  for (int32_t iRow = 0; iRow < nRow; iRow++) {
+    if (aRow[iRow]->sver != pTSchema->version) {
+      goto _exit;
+    }
+  }
+
+  aColData = (SColData *)taosMemoryCalloc(pTSchema->numOfCols, sizeof(SColData));
+  TSDB_CHECK_NULL(aColData, code, lino, _exit, terrno);
+
+  for (int32_t iCol = 0; iCol < pTSchema->numOfCols; iCol++) {
+    STColumn *pTColumn = &pTSchema->columns[iCol];
+    tColDataInit(&aColData[iCol], pTColumn->colId, pTColumn->type, pTColumn->flags);
+  }
+
+  for (int32_t iRow = 0; iRow < nRow; iRow++) {
+    code = tRowUpsertColData(aRow[iRow], pTSchema, aColData, pTSchema->numOfCols, 0 /* append */);
+    TSDB_CHECK_CODE(code, lino, _exit);
+  }
+
+  *paColData = aColData;
+  *nColData = pTSchema->numOfCols;
+  aColData = NULL;
+
+_exit:
+  if (code) {
+    tsdbError("vgId:%d %s failed at %s:%d since %s", TD_VID(pTsdb->pVnode), __func__, __FILE__, lino, tstrerror(code));
+  }
+  if (aColData) {
+    for (int32_t iCol = 0; iCol < pTSchema->numOfCols; iCol++) {
+      tColDataDestroy(&aColData[iCol]);
+    }
+    taosMemoryFree(aColData);
+  }
+  taosMemoryFree(pTSchema);
+  return code;
+}
+
 static int32_t tsdbInsertRowDataToTable(SMemTable *pMemTable, STbData *pTbData, int64_t version,
                                         SSubmitTbData *pSubmitTbData, int32_t *affectedRows) {
   int32_t code = 0;
 
+  if (tsTsdbMemColumnar && TARRAY_SIZE(pSubmitTbData->aRowP) > 1) {
+    SColData *aColData = NULL;
+    int32_t   nColData = 0;
+
+    code = tsdbRowDataToColData(pMemTable->pTsdb, pSubmitTbData, &aColData, &nColData);
+    if (code) return code;
+
+    if (aColData) {
+      code = tsdbInsertColDataToTable(pMemTable, pTbData, version, aColData, nColData, affectedRows);
+      for (int32_t iColData = 0; iColData < nColData; iColData++) {
+        tColDataDestroy(&aColData[iColData]);
+      }
+      taosMemoryFree(aColData);
+      return code;
+    }
+  }
+
   int32_t           nRow = TARRAY_SIZE(pSubmitTbData->aRowP);
   SRow            **aRow = (SRow **)TARRAY_DATA(pSubmitTbData->aRowP);
   STsdbRowKey       key;
   SMemSkipListNode *pos[SL_MAX_LEVEL];
   TSDBROW           tRow = {.type = TSDBROW_ROW_FMT, .version = version};
   int32_t           iRow = 0;
+  bool              split = false;
 
   // backward put first data
+  tsdbMemSkipListAdjustLevel(&pTbData->sl);
   tRow.pTSRow = aRow[iRow++];
   tsdbRowGetKey(&tRow, &key);
   tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_BACKWARD);
-  code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 0);
+  code = tbDataSplitChunk(pMemTable, pTbData, SL_NODE_BACKWARD(pos[0], 0), &key, &split);
+  if (code) goto _exit;
+  if (split) {
+    tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_BACKWARD);
+  }
+  code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 1, 0);
   if (code) goto _exit;
 
   pTbData->minKey = TMIN(pTbData->minKey, key.key.ts);
@@ -731,8 +1040,13 @@ static int32_t tsdbInsertRowDataToTable(SMemTable *pMemTable, STbData *pTbData,
       if (SL_NODE_FORWARD(pos[0], 0) != pTbData->sl.pTail) {
         tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_FROM_POS);
       }
+      code = tbDataSplitChunk(pMemTable, pTbData, pos[0], &key, &split);
+      if (code) goto _exit;
+      if (split) {
+        tbDataMovePosTo(pTbData, pos, &key, 0);
+      }
 
-      code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 1);
+      code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 1, 1);
       if (code) goto _exit;
 
       iRow++;
@@ -23,6 +23,7 @@ typedef struct {
   STFileSet *fset;
 
   int32_t sttTrigger;
+  int32_t mergeTrigger;  // level-0 files that start a merge, larger than sttTrigger on cold file sets
   int32_t maxRow;
   int32_t minRow;
   int32_t szPage;
@@ -442,7 +443,7 @@ static int32_t tsdbDoMerge(SMerger *merger) {
   if (TARRAY2_SIZE(merger->fset->lvlArr) == 0) return 0;
 
   SSttLvl *lvl = TARRAY2_FIRST(merger->fset->lvlArr);
-  if (lvl->level != 0 || TARRAY2_SIZE(lvl->fobjArr) < merger->sttTrigger) {
+  if (lvl->level != 0 || TARRAY2_SIZE(lvl->fobjArr) < merger->mergeTrigger) {
     return 0;
   }
 
@@ -513,6 +514,8 @@ int32_t tsdbMerge(void *arg) {
     return 0;
   }
 
+  merger->mergeTrigger = tsdbFSetSttTrigger(tsdb, merger->fset);
+
   // do merge
   tsdbInfo("vgId:%d merge begin, fid:%d", TD_VID(tsdb->pVnode), merger->fid);
   code = tsdbDoMerge(merger);
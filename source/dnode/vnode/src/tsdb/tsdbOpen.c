@@ -98,6 +98,7 @@ _exit:
               pTsdb->keepCfg.days, pTsdb->keepCfg.keep0, pTsdb->keepCfg.keep1, pTsdb->keepCfg.keep2,
               pTsdb->keepCfg.keepTimeOffset);
     *ppTsdb = pTsdb;
+    tsdbCacheStartWarmup(pTsdb);
   }
   return code;
 }
@@ -36,6 +36,8 @@
 
 #define outOfTimeWindow(_ts, _window) (((_ts) > (_window)->ekey) || ((_ts) < (_window)->skey))
 
+#define FILTER_PROBE_MIN_BLOCKS 16  // blocks probed before late materialization may be given up
+
 typedef struct {
   bool overlapWithNeighborBlock;
   bool hasDupTs;
@@ -309,6 +311,11 @@ _end:
 }
 
 // init file iterator
+static void closeNextFilesetReader(SFilesetIter* pIter) {
+  tsdbDataFileReaderClose(&pIter->pNextReader);
+  pIter->nextIndex = -1;
+}
+
 static int32_t initFilesetIterator(SFilesetIter* pIter, TFileSetArray* pFileSetArray, STsdbReader* pReader) {
   int32_t             code = TSDB_CODE_SUCCESS;
   int32_t             lino = 0;
@@ -329,6 +336,7 @@ static int32_t initFilesetIterator(SFilesetIter* pIter, TFileSetArray* pFileSetA
   pIter->order = pReader->info.order;
   pIter->pFilesetList = pFileSetArray;
   pIter->numOfFiles = numOfFileset;
+  closeNextFilesetReader(pIter);
 
   if (pIter->pSttBlockReader == NULL) {
     pIter->pSttBlockReader = taosMemoryCalloc(1, sizeof(struct SSttBlockReader));
@@ -361,6 +369,88 @@ _end:
   return code;
 }
 
+#define FILESET_PREFETCH_DATA_SIZE (8 * 1024 * 1024)
+
+static int32_t openFilesetReader(STsdbReader* pReader, STFileSet* pFileset, SDataFileReader** ppFileReader) {
+  STFileObj**           pFileObj = pFileset->farr;
+  SDataFileReaderConfig conf = {.tsdb = pReader->pTsdb, .szPage = pReader->pTsdb->pVnode->config.tsdbPageSize};
+  const char*           filesName[4] = {0};
+
+  if (pFileObj[0] != NULL) {
+    conf.files[0].file = *pFileObj[0]->f;
+    conf.files[0].exist = true;
+    filesName[0] = pFileObj[0]->fname;
+
+    conf.files[1].file = *pFileObj[1]->f;
+    conf.files[1].exist = true;
+    filesName[1] = pFileObj[1]->fname;
+
+    conf.files[2].file = *pFileObj[2]->f;
+    conf.files[2].exist = true;
+    filesName[2] = pFileObj[2]->fname;
+  }
+
+  if (pFileObj[3] != NULL) {
+    conf.files[3].exist = true;
+    conf.files[3].file = *pFileObj[3]->f;
+    filesName[3] = pFileObj[3]->fname;
+  }
+
+  int32_t code = tsdbDataFileReaderOpen(filesName, &conf, ppFileReader);
+  if (code == TSDB_CODE_SUCCESS) {
+    pReader->cost.headFileLoad += 1;
+  }
+  return code;
+}
+
+// File sets of different time ranges may be placed on different disks or tiers by tfs. When the next file set in the
+// access order lives on another disk than the current one, open its reader now and ask that disk for its head and
+// tomb files and the leading part of its data file, so its I/O overlaps with the scan of the current file set instead
+// of following it. The reader is kept and taken over by filesetIteratorNext once the scan moves on to that file set.
+static void prefetchNextFileset(SFilesetIter* pIter, STsdbReader* pReader) {
+  int32_t next = pIter->index + (ASCENDING_TRAVERSE(pIter->order) ? 1 : -1);
+
+  if (tsTsdbPrefetchBlocks <= 0 || next < 0 || next >= pIter->numOfFiles || pIter->nextIndex == next) {
+    return;
+  }
+
+  STFileSet*  pNext = pIter->pFilesetList->data[next];
+  STFileObj** pCurObj = pReader->status.pCurrentFileset->farr;
+  STFileObj** pNextObj = pNext->farr;
+  if (pNextObj[TSDB_FTYPE_HEAD] == NULL && pNextObj[TSDB_FTYPE_TOMB] == NULL) {
+    return;
+  }
+
+  STimeWindow win = {0};
+  tsdbFidKeyRange(pNext->fid, pReader->pTsdb->keepCfg.days, pReader->pTsdb->keepCfg.precision, &win.skey, &win.ekey);
+  if (win.skey > pReader->info.window.ekey || win.ekey < pReader->info.window.skey) {
+    return;
+  }
+
+  STFileObj* pCur = (pCurObj[TSDB_FTYPE_DATA] != NULL) ? pCurObj[TSDB_FTYPE_DATA] : pCurObj[TSDB_FTYPE_TOMB];
+  STFileObj* pNew = (pNextObj[TSDB_FTYPE_DATA] != NULL) ? pNextObj[TSDB_FTYPE_DATA] : pNextObj[TSDB_FTYPE_TOMB];
+  if (pCur != NULL && pCur->f->did.level == pNew->f->did.level && pCur->f->did.id == pNew->f->did.id) {
+    return;
+  }
+
+  tsdbDebug("%p read ahead next file set fid:%d on disk level:%d id:%d, %s", pReader, pNext->fid, pNew->f->did.level,
+            pNew->f->did.id, pReader->idStr);
+
+  closeNextFilesetReader(pIter);
+  int32_t code = openFilesetReader(pReader, pNext, &pIter->pNextReader);
+  if (code == TSDB_CODE_SUCCESS) {
+    pIter->nextIndex = next;
+    code = tsdbDataFileReadAheadFiles(pIter->pNextReader, FILESET_PREFETCH_DATA_SIZE);
+  }
+
+  // read-ahead is only a hint, the reader is opened again when the scan reaches the file set if it failed to open
+  if (code != TSDB_CODE_SUCCESS) {
+    tsdbDebug("%p failed to read ahead file set fid:%d, code:%s %s", pReader, pNext->fid, tstrerror(code),
+              pReader->idStr);
+  }
+  pReader->cost.filesetPrefetch += 1;
+}
+
 static int32_t filesetIteratorNext(SFilesetIter* pIter, STsdbReader* pReader, bool* hasNext) {
   int32_t           code = TSDB_CODE_SUCCESS;
   int32_t           lino = 0;
@@ -405,35 +495,15 @@ static int32_t filesetIteratorNext(SFilesetIter* pIter, STsdbReader* pReader, bo
     pReader->status.pCurrentFileset = pIter->pFilesetList->data[pIter->index];
 
     pFileObj = pReader->status.pCurrentFileset->farr;
-    if (pFileObj[0] != NULL || pFileObj[3] != NULL) {
-      SDataFileReaderConfig conf = {.tsdb = pReader->pTsdb, .szPage = pReader->pTsdb->pVnode->config.tsdbPageSize};
-
-      const char* filesName[4] = {0};
-
-      if (pFileObj[0] != NULL) {
-        conf.files[0].file = *pFileObj[0]->f;
-        conf.files[0].exist = true;
-        filesName[0] = pFileObj[0]->fname;
-
-        conf.files[1].file = *pFileObj[1]->f;
-        conf.files[1].exist = true;
-        filesName[1] = pFileObj[1]->fname;
-
-        conf.files[2].file = *pFileObj[2]->f;
-        conf.files[2].exist = true;
-        filesName[2] = pFileObj[2]->fname;
-      }
-
-      if (pFileObj[3] != NULL) {
-        conf.files[3].exist = true;
-        conf.files[3].file = *pFileObj[3]->f;
-        filesName[3] = pFileObj[3]->fname;
-      }
-
-      code = tsdbDataFileReaderOpen(filesName, &conf, &pReader->pFileReader);
+    if (pIter->pNextReader != NULL && pIter->nextIndex == pIter->index) {
+      // opened and read ahead while the previous file set was scanned
+      pReader->pFileReader = pIter->pNextReader;
+      pIter->pNextReader = NULL;
+      pIter->nextIndex = -1;
+    } else if (pFileObj[0] != NULL || pFileObj[3] != NULL) {
+      closeNextFilesetReader(pIter);
+      code = openFilesetReader(pReader, pReader->status.pCurrentFileset, &pReader->pFileReader);
       TSDB_CHECK_CODE(code, lino, _end);
-
-      pReader->cost.headFileLoad += 1;
     }
 
     int32_t fid = pReader->status.pCurrentFileset->fid;
@@ -459,6 +529,7 @@ static int32_t filesetIteratorNext(SFilesetIter* pIter, STsdbReader* pReader, bo
     tsdbDebug("%p file found fid:%d for qrange:%" PRId64 "-%" PRId64 ", %s", pReader, fid, pReader->info.window.skey,
               pReader->info.window.ekey, pReader->idStr);
 
+    prefetchNextFileset(pIter, pReader);
     *hasNext = true;
     break;
   }
@@ -482,6 +553,7 @@ int32_t resetDataBlockIterator(SDataBlockIter* pIter, int32_t order, bool needFr
 
   pIter->order = order;
   pIter->index = -1;
+  pIter->prefetchIndex = -1;
   pIter->numOfBlocks = 0;
 
   if (pIter->blockList == NULL) {
@@ -645,7 +717,7 @@ _end:
 }
 
 void tsdbReleaseDataBlock2(STsdbReader* pReader) {
-  if (pReader == NULL) return;
+  if (pReader == NULL || pReader->pPara != NULL) return;
 
   SReaderStatus* pStatus = &pReader->status;
   if (!pStatus->composedDataBlock) {
@@ -892,16 +964,19 @@ _end:
 
 static int32_t loadFileBlockBrinInfo(STsdbReader* pReader, SArray* pIndexList, SBlockNumber* pBlockNum,
                                      SArray* pTableScanInfoList) {
-  int32_t         code = TSDB_CODE_SUCCESS;
-  int32_t         lino = 0;
-  int64_t         st = 0;
-  bool            asc = false;
-  STimeWindow     w = {0};
-  SBrinRecordIter iter = {0};
-  int32_t         numOfTables = 0;
-  SBrinRecord*    pRecord = NULL;
-  int32_t         k = 0;
-  size_t          sizeInDisk = 0;
+  int32_t                 code = TSDB_CODE_SUCCESS;
+  int32_t                 lino = 0;
+  int64_t                 st = 0;
+  bool                    asc = false;
+  STimeWindow             w = {0};
+  SBrinRecordIter         iter = {0};
+  int32_t                 numOfTables = 0;
+  SBrinRecord*            pRecord = NULL;
+  int32_t                 k = 0;
+  size_t                  sizeInDisk = 0;
+  STFileObj*              pTombObj = NULL;
+  const STombIndex*       pTombIndex = NULL;
+  const TTombRecordArray* pTombRecords = NULL;
 
   TSDB_CHECK_NULL(pReader, code, lino, _end, TSDB_CODE_INVALID_PARA);
   TSDB_CHECK_NULL(pBlockNum, code, lino, _end, TSDB_CODE_INVALID_PARA);
@@ -916,6 +991,13 @@ static int32_t loadFileBlockBrinInfo(STsdbReader* pReader, SArray* pIndexList, S
   cleanupInfoForNextFileset(pReader->status.pTableMap);
   initBrinRecordIter(&iter, pReader->pFileReader, pIndexList);
 
+  pTombObj = pReader->status.pCurrentFileset->farr[TSDB_FTYPE_TOMB];
+  if (pTombObj != NULL) {
+    code = tsdbDataFileReadTombIndex(pReader->pFileReader, pTombObj, &pTombIndex);
+    TSDB_CHECK_CODE(code, lino, _end);
+    pTombRecords = tsdbTombIndexGetRecords(pTombIndex, pReader->info.verRange.maxVer);
+  }
+
   while (1) {
     code = getNextBrinRecord(&iter, &pRecord);
     TSDB_CHECK_CODE(code, lino, _end);
@@ -994,6 +1076,26 @@ static int32_t loadFileBlockBrinInfo(STsdbReader* pReader, SArray* pIndexList, S
       continue;
     }
 
+    // 3. delete check, skip the block if one tomb record newer than all of its rows covers its whole time range
+    if (pTombRecords != NULL &&
+        tsdbTombIndexCovered(pTombRecords, pRecord->suid, pRecord->uid, pRecord->firstKey.key.ts,
+                             pRecord->lastKey.key.ts, pRecord->maxVer, pReader->info.verRange.maxVer)) {
+      pReader->cost.tombSkipBlocks += 1;
+      continue;
+    }
+
+    // 4. point query check, skip the block if its bloom filter says that the timestamp is absent
+    if (pReader->info.window.skey == pReader->info.window.ekey) {
+      bool mayContain = true;
+      code = tsdbDataFileBlockMayContain(pReader->pFileReader, pRecord, &pReader->info.window.skey, sizeof(TSKEY),
+                                         &mayContain);
+      TSDB_CHECK_CODE(code, lino, _end);
+      if (!mayContain) {
+        pReader->cost.bloomFilterSkipBlocks += 1;
+        continue;
+      }
+    }
+
     if (pScanInfo->pBlockList == NULL) {
       pScanInfo->pBlockList = taosArrayInit(4, sizeof(SFileDataBlockInfo));
       TSDB_CHECK_NULL(pScanInfo->pBlockList, code, lino, _end, terrno);
@@ -1316,6 +1418,81 @@ _end:
   return code;
 }
 
+static FORCE_INLINE uint8_t reverseBitOrder(uint8_t v) {
+  v = ((v & 0xF0) >> 4) | ((v & 0x0F) << 4);
+  v = ((v & 0xCC) >> 2) | ((v & 0x33) << 2);
+  v = ((v & 0xAA) >> 1) | ((v & 0x55) << 1);
+  return v;
+}
+
+// The one-bit bitmap of SColData sets the bit of a valued row, from the lowest bit of each byte, while the null bitmap
+// of SColumnInfoData sets the bit of a null row, from the highest bit. Translate the whole bytes starting from startRow,
+// which must be 8-aligned, and return the number of rows translated.
+static int32_t copyValueBitmap(const SColData* pData, int32_t startRow, SColumnInfoData* pColData, int32_t numOfRows) {
+  const uint8_t* pSrc = pData->pBitMap + (startRow >> 3);
+  uint8_t*       pDst = (uint8_t*)pColData->nullbitmap;
+  int32_t        numOfBytes = numOfRows >> 3;
+  uint8_t        hasNull = 0;
+
+  for (int32_t i = 0; i < numOfBytes; ++i) {
+    pDst[i] = reverseBitOrder(~pSrc[i]);
+    hasNull |= pDst[i];
+  }
+
+  if (hasNull) {
+    pColData->hasNull = true;
+  }
+  return numOfBytes << 3;
+}
+
+// Copy the values of a varchar/nchar/varbinary/geometry column in ascending order. The values of SColData are stored
+// consecutively without header, so the output buffer is reserved once, and the values are copied without building a
+// SColVal for each row.
+static int32_t copyVarCols(const SColData* pData, SFileBlockDumpInfo* pDumpInfo, SColumnInfoData* pColData,
+                           int32_t dumpedRows) {
+  int32_t code = TSDB_CODE_SUCCESS;
+  int32_t lino = 0;
+  int32_t start = pDumpInfo->rowIndex;
+  int32_t end = start + dumpedRows;
+  int32_t dataStart = pData->aOffset[start];
+  int32_t dataEnd = (end < pData->nVal) ? pData->aOffset[end] : pData->nData;
+
+  code = colDataReserve(pColData, pColData->varmeta.length + (dataEnd - dataStart) + VARSTR_HEADER_SIZE * dumpedRows);
+  TSDB_CHECK_CODE(code, lino, _end);
+
+  for (int32_t j = start, rowIndex = 0; j < end; ++j, ++rowIndex) {
+    if (pData->flag != HAS_VALUE && tColDataGetBitValue(pData, j) != 2) {
+      pColData->varmeta.offset[rowIndex] = -1;
+      pColData->hasNull = true;
+      continue;
+    }
+
+    int32_t offset = pData->aOffset[j];
+    int32_t nData = ((j + 1 < pData->nVal) ? pData->aOffset[j + 1] : pData->nData) - offset;
+    if (nData + VARSTR_HEADER_SIZE > pColData->info.bytes) {
+      tsdbWarn("column cid:%d actual data len %d is bigger than schema len %d", pData->cid, nData,
+               pColData->info.bytes);
+      code = TSDB_CODE_TDB_INVALID_TABLE_SCHEMA_VER;
+      TSDB_CHECK_CODE(code, lino, _end);
+    }
+
+    char* p = pColData->pData + pColData->varmeta.length;
+    varDataSetLen(p, nData);
+    if (nData > 0) {
+      (void)memcpy(varDataVal(p), pData->pData + offset, nData);
+    }
+
+    pColData->varmeta.offset[rowIndex] = pColData->varmeta.length;
+    pColData->varmeta.length += nData + VARSTR_HEADER_SIZE;
+  }
+
+_end:
+  if (code != TSDB_CODE_SUCCESS) {
+    tsdbError("%s failed at line %d since %s", __func__, lino, tstrerror(code));
+  }
+  return code;
+}
+
 // a faster version of copy procedure.
 static int32_t copyNumericCols(const SColData* pData, SFileBlockDumpInfo* pDumpInfo, SColumnInfoData* pColData,
                                int32_t dumpedRows, bool asc) {
@@ -1399,11 +1576,16 @@ static int32_t copyNumericCols(const SColData* pData, SFileBlockDumpInfo* pDumpI
     }
   }
 
-  // 3. if the  null value exists, check items one-by-one
+  // 3. if the  null value exists, translate the one-bit bitmap byte by byte if possible, and check the rest one-by-one
   if (pData->flag != HAS_VALUE) {
     int32_t rowIndex = 0;
 
-    for (int32_t j = pDumpInfo->rowIndex; rowIndex < dumpedRows; j += step, rowIndex++) {
+    if (asc && (pData->flag == (HAS_VALUE | HAS_NULL) || pData->flag == (HAS_VALUE | HAS_NONE)) &&
+        (pDumpInfo->rowIndex & 0x7) == 0) {
+      rowIndex = copyValueBitmap(pData, pDumpInfo->rowIndex, pColData, dumpedRows);
+    }
+
+    for (int32_t j = pDumpInfo->rowIndex + step * rowIndex; rowIndex < dumpedRows; j += step, rowIndex++) {
       uint8_t v = tColDataGetBitValue(pData, j);
       if (v == 0 || v == 1) {
         colDataSetNull_f(pColData->nullbitmap, rowIndex);
@@ -1602,6 +1784,9 @@ static int32_t copyBlockDataToSDataBlock(STsdbReader* pReader, SRowKey* pLastPro
         if (IS_MATHABLE_TYPE(pColData->info.type)) {
           code = copyNumericCols(pData, pDumpInfo, pColData, dumpedRows, asc);
           TSDB_CHECK_CODE(code, lino, _end);
+        } else if (asc && IS_VAR_DATA_TYPE(pColData->info.type) && pColData->info.type != TSDB_DATA_TYPE_JSON) {
+          code = copyVarCols(pData, pDumpInfo, pColData, dumpedRows);
+          TSDB_CHECK_CODE(code, lino, _end);
         } else {  // varchar/nchar type
           for (int32_t j = pDumpInfo->rowIndex; rowIndex < dumpedRows; j += step) {
             code = tColDataGetValue(pData, j, &cv);
@@ -1693,8 +1878,58 @@ _end:
   return pReader->info.pSchema;
 }
 
-static int32_t doLoadFileBlockData(STsdbReader* pReader, SDataBlockIter* pBlockIter, SBlockData* pBlockData,
-                                   uint64_t uid) {
+// Issue read-ahead for the data and SMA of the next blocks in the access order, so that the kernel fetches them
+// from disk while the current block is decompressed and merged. Read-ahead is only a hint, failures are ignored.
+static void prefetchFileBlocks(STsdbReader* pReader, SDataBlockIter* pBlockIter) {
+  int32_t     numOfPrefetch = tsTsdbPrefetchBlocks;
+  bool        asc = ASCENDING_TRAVERSE(pBlockIter->order);
+  int32_t     step = asc ? 1 : -1;
+  int32_t     last = 0;
+  int32_t     numOfBlocks = 0;
+  SBrinRecord record;
+
+  if (numOfPrefetch <= 0 || pReader->pFileReader == NULL || pBlockIter->blockList == NULL) {
+    return;
+  }
+
+  numOfBlocks = (int32_t)taosArrayGetSize(pBlockIter->blockList);
+  if (pBlockIter->index < 0 || pBlockIter->index >= numOfBlocks) {
+    return;
+  }
+
+  // -1 or a position behind the current block means no read-ahead has been issued ahead of it yet
+  if (asc) {
+    last = TMIN(pBlockIter->index + numOfPrefetch, numOfBlocks - 1);
+    pBlockIter->prefetchIndex = TMAX(pBlockIter->prefetchIndex, pBlockIter->index);
+  } else {
+    last = TMAX(pBlockIter->index - numOfPrefetch, 0);
+    if (pBlockIter->prefetchIndex < 0 || pBlockIter->prefetchIndex > pBlockIter->index) {
+      pBlockIter->prefetchIndex = pBlockIter->index;
+    }
+  }
+
+  while (asc ? (pBlockIter->prefetchIndex < last) : (pBlockIter->prefetchIndex > last)) {
+    pBlockIter->prefetchIndex += step;
+
+    SFileDataBlockInfo* pBlockInfo = taosArrayGet(pBlockIter->blockList, pBlockIter->prefetchIndex);
+    if (pBlockInfo == NULL) {
+      break;
+    }
+
+    blockInfoToRecord(&record, pBlockInfo, &pReader->suppInfo);
+    int32_t code = tsdbDataFileReadAheadBlock(pReader->pFileReader, &record);
+    if (code != TSDB_CODE_SUCCESS) {
+      tsdbDebug("%p failed to read ahead block, global index:%d, code:%s %s", pReader, pBlockIter->prefetchIndex,
+                tstrerror(code), pReader->idStr);
+      break;
+    }
+
+    pReader->cost.prefetchBlocks += 1;
+  }
+}
+
+static int32_t doLoadFileBlockColumns(STsdbReader* pReader, SDataBlockIter* pBlockIter, SBlockData* pBlockData,
+                                      uint64_t uid, int16_t* pColId, int32_t numOfCols) {
   int32_t             code = TSDB_CODE_SUCCESS;
   int32_t             lino = 0;
   STSchema*           pSchema = NULL;
@@ -1728,10 +1963,11 @@ static int32_t doLoadFileBlockData(STsdbReader* pReader, SDataBlockIter* pBlockI
 
   pDumpInfo = &pReader->status.fBlockDumpInfo;
 
+  prefetchFileBlocks(pReader, pBlockIter);
+
   blockInfoToRecord(&tmp, pBlockInfo, pSup);
   pRecord = &tmp;
-  code = tsdbDataFileReadBlockDataByColumn(pReader->pFileReader, pRecord, pBlockData, pSchema, &pSup->colId[1],
-                                           pSup->numOfCols - 1);
+  code = tsdbDataFileReadBlockDataByColumn(pReader->pFileReader, pRecord, pBlockData, pSchema, pColId, numOfCols);
   if (code != TSDB_CODE_SUCCESS) {
     tsdbError("%p error occurs in loading file block, global index:%d, table index:%d, brange:%" PRId64 "-%" PRId64
               ", rows:%d, code:%s %s",
@@ -1757,6 +1993,12 @@ _end:
   return code;
 }
 
+static int32_t doLoadFileBlockData(STsdbReader* pReader, SDataBlockIter* pBlockIter, SBlockData* pBlockData,
+                                   uint64_t uid) {
+  SBlockLoadSuppInfo* pSup = &pReader->suppInfo;
+  return doLoadFileBlockColumns(pReader, pBlockIter, pBlockData, uid, &pSup->colId[1], pSup->numOfCols - 1);
+}
+
 /**
  * This is an two rectangles overlap cases.
  */
@@ -3905,6 +4147,45 @@ static bool notOverlapWithFiles(SFileDataBlockInfo* pBlockInfo, STableBlockScanI
   }
 }
 
+// Drop the clean file block if its zone map shows that none of its rows can satisfy the filter of the query. Only
+// clean blocks are checked here: rows of the other blocks are merged with rows in stt files and buffer, and the merged
+// result can not be judged by the min/max values of the file block alone.
+static int32_t filterCleanBlockByZoneMap(STsdbReader* pReader, SFileDataBlockInfo* pBlockInfo) {
+  int32_t             code = TSDB_CODE_SUCCESS;
+  int32_t             lino = 0;
+  SBlockLoadSuppInfo* pSup = &pReader->suppInfo;
+  bool                keep = true;
+
+  if (pReader->pBlockFilter == NULL || pReader->pFileReader == NULL) {
+    return code;
+  }
+
+  code = tsdbDataFileReadBlockZone(pReader->pFileReader, pBlockInfo->blockOffset, &pSup->colAggArray);
+  TSDB_CHECK_CODE(code, lino, _end);
+
+  if (TARRAY2_SIZE(&pSup->colAggArray) == 0) {
+    goto _end;
+  }
+
+  code = filterRangeExecute(pReader->pBlockFilter, TARRAY2_DATA(&pSup->colAggArray), TARRAY2_SIZE(&pSup->colAggArray),
+                            pBlockInfo->numRow, &keep);
+  TSDB_CHECK_CODE(code, lino, _end);
+
+  if (!keep) {
+    // the block has been marked as dumped, and the last key of the table has been updated, return an empty block
+    pReader->resBlockInfo.pResBlock->info.rows = 0;
+    pReader->cost.zoneSkipBlocks += 1;
+    tsdbDebug("%p uid:%" PRIu64 " file block skipped by zone map, rows:%d, brange:%" PRId64 "-%" PRId64 ", %s", pReader,
+              pBlockInfo->uid, pBlockInfo->numRow, pBlockInfo->firstKey, pBlockInfo->lastKey, pReader->idStr);
+  }
+
+_end:
+  if (code != TSDB_CODE_SUCCESS) {
+    tsdbError("%s failed at line %d since %s", __func__, lino, tstrerror(code));
+  }
+  return code;
+}
+
 static int32_t doBuildDataBlock(STsdbReader* pReader) {
   int32_t              code = TSDB_CODE_SUCCESS;
   int32_t              lino = 0;
@@ -3971,6 +4252,9 @@ static int32_t doBuildDataBlock(STsdbReader* pReader) {
         // data block, so the overlap check is invalid actually.
         code = buildCleanBlockFromDataFiles(pReader, pScanInfo, pBlockInfo, pBlockIter->index);
         TSDB_CHECK_CODE(code, lino, _end);
+
+        code = filterCleanBlockByZoneMap(pReader, pBlockInfo);
+        TSDB_CHECK_CODE(code, lino, _end);
       } else {  // clean stt block
         TSDB_CHECK_CONDITION((pReader->info.execMode == READER_EXEC_ROWS) && (pSttBlockReader->mergeTree.pIter == NULL),
                              code, lino, _end, TSDB_CODE_INTERNAL_ERROR);
@@ -5400,6 +5684,11 @@ int32_t tsdbSetTableList2(STsdbReader* pReader, const void* pTableList, int32_t
   TSDB_CHECK_CODE(code, lino, _end);
   acquired = true;
 
+  if (pReader->pPara != NULL) {
+    code = tsdbReaderParaSetTableList(pReader, pTableList, num);
+    TSDB_CHECK_CODE(code, lino, _end);
+  }
+
   while ((p = tSimpleHashIterate(pReader->status.pTableMap, p, &iter)) != NULL) {
     clearBlockScanInfo(*p);
   }
@@ -5622,6 +5911,16 @@ int32_t tsdbReaderOpen2(void* pVnode, SQueryTableDataCond* pCond, void* pTableLi
             pReader, numOfTables, pReader->info.window.skey, pReader->info.window.ekey, pReader->info.verRange.minVer,
             pReader->info.verRange.maxVer, pReader->idStr);
 
+  // partition the table list across parallel workers, if the caller does not care about the order among tables
+  if (pCond->parallelScan && pCond->type == TIMEWINDOW_RANGE_CONTAINED && !pCond->notLoadData && pResBlock != NULL &&
+      pReader->suppInfo.numOfPks == 0 && tsTsdbParallelScanThreads > 1) {
+    int32_t numOfWorkers = TMIN(tsTsdbParallelScanThreads, numOfTables / tsTsdbParallelScanMinTables);
+    if (numOfWorkers > 1) {
+      code = tsdbReaderParaOpen(pReader, pCond, pTableList, numOfTables, numOfWorkers);
+      TSDB_CHECK_CODE(code, lino, _end);
+    }
+  }
+
 _end:
   if (code != TSDB_CODE_SUCCESS) {
     tsdbError("%s failed at line %d since %s, %s", __func__, lino, tstrerror(code), idstr);
@@ -5641,6 +5940,8 @@ void tsdbReaderClose2(STsdbReader* pReader) {
     return;
   }
 
+  tsdbReaderParaClose(&pReader->pPara);
+
   {
     if (pReader->innerReader[0] != NULL || pReader->innerReader[1] != NULL) {
       STsdbReader* p = pReader->innerReader[0];
@@ -5671,6 +5972,7 @@ void tsdbReaderClose2(STsdbReader* pReader) {
   }
 
   taosMemoryFree(pSupInfo->colId);
+  taosMemoryFree(pReader->filterColId);
   tBlockDataDestroy(&pReader->status.fileBlockData);
   cleanupDataBlockIterator(&pReader->status.blockIter, shouldFreePkBuf(&pReader->suppInfo));
 
@@ -5686,6 +5988,7 @@ void tsdbReaderClose2(STsdbReader* pReader) {
 
   SReadCostSummary* pCost = &pReader->cost;
   SFilesetIter*     pFilesetIter = &pReader->status.fileIter;
+  closeNextFilesetReader(pFilesetIter);
   if (pFilesetIter->pSttBlockReader != NULL) {
     SSttBlockReader* pSttBlockReader = pFilesetIter->pSttBlockReader;
     tMergeTreeClose(&pSttBlockReader->mergeTree);
@@ -5716,12 +6019,16 @@ void tsdbReaderClose2(STsdbReader* pReader) {
       "build in-memory-block-time:%.2f ms, sttBlocks:%" PRId64 ", sttBlocks-time:%.2f ms, sttStatisBlock:%" PRId64
       ", stt-statis-Block-time:%.2f ms, composed-blocks:%" PRId64
       ", composed-blocks-time:%.2fms, STableBlockScanInfo size:%.2f Kb, createTime:%.2f ms,createSkylineIterTime:%.2f "
-      "ms, initSttBlockReader:%.2fms, %s",
+      "ms, initSttBlockReader:%.2fms, bloom-filter-skip-blocks:%" PRId64 ", tomb-skip-blocks:%" PRId64
+      ", zone-skip-blocks:%" PRId64 ", filter-probe-blocks:%" PRId64 ", filter-skip-blocks:%" PRId64
+      ", prefetch-blocks:%" PRId64 ", fileset-prefetch:%" PRId64 ", %s",
       pReader, pCost->headFileLoad, pCost->headFileLoadTime, pCost->smaDataLoad, pCost->smaLoadTime, pCost->numOfBlocks,
       pCost->blockLoadTime, pCost->buildmemBlock, pCost->sttCost.loadBlocks, pCost->sttCost.blockElapsedTime,
       pCost->sttCost.loadStatisBlocks, pCost->sttCost.statisElapsedTime, pCost->composedBlocks,
       pCost->buildComposedBlockTime, numOfTables * sizeof(STableBlockScanInfo) / 1000.0, pCost->createScanInfoList,
-      pCost->createSkylineIterTime, pCost->initSttBlockReader, pReader->idStr);
+      pCost->createSkylineIterTime, pCost->initSttBlockReader, pCost->bloomFilterSkipBlocks, pCost->tombSkipBlocks,
+      pCost->zoneSkipBlocks, pCost->filterProbeBlocks, pCost->filterSkipBlocks, pCost->prefetchBlocks,
+      pCost->filesetPrefetch, pReader->idStr);
 
   taosMemoryFree(pReader->idStr);
 
@@ -5744,6 +6051,7 @@ static int32_t doSuspendCurrentReader(STsdbReader* pCurrentReader) {
 
   if (pStatus->loadFromFile) {
     tsdbDataFileReaderClose(&pCurrentReader->pFileReader);
+    closeNextFilesetReader(&pStatus->fileIter);
 
     SReadCostSummary* pCost = &pCurrentReader->cost;
     destroySttBlockReader(pStatus->pLDataIterArray, &pCost->sttCost);
@@ -5771,6 +6079,48 @@ _end:
   return code;
 }
 
+// Let the worker reader of a parallel scan read the snapshot taken by the owner reader, which holds the references of
+// the snapshot and is the one to be notified to release it.
+int32_t tsdbReaderAttachSnap(STsdbReader* pReader, STsdbReadSnap* pSnap) {
+  int32_t code = TSDB_CODE_SUCCESS;
+  int32_t lino = 0;
+
+  code = tsdbAcquireReader(pReader);
+  TSDB_CHECK_CODE(code, lino, _end);
+
+  pReader->pReadSnap = pSnap;
+  pReader->flag = READER_STATUS_NORMAL;
+  if (tSimpleHashGetSize(pReader->status.pTableMap) > 0) {
+    code = doOpenReaderImpl(pReader);
+  }
+
+  (void)tsdbReleaseReader(pReader);
+  TSDB_CHECK_CODE(code, lino, _end);
+
+_end:
+  if (code != TSDB_CODE_SUCCESS) {
+    tsdbError("%s failed at line %d since %s", __func__, lino, tstrerror(code));
+  }
+  return code;
+}
+
+void tsdbReaderDetachSnap(STsdbReader* pReader) {
+  if (tsdbAcquireReader(pReader) != TSDB_CODE_SUCCESS) {
+    return;
+  }
+
+  if (pReader->flag == READER_STATUS_NORMAL) {
+    int32_t code = doSuspendCurrentReader(pReader);
+    if (code != TSDB_CODE_SUCCESS) {
+      tsdbError("%p failed to suspend worker reader since %s, %s", pReader, tstrerror(code), pReader->idStr);
+    }
+  }
+
+  pReader->pReadSnap = NULL;
+  pReader->flag = READER_STATUS_SUSPEND;
+  (void)tsdbReleaseReader(pReader);
+}
+
 int32_t tsdbReaderSuspend2(STsdbReader* pReader) {
   int32_t code = TSDB_CODE_SUCCESS;
   int32_t lino = 0;
@@ -5780,6 +6130,11 @@ int32_t tsdbReaderSuspend2(STsdbReader* pReader) {
   // save reader's base state & reset top state to be reconstructed from base state
   pReader->status.suspendInvoked = true;  // record the suspend status
 
+  // the worker readers scan on the snapshot of this reader
+  if (pReader->pPara != NULL) {
+    tsdbReaderParaSuspend(pReader);
+  }
+
   if (pReader->type == TIMEWINDOW_RANGE_EXTERNAL) {
     if (pReader->step == EXTERNAL_ROWS_PREV) {
       code = doSuspendCurrentReader(pReader->innerReader[0]);
@@ -5866,7 +6221,10 @@ int32_t tsdbReaderResume2(STsdbReader* pReader) {
     // So we need to set it A.S.A.P
     pReader->flag = READER_STATUS_NORMAL;
 
-    if (pReader->type == TIMEWINDOW_RANGE_CONTAINED) {
+    if (pReader->pPara != NULL) {
+      code = tsdbReaderParaResume(pReader);
+      TSDB_CHECK_CODE(code, lino, _end);
+    } else if (pReader->type == TIMEWINDOW_RANGE_CONTAINED) {
       code = doOpenReaderImpl(pReader);
       TSDB_CHECK_CODE(code, lino, _end);
     } else {
@@ -6090,6 +6448,21 @@ int32_t tsdbNextDataBlock2(STsdbReader* pReader, bool* hasNext) {
     goto _end;
   }
 
+  if (pReader->pPara != NULL) {
+    code = tsdbAcquireReader(pReader);
+    TSDB_CHECK_CODE(code, lino, _end);
+    acquired = true;
+
+    if (pReader->flag == READER_STATUS_SUSPEND) {
+      code = tsdbReaderResume2(pReader);
+      TSDB_CHECK_CODE(code, lino, _end);
+    }
+
+    code = tsdbReaderParaNext(pReader, hasNext);
+    TSDB_CHECK_CODE(code, lino, _end);
+    goto _end;
+  }
+
   pStatus = &pReader->status;
 
   // NOTE: the following codes is used to perform test for suspend/resume for tsdbReader when it blocks the commit
@@ -6272,8 +6645,8 @@ int32_t tsdbRetrieveDatablockSMA2(STsdbReader* pReader, SSDataBlock* pDataBlock,
     goto _end;
   }
 
-  // there is no statistics data for composed block
-  if (pReader->status.composedDataBlock || (!pReader->suppInfo.smaValid)) {
+  // there is no statistics data for composed block, nor for the block copied from parallel workers
+  if (pReader->status.composedDataBlock || (!pReader->suppInfo.smaValid) || pReader->pPara != NULL) {
     goto _end;
   }
 
@@ -6290,6 +6663,8 @@ int32_t tsdbRetrieveDatablockSMA2(STsdbReader* pReader, SSDataBlock* pDataBlock,
   //  int64_t st = taosGetTimestampUs();
   TARRAY2_CLEAR(&pSup->colAggArray, 0);
 
+  prefetchFileBlocks(pReader, &pReader->status.blockIter);
+
   SBrinRecord pRecord;
   blockInfoToRecord(&pRecord, pBlockInfo, pSup);
   code = tsdbDataFileReadBlockSma(pReader->pFileReader, &pRecord, &pSup->colAggArray);
@@ -6363,6 +6738,75 @@ _end:
   return code;
 }
 
+// Late materialization of a clean file block: only the columns referred by the filter are decoded and the filter is
+// evaluated on them. If no row qualifies, the block is dropped without decoding the other columns. Otherwise, the
+// dump position is restored and the caller loads the whole block as usual.
+static int32_t doProbeFileBlockByFilter(STsdbReader* pReader, STableBlockScanInfo* pScanInfo, bool* qualified) {
+  int32_t            code = TSDB_CODE_SUCCESS;
+  int32_t            lino = 0;
+  SReaderStatus*     pStatus = &pReader->status;
+  SSDataBlock*       pResBlock = pReader->resBlockInfo.pResBlock;
+  SFileBlockDumpInfo dumpInfo = pStatus->fBlockDumpInfo;
+  SRowKey            lastProcKey = pScanInfo->lastProcKey;  // no primary key column, a shallow copy is enough
+  SColumnInfoData*   p = NULL;
+  int32_t            status = 0;
+
+  *qualified = true;
+  pReader->cost.filterProbeBlocks += 1;
+
+  code = doLoadFileBlockColumns(pReader, &pStatus->blockIter, &pStatus->fileBlockData, pScanInfo->uid,
+                                pReader->filterColId, pReader->numOfFilterCols);
+  TSDB_CHECK_CODE(code, lino, _end);
+
+  code = copyBlockDataToSDataBlock(pReader, &pScanInfo->lastProcKey);
+  TSDB_CHECK_CODE(code, lino, _end);
+
+  // no rows in the query time window, the same as loading the whole block
+  if (pResBlock->info.rows == 0) {
+    *qualified = false;
+    goto _end;
+  }
+
+  // the rest rows of a partially dumped block are read from the loaded block data later, all columns are required
+  if (pStatus->fBlockDumpInfo.allDumped) {
+    SFilterColumnParam param = {.numOfCols = taosArrayGetSize(pResBlock->pDataBlock),
+                                .pDataBlock = pResBlock->pDataBlock};
+    code = filterSetDataFromSlotId(pReader->pBlockFilter, &param);
+    TSDB_CHECK_CODE(code, lino, _end);
+
+    code = filterExecute(pReader->pBlockFilter, pResBlock, &p, NULL, param.numOfCols, &status);
+    TSDB_CHECK_CODE(code, lino, _end);
+
+    if (status == FILTER_RESULT_NONE_QUALIFIED) {
+      tsdbDebug("%p uid:%" PRIu64 " file block skipped by filter on %d columns, rows:%" PRId64 ", %s", pReader,
+                pScanInfo->uid, pReader->numOfFilterCols, pResBlock->info.rows, pReader->idStr);
+      pResBlock->info.rows = 0;
+      pReader->cost.filterSkipBlocks += 1;
+      *qualified = false;
+      goto _end;
+    }
+  }
+
+  pStatus->fBlockDumpInfo = dumpInfo;
+  pScanInfo->lastProcKey = lastProcKey;
+
+  // the filter columns are decoded twice for qualified blocks, give up if the filter rarely drops a whole block
+  if (pReader->cost.filterProbeBlocks >= FILTER_PROBE_MIN_BLOCKS &&
+      pReader->cost.filterSkipBlocks * 4 < pReader->cost.filterProbeBlocks) {
+    tsdbDebug("%p late materialization disabled, probe blocks:%" PRId64 ", skip blocks:%" PRId64 ", %s", pReader,
+              pReader->cost.filterProbeBlocks, pReader->cost.filterSkipBlocks, pReader->idStr);
+    pReader->numOfFilterCols = 0;
+  }
+
+_end:
+  if (code != TSDB_CODE_SUCCESS) {
+    tsdbError("%s failed at line %d since %s", __func__, lino, tstrerror(code));
+  }
+  colDataDestroy(p);
+  taosMemoryFree(p);
+  return code;
+}
+
 static int32_t doRetrieveDataBlock(STsdbReader* pReader, SSDataBlock** pBlock) {
   int32_t              code = TSDB_CODE_SUCCESS;
   int32_t              lino = 0;
@@ -6387,6 +6831,17 @@ static int32_t doRetrieveDataBlock(STsdbReader* pReader, SSDataBlock** pBlock) {
   TSDB_CHECK_CODE(code, lino, _end);
 
   reset = true;
+  if (pReader->numOfFilterCols > 0) {
+    bool qualified = true;
+    code = doProbeFileBlockByFilter(pReader, pBlockScanInfo, &qualified);
+    TSDB_CHECK_CODE(code, lino, _end);
+
+    if (!qualified) {
+      *pBlock = pReader->resBlockInfo.pResBlock;
+      goto _end;
+    }
+  }
+
   code = doLoadFileBlockData(pReader, &pStatus->blockIter, &pStatus->fileBlockData, pBlockScanInfo->uid);
   TSDB_CHECK_CODE(code, lino, _end);
 
@@ -6425,7 +6880,7 @@ int32_t tsdbRetrieveDataBlock2(STsdbReader* pReader, SSDataBlock** pBlock, SArra
   }
 
   SReaderStatus* pStatus = &pTReader->status;
-  if (pStatus->composedDataBlock || pReader->info.execMode == READER_EXEC_ROWS) {
+  if (pStatus->composedDataBlock || pReader->info.execMode == READER_EXEC_ROWS || pReader->pPara != NULL) {
     //    tsdbReaderSuspend2(pReader);
     //    tsdbReaderResume2(pReader);
     *pBlock = pTReader->resBlockInfo.pResBlock;
@@ -6452,6 +6907,27 @@ int32_t tsdbReaderReset2(STsdbReader* pReader, SQueryTableDataCond* pCond) {
   int32_t lino = 0;
   bool    acquired = false;
 
+  if (pReader->pPara != NULL) {
+    TSDB_CHECK_NULL(pCond, code, lino, _end, TSDB_CODE_INVALID_PARA);
+    code = tsdbAcquireReader(pReader);
+    TSDB_CHECK_CODE(code, lino, _end);
+    acquired = true;
+
+    // the worker readers are reset on the snapshot of this reader
+    if (pReader->flag == READER_STATUS_SUSPEND) {
+      code = tsdbReaderResume2(pReader);
+      TSDB_CHECK_CODE(code, lino, _end);
+    }
+
+    pReader->info.order = pCond->order;
+    code = updateQueryTimeWindow(pReader->pTsdb, &pCond->twindows, &pReader->info.window);
+    TSDB_CHECK_CODE(code, lino, _end);
+
+    code = tsdbReaderParaReset(pReader, pCond);
+    TSDB_CHECK_CODE(code, lino, _end);
+    goto _end;
+  }
+
   tsdbTrace("tsdb/reader-reset: %p, take read mutex", pReader);
   code = tsdbAcquireReader(pReader);
   TSDB_CHECK_CODE(code, lino, _end);
@@ -6937,6 +7413,73 @@ void tsdbReaderSetCloseFlag(STsdbReader* pReader) { /*pReader->code = TSDB_CODE_
 
 void tsdbSetFilesetDelimited(STsdbReader* pReader) { pReader->bFilesetDelimited = true; }
 
+// Pick the columns referred by the filter for late materialization. It is only worthwhile if the filter refers to part
+// of the loaded columns, and all of them are loaded by the reader. Tables with composite primary key are excluded.
+static void setFilterColumns(STsdbReader* pReader, const SArray* pFilterCols) {
+  SBlockLoadSuppInfo* pSup = &pReader->suppInfo;
+  int32_t             num = 0;
+
+  if (pFilterCols == NULL || taosArrayGetSize(pFilterCols) == 0 || pSup->numOfPks > 0) {
+    return;
+  }
+
+  for (int32_t i = 0; i < taosArrayGetSize(pFilterCols); ++i) {
+    int16_t colId = *(int16_t*)taosArrayGet(pFilterCols, i);
+    bool    found = false;
+    for (int32_t j = 0; j < pSup->numOfCols; ++j) {
+      if (pSup->colId[j] == colId) {
+        found = true;
+        break;
+      }
+    }
+
+    if (!found) {
+      return;
+    }
+  }
+
+  pReader->filterColId = taosMemoryMalloc(sizeof(int16_t) * pSup->numOfCols);
+  if (pReader->filterColId == NULL) {
+    return;
+  }
+
+  // keep the order of the loaded columns, which is required when reading the block data
+  for (int32_t j = 1; j < pSup->numOfCols; ++j) {
+    for (int32_t i = 0; i < taosArrayGetSize(pFilterCols); ++i) {
+      if (*(int16_t*)taosArrayGet(pFilterCols, i) == pSup->colId[j]) {
+        pReader->filterColId[num++] = pSup->colId[j];
+        break;
+      }
+    }
+  }
+
+  if (num == 0 || num >= pSup->numOfCols - 1) {
+    taosMemoryFreeClear(pReader->filterColId);
+    return;
+  }
+
+  pReader->numOfFilterCols = num;
+}
+
+void tsdbReaderSetBlockFilter(STsdbReader* pReader, SFilterInfo* pFilterInfo, const SArray* pFilterCols) {
+  pReader->pBlockFilter = pFilterInfo;
+  pReader->numOfFilterCols = 0;
+  taosMemoryFreeClear(pReader->filterColId);
+
+  // the worker readers check the zone map with the filter, which is read only. The filter is not executed on the rows
+  // for late materialization, since the filter info holds the execution buffers and can not be shared by threads.
+  if (pReader->pPara != NULL) {
+    for (int32_t i = 0; i < pReader->pPara->numOfWorkers; ++i) {
+      pReader->pPara->pWorkers[i].pReader->pBlockFilter = pFilterInfo;
+    }
+    return;
+  }
+
+  if (pFilterInfo != NULL) {
+    setFilterColumns(pReader, pFilterCols);
+  }
+}
+
 void tsdbReaderSetNotifyCb(STsdbReader* pReader, TsdReaderNotifyCbFn notifyFn, void* param) {
   pReader->notifyFn = notifyFn;
   pReader->notifyParam = param;
@@ -0,0 +1,513 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tsdbReadUtil.h"
+#include "tsdb.h"
+#include "vnd.h"
+
+// Parallel scan mode of the tsdb reader: the table list of the reader is partitioned across worker readers, which all
+// read the snapshot taken by the owner reader. The workers run as tasks of the scan pool shared by all vnodes, and each
+// task fills the free result slots of the owner and then returns, so that a task never blocks a thread of the pool on
+// a slow consumer. The filled slots are swapped into the result block of the owner reader, no data is copied.
+//
+// Since the blocks are loaded by the workers, the owner reader provides neither block SMA nor late materialization of
+// filter columns, while the zone map of the clean file blocks is still checked by the workers.
+
+#define PARA_QUEUE_SLOTS_PER_WORKER 2
+
+// swap the column buffers and the block info of two blocks with the same schema
+static void paraSwapBlock(SSDataBlock* p1, SSDataBlock* p2) {
+  SDataBlockInfo info = p1->info;
+  p1->info = p2->info;
+  p2->info = info;
+
+  int32_t numOfCols = taosArrayGetSize(p1->pDataBlock);
+  for (int32_t i = 0; i < numOfCols; ++i) {
+    SColumnInfoData* pCol1 = taosArrayGet(p1->pDataBlock, i);
+    SColumnInfoData* pCol2 = taosArrayGet(p2->pDataBlock, i);
+    SColumnInfoData  col = *pCol1;
+    *pCol1 = *pCol2;
+    *pCol2 = col;
+  }
+}
+
+static int32_t paraWorkerExec(void* param) {
+  SReaderParaWorker* pWorker = param;
+  SReaderParaInfo*   pPara = pWorker->pPara;
+  STsdbReader*       pReader = pWorker->pReader;
+  int32_t            code = TSDB_CODE_SUCCESS;
+
+  while (1) {
+    bool         hasNext = false;
+    SSDataBlock* pSlot = NULL;
+    SSDataBlock* pBlock = NULL;
+
+    (void)taosThreadMutexLock(&pPara->mutex);
+    if (pPara->stop || pPara->code != TSDB_CODE_SUCCESS || pPara->numOfFree == 0) {
+      (void)taosThreadMutexUnlock(&pPara->mutex);
+      break;
+    }
+    pSlot = pPara->pFree[--pPara->numOfFree];
+    (void)taosThreadMutexUnlock(&pPara->mutex);
+
+    code = tsdbNextDataBlock2(pReader, &hasNext);
+    if (code == TSDB_CODE_SUCCESS && hasNext) {
+      code = tsdbRetrieveDataBlock2(pReader, &pBlock, NULL);
+      tsdbReleaseDataBlock2(pReader);
+    }
+
+    bool filled = (code == TSDB_CODE_SUCCESS && pBlock != NULL && pBlock->info.rows > 0);
+    if (filled) {
+      paraSwapBlock(pSlot, pBlock);
+      pWorker->numOfBlocks += 1;
+      pWorker->numOfRows += pSlot->info.rows;
+    }
+
+    (void)taosThreadMutexLock(&pPara->mutex);
+    if (filled) {
+      pPara->pQueue[(pPara->head + pPara->numOfQueued) % pPara->capacity] = pSlot;
+      pPara->numOfQueued += 1;
+      (void)taosThreadCondSignal(&pPara->notEmpty);
+    } else {
+      pPara->pFree[pPara->numOfFree++] = pSlot;
+    }
+
+    if (code != TSDB_CODE_SUCCESS && pPara->code == TSDB_CODE_SUCCESS) {
+      pPara->code = code;
+    }
+
+    if (code != TSDB_CODE_SUCCESS || !hasNext) {
+      pWorker->done = true;
+      (void)taosThreadMutexUnlock(&pPara->mutex);
+      break;
+    }
+    (void)taosThreadMutexUnlock(&pPara->mutex);
+  }
+
+  tsdbTrace("%p para scan worker %d yields, blocks:%" PRId64 ", rows:%" PRId64 ", done:%d, code:%s, %s", pReader,
+            pWorker->index, pWorker->numOfBlocks, pWorker->numOfRows, pWorker->done, tstrerror(code),
+            pReader->idStr);
+
+  // the owner may release everything once the last task is completed, nothing is touched after unlock
+  (void)taosThreadMutexLock(&pPara->mutex);
+  pWorker->scheduled = false;
+  pPara->numOfScheduled -= 1;
+  (void)taosThreadCondBroadcast(&pPara->notEmpty);
+  (void)taosThreadMutexUnlock(&pPara->mutex);
+  return code;
+}
+
+// invoked if the task is removed from the scan pool before it runs
+static void paraWorkerCancel(void* param) {
+  SReaderParaWorker* pWorker = param;
+  SReaderParaInfo*   pPara = pWorker->pPara;
+
+  (void)taosThreadMutexLock(&pPara->mutex);
+  pWorker->scheduled = false;
+  pPara->numOfScheduled -= 1;
+  (void)taosThreadCondBroadcast(&pPara->notEmpty);
+  (void)taosThreadMutexUnlock(&pPara->mutex);
+}
+
+// Schedule the idle workers while there are more free slots than the scheduled tasks can fill, the caller must hold
+// the mutex. The workers are picked in round robin, so that no table partition is starved by a small number of slots.
+static int32_t paraScheduleWorkers(SReaderParaInfo* pPara) {
+  int32_t code = TSDB_CODE_SUCCESS;
+
+  for (int32_t i = 0; i < pPara->numOfWorkers && pPara->numOfFree > pPara->numOfScheduled; ++i) {
+    int32_t            index = (pPara->nextWorker + i) % pPara->numOfWorkers;
+    SReaderParaWorker* pWorker = &pPara->pWorkers[index];
+    if (pWorker->scheduled || pWorker->done) {
+      continue;
+    }
+
+    code = vnodeAsync(SCAN_TASK_ASYNC, EVA_PRIORITY_NORMAL, paraWorkerExec, paraWorkerCancel, pWorker,
+                      &pWorker->taskId);
+    if (code != TSDB_CODE_SUCCESS) {
+      break;
+    }
+
+    pWorker->scheduled = true;
+    pPara->numOfScheduled += 1;
+    pPara->nextWorker = (index + 1) % pPara->numOfWorkers;
+  }
+
+  return code;
+}
+
+// cancel the tasks waiting in the scan pool, and wait for the running ones to yield. The filled slots are kept.
+static void paraStopWorkers(SReaderParaInfo* pPara) {
+  (void)taosThreadMutexLock(&pPara->mutex);
+  pPara->stop = true;
+  (void)taosThreadMutexUnlock(&pPara->mutex);
+
+  for (int32_t i = 0; i < pPara->numOfWorkers; ++i) {
+    SReaderParaWorker* pWorker = &pPara->pWorkers[i];
+
+    (void)taosThreadMutexLock(&pPara->mutex);
+    bool      scheduled = pWorker->scheduled;
+    SVATaskID taskId = pWorker->taskId;
+    (void)taosThreadMutexUnlock(&pPara->mutex);
+
+    // a running task can not be cancelled, it sees the stop flag and yields
+    if (scheduled) {
+      (void)vnodeACancel(&taskId);
+    }
+  }
+
+  (void)taosThreadMutexLock(&pPara->mutex);
+  while (pPara->numOfScheduled > 0) {
+    (void)taosThreadCondWait(&pPara->notEmpty, &pPara->mutex);
+  }
+  pPara->stop = false;
+  (void)taosThreadMutexUnlock(&pPara->mutex);
+}
+
+// put the filled slots back to the free list, the workers must have been stopped
+static void paraDrainQueue(SReaderParaInfo* pPara) {
+  while (pPara->numOfQueued > 0) {
+    SSDataBlock* pSlot = pPara->pQueue[pPara->head];
+    blockDataCleanup(pSlot);
+    pPara->pQueue[pPara->head] = NULL;
+    pPara->pFree[pPara->numOfFree++] = pSlot;
+    pPara->head = (pPara->head + 1) % pPara->capacity;
+    pPara->numOfQueued -= 1;
+  }
+
+  pPara->head = 0;
+  pPara->code = TSDB_CODE_SUCCESS;
+}
+
+// a worker without tables has nothing to scan, the workers must have been stopped
+static void paraResetWorkers(SReaderParaInfo* pPara) {
+  for (int32_t i = 0; i < pPara->numOfWorkers; ++i) {
+    SReaderParaWorker* pWorker = &pPara->pWorkers[i];
+    pWorker->done = (tSimpleHashGetSize(pWorker->pReader->status.pTableMap) == 0);
+  }
+  pPara->nextWorker = 0;
+}
+
+// take at most num workers from the budget of the vnode, the rest of the budget is left to the other queries
+static int32_t paraAcquireWorkers(STsdb* pTsdb, int32_t num) {
+  while (1) {
+    int32_t used = atomic_load_32(&pTsdb->numOfScanWorkers);
+    int32_t take = TMIN(num, tsTsdbParallelScanVnodeWorkers - used);
+    if (take < 2) {
+      return 0;
+    }
+
+    if (atomic_val_compare_exchange_32(&pTsdb->numOfScanWorkers, used, used + take) == used) {
+      return take;
+    }
+  }
+}
+
+int32_t tsdbReaderParaOpen(STsdbReader* pReader, SQueryTableDataCond* pCond, const STableKeyInfo* pTableList,
+                           int32_t numOfTables, int32_t numOfWorkers) {
+  int32_t             code = TSDB_CODE_SUCCESS;
+  int32_t             lino = 0;
+  SReaderParaInfo*    pPara = NULL;
+  STableKeyInfo*      pList = NULL;
+  SQueryTableDataCond cond = {0};
+  SSDataBlock*        pResBlock = pReader->resBlockInfo.pResBlock;
+  STsdb*              pTsdb = pReader->pTsdb;
+
+  TSDB_CHECK_CONDITION(numOfWorkers > 1 && numOfTables >= numOfWorkers, code, lino, _end, TSDB_CODE_INVALID_PARA);
+
+  // scan the tables one by one, if the other queries on the vnode have taken the workers
+  numOfWorkers = paraAcquireWorkers(pTsdb, numOfWorkers);
+  if (numOfWorkers == 0) {
+    tsdbDebug("%p no parallel scan workers available in vgId:%d, %s", pReader, TD_VID(pTsdb->pVnode), pReader->idStr);
+    return code;
+  }
+
+  pPara = taosMemoryCalloc(1, sizeof(SReaderParaInfo));
+  if (pPara == NULL) {
+    (void)atomic_sub_fetch_32(&pTsdb->numOfScanWorkers, numOfWorkers);
+    TSDB_CHECK_NULL(pPara, code, lino, _end, terrno);
+  }
+
+  pPara->pTsdb = pTsdb;
+  pPara->numOfWorkers = numOfWorkers;
+  pPara->capacity = numOfWorkers * PARA_QUEUE_SLOTS_PER_WORKER;
+
+  // tsdbReaderParaClose destroys both of them, so they are undone here until both are initialized
+  code = taosThreadMutexInit(&pPara->mutex, NULL);
+  TSDB_CHECK_CODE(code, lino, _sync_failed);
+  code = taosThreadCondInit(&pPara->notEmpty, NULL);
+  if (code != TSDB_CODE_SUCCESS) {
+    (void)taosThreadMutexDestroy(&pPara->mutex);
+    TSDB_CHECK_CODE(code, lino, _sync_failed);
+  }
+
+  pPara->pSlots = taosMemoryCalloc(pPara->capacity, POINTER_BYTES);
+  TSDB_CHECK_NULL(pPara->pSlots, code, lino, _end, terrno);
+  pPara->pFree = taosMemoryCalloc(pPara->capacity, POINTER_BYTES);
+  TSDB_CHECK_NULL(pPara->pFree, code, lino, _end, terrno);
+  pPara->pQueue = taosMemoryCalloc(pPara->capacity, POINTER_BYTES);
+  TSDB_CHECK_NULL(pPara->pQueue, code, lino, _end, terrno);
+
+  // the slots are swapped with the result blocks of the owner and workers, so they must have the same capacity
+  for (int32_t i = 0; i < pPara->capacity; ++i) {
+    code = createOneDataBlock(pResBlock, false, &pPara->pSlots[i]);
+    TSDB_CHECK_CODE(code, lino, _end);
+    code = blockDataEnsureCapacity(pPara->pSlots[i], pResBlock->info.capacity);
+    TSDB_CHECK_CODE(code, lino, _end);
+    pPara->pFree[pPara->numOfFree++] = pPara->pSlots[i];
+  }
+
+  pPara->pWorkers = taosMemoryCalloc(numOfWorkers, sizeof(SReaderParaWorker));
+  TSDB_CHECK_NULL(pPara->pWorkers, code, lino, _end, terrno);
+
+  // all worker readers see exactly the same version range as the owner reader
+  cond = *pCond;
+  cond.parallelScan = false;
+  cond.startVersion = pReader->info.verRange.minVer;
+  cond.endVersion = pReader->info.verRange.maxVer;
+
+  pList = taosMemoryMalloc(sizeof(STableKeyInfo) * (numOfTables / numOfWorkers + 1));
+  TSDB_CHECK_NULL(pList, code, lino, _end, terrno);
+
+  for (int32_t i = 0; i < numOfWorkers; ++i) {
+    SReaderParaWorker* pWorker = &pPara->pWorkers[i];
+    pWorker->index = i;
+    pWorker->pPara = pPara;
+
+    code = createOneDataBlock(pResBlock, false, &pWorker->pResBlock);
+    TSDB_CHECK_CODE(code, lino, _end);
+
+    // round-robin, since the data volume is often skewed along the uid order
+    int32_t num = 0;
+    for (int32_t j = i; j < numOfTables; j += numOfWorkers) {
+      pList[num++] = pTableList[j];
+    }
+
+    // the worker readers do not take snapshots of their own, see tsdbReaderParaResume
+    code = tsdbReaderOpen2(pTsdb->pVnode, &cond, pList, num, pWorker->pResBlock, (void**)&pWorker->pReader,
+                           pReader->idStr, pReader->pIgnoreTables);
+    TSDB_CHECK_CODE(code, lino, _end);
+  }
+
+  paraResetWorkers(pPara);
+  pReader->pPara = pPara;
+  tsdbDebug("%p reader runs in parallel scan mode, workers:%d, numOfTables:%d, %s", pReader, numOfWorkers, numOfTables,
+            pReader->idStr);
+
+_end:
+  taosMemoryFree(pList);
+  if (code != TSDB_CODE_SUCCESS) {
+    tsdbError("%s failed at line %d since %s, %s", __func__, lino, tstrerror(code), pReader->idStr);
+    tsdbReaderParaClose(&pPara);
+  }
+  return code;
+
+_sync_failed:
+  tsdbError("%s failed at line %d since %s, %s", __func__, lino, tstrerror(code), pReader->idStr);
+  (void)atomic_sub_fetch_32(&pTsdb->numOfScanWorkers, numOfWorkers);
+  taosMemoryFree(pPara);
+  return code;
+}
+
+void tsdbReaderParaClose(SReaderParaInfo** ppPara) {
+  SReaderParaInfo* pPara = *ppPara;
+  if (pPara == NULL) {
+    return;
+  }
+
+  if (pPara->pWorkers != NULL) {
+    paraStopWorkers(pPara);
+
+    for (int32_t i = 0; i < pPara->numOfWorkers; ++i) {
+      SReaderParaWorker* pWorker = &pPara->pWorkers[i];
+      if (pWorker->pReader != NULL) {
+        pWorker->pReader->pReadSnap = NULL;  // the snapshot belongs to the owner reader
+        tsdbReaderClose2(pWorker->pReader);
+      }
+      blockDataDestroy(pWorker->pResBlock);
+    }
+  }
+
+  if (pPara->pSlots != NULL) {
+    for (int32_t i = 0; i < pPara->capacity; ++i) {
+      blockDataDestroy(pPara->pSlots[i]);
+    }
+  }
+
+  (void)atomic_sub_fetch_32(&pPara->pTsdb->numOfScanWorkers, pPara->numOfWorkers);
+
+  taosMemoryFree(pPara->pWorkers);
+  taosMemoryFree(pPara->pSlots);
+  taosMemoryFree(pPara->pFree);
+  taosMemoryFree(pPara->pQueue);
+  (void)taosThreadCondDestroy(&pPara->notEmpty);
+  (void)taosThreadMutexDestroy(&pPara->mutex);
+  taosMemoryFree(pPara);
+  *ppPara = NULL;
+}
+
+// the owner reader has taken the snapshot, let the workers scan on it
+int32_t tsdbReaderParaResume(STsdbReader* pReader) {
+  int32_t          code = TSDB_CODE_SUCCESS;
+  int32_t          lino = 0;
+  SReaderParaInfo* pPara = pReader->pPara;
+
+  for (int32_t i = 0; i < pPara->numOfWorkers; ++i) {
+    code = tsdbReaderAttachSnap(pPara->pWorkers[i].pReader, pReader->pReadSnap);
+    TSDB_CHECK_CODE(code, lino, _end);
+  }
+
+  paraResetWorkers(pPara);
+
+_end:
+  if (code != TSDB_CODE_SUCCESS) {
+    tsdbError("%s failed at line %d since %s, %s", __func__, lino, tstrerror(code), pReader->idStr);
+  }
+  return code;
+}
+
+// the owner reader is going to release the snapshot, the blocks in the queue are kept and returned after resume
+void tsdbReaderParaSuspend(STsdbReader* pReader) {
+  SReaderParaInfo* pPara = pReader->pPara;
+
+  paraStopWorkers(pPara);
+  for (int32_t i = 0; i < pPara->numOfWorkers; ++i) {
+    tsdbReaderDetachSnap(pPara->pWorkers[i].pReader);
+  }
+}
+
+int32_t tsdbReaderParaNext(STsdbReader* pReader, bool* hasNext) {
+  int32_t          code = TSDB_CODE_SUCCESS;
+  int32_t          lino = 0;
+  SReaderParaInfo* pPara = pReader->pPara;
+  SSDataBlock*     pResBlock = pReader->resBlockInfo.pResBlock;
+
+  *hasNext = false;
+
+  while (1) {
+    SSDataBlock* pSlot = NULL;
+
+    (void)taosThreadMutexLock(&pPara->mutex);
+    while (1) {
+      code = paraScheduleWorkers(pPara);
+      if (code == TSDB_CODE_SUCCESS) {
+        code = pPara->code;
+      }
+
+      // no block queued and no task scheduled, since all workers are done
+      if (code != TSDB_CODE_SUCCESS || pPara->numOfQueued > 0 || pPara->numOfScheduled == 0) {
+        break;
+      }
+      (void)taosThreadCondWait(&pPara->notEmpty, &pPara->mutex);
+    }
+
+    if (code == TSDB_CODE_SUCCESS && pPara->numOfQueued > 0) {
+      pSlot = pPara->pQueue[pPara->head];
+      pPara->pQueue[pPara->head] = NULL;
+      pPara->head = (pPara->head + 1) % pPara->capacity;
+      pPara->numOfQueued -= 1;
+    }
+    (void)taosThreadMutexUnlock(&pPara->mutex);
+    TSDB_CHECK_CODE(code, lino, _end);
+
+    if (pSlot == NULL) {
+      break;
+    }
+
+    // tables may be added to the ignore list by the executor after the block of them has been queued
+    bool ignored = pReader->pIgnoreTables &&
+                   taosHashGet(*pReader->pIgnoreTables, &pSlot->info.id.uid, sizeof(pSlot->info.id.uid));
+    if (!ignored) {
+      paraSwapBlock(pResBlock, pSlot);
+    }
+    blockDataCleanup(pSlot);
+
+    // the slot is refilled while the executor processes the block
+    (void)taosThreadMutexLock(&pPara->mutex);
+    pPara->pFree[pPara->numOfFree++] = pSlot;
+    code = paraScheduleWorkers(pPara);
+    (void)taosThreadMutexUnlock(&pPara->mutex);
+    TSDB_CHECK_CODE(code, lino, _end);
+
+    if (!ignored) {
+      *hasNext = true;
+      break;
+    }
+  }
+
+_end:
+  if (code != TSDB_CODE_SUCCESS) {
+    tsdbError("%s failed at line %d since %s, %s", __func__, lino, tstrerror(code), pReader->idStr);
+  }
+  return code;
+}
+
+int32_t tsdbReaderParaReset(STsdbReader* pReader, SQueryTableDataCond* pCond) {
+  int32_t          code = TSDB_CODE_SUCCESS;
+  int32_t          lino = 0;
+  SReaderParaInfo* pPara = pReader->pPara;
+
+  paraStopWorkers(pPara);
+  paraDrainQueue(pPara);
+
+  SQueryTableDataCond cond = *pCond;
+  cond.parallelScan = false;
+  cond.startVersion = pReader->info.verRange.minVer;
+  cond.endVersion = pReader->info.verRange.maxVer;
+
+  for (int32_t i = 0; i < pPara->numOfWorkers; ++i) {
+    code = tsdbReaderReset2(pPara->pWorkers[i].pReader, &cond);
+    TSDB_CHECK_CODE(code, lino, _end);
+  }
+
+  paraResetWorkers(pPara);
+
+_end:
+  if (code != TSDB_CODE_SUCCESS) {
+    tsdbError("%s failed at line %d since %s, %s", __func__, lino, tstrerror(code), pReader->idStr);
+  }
+  return code;
+}
+
+int32_t tsdbReaderParaSetTableList(STsdbReader* pReader, const STableKeyInfo* pTableList, int32_t numOfTables) {
+  int32_t          code = TSDB_CODE_SUCCESS;
+  int32_t          lino = 0;
+  SReaderParaInfo* pPara = pReader->pPara;
+  STableKeyInfo*   pList = NULL;
+
+  paraStopWorkers(pPara);
+  paraDrainQueue(pPara);
+
+  pList = taosMemoryMalloc(sizeof(STableKeyInfo) * (numOfTables / pPara->numOfWorkers + 1));
+  TSDB_CHECK_NULL(pList, code, lino, _end, terrno);
+
+  for (int32_t i = 0; i < pPara->numOfWorkers; ++i) {
+    int32_t num = 0;
+    for (int32_t j = i; j < numOfTables; j += pPara->numOfWorkers) {
+      pList[num++] = pTableList[j];
+    }
+
+    code = tsdbSetTableList2(pPara->pWorkers[i].pReader, pList, num);
+    TSDB_CHECK_CODE(code, lino, _end);
+  }
+
+  paraResetWorkers(pPara);
+
+_end:
+  taosMemoryFree(pList);
+  if (code != TSDB_CODE_SUCCESS) {
+    tsdbError("%s failed at line %d since %s, %s", __func__, lino, tstrerror(code), pReader->idStr);
+  }
+  return code;
+}
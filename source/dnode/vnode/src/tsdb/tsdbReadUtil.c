@@ -762,6 +762,7 @@ void clearDataBlockIterator(SDataBlockIter* pIter, bool needFree) {
   }
 
   pIter->index = -1;
+  pIter->prefetchIndex = -1;
   pIter->numOfBlocks = 0;
 
   if (needFree) {
@@ -858,6 +859,7 @@ int32_t initBlockIterator(STsdbReader* pReader, SDataBlockIter* pBlockIter, int3
               pReader, numOfBlocks, (et - st) / 1000.0, pReader->idStr);
 
     pBlockIter->index = asc ? 0 : (numOfBlocks - 1);
+    pBlockIter->prefetchIndex = pBlockIter->index;
     goto _end;
   }
 
@@ -902,6 +904,7 @@ int32_t initBlockIterator(STsdbReader* pReader, SDataBlockIter* pBlockIter, int3
             (et - st) / 1000.0, pReader->idStr);
 
   pBlockIter->index = asc ? 0 : (numOfBlocks - 1);
+  pBlockIter->prefetchIndex = pBlockIter->index;
 
 _end:
   if (code != TSDB_CODE_SUCCESS) {
@@ -1078,10 +1081,73 @@ _end:
   return code;
 }
 
+static int32_t doLoadTombDataFromTombIndex(const STombIndex* pIndex, STsdbReader* pReader) {
+  int32_t                 code = TSDB_CODE_SUCCESS;
+  int32_t                 lino = 0;
+  const STableUidList*    pList = NULL;
+  const TTombRecordArray* pRecords = NULL;
+  STableBlockScanInfo*    pScanInfo = NULL;
+  int32_t                 numOfTables = 0;
+  uint64_t                uid = 0;
+
+  TSDB_CHECK_NULL(pIndex, code, lino, _end, TSDB_CODE_INVALID_PARA);
+  TSDB_CHECK_NULL(pReader, code, lino, _end, TSDB_CODE_INVALID_PARA);
+
+  pList = &pReader->status.uidList;
+  numOfTables = tSimpleHashGetSize(pReader->status.pTableMap);
+  if (numOfTables == 0) {
+    goto _end;
+  }
+
+  pRecords = tsdbTombIndexGetRecords(pIndex, pReader->info.verRange.maxVer);
+
+  int32_t j = 0;
+  for (int32_t i = tsdbTombIndexSeek(pRecords, pReader->info.suid, pList->tableUidList[0]);
+       i < TARRAY2_SIZE(pRecords); ++i) {
+    const STombRecord* pRecord = TARRAY2_GET_PTR(pRecords, i);
+    if (pRecord->suid != pReader->info.suid) {
+      break;
+    }
+
+    while (j < numOfTables && pList->tableUidList[j] < pRecord->uid) {
+      j += 1;
+    }
+
+    if (j >= numOfTables) {
+      break;
+    }
+
+    if (pList->tableUidList[j] != pRecord->uid || pRecord->version > pReader->info.verRange.maxVer) {
+      continue;
+    }
+
+    if (uid != pRecord->uid) {
+      uid = pRecord->uid;
+      code = getTableBlockScanInfo(pReader->status.pTableMap, uid, &pScanInfo, pReader->idStr);
+      TSDB_CHECK_CODE(code, lino, _end);
+
+      if (pScanInfo->pFileDelData == NULL) {
+        pScanInfo->pFileDelData = taosArrayInit(4, sizeof(SDelData));
+        TSDB_CHECK_NULL(pScanInfo->pFileDelData, code, lino, _end, terrno);
+      }
+    }
+
+    SDelData    delData = {.version = pRecord->version, .sKey = pRecord->skey, .eKey = pRecord->ekey};
+    const void* px = taosArrayPush(pScanInfo->pFileDelData, &delData);
+    TSDB_CHECK_NULL(px, code, lino, _end, terrno);
+  }
+
+_end:
+  if (code != TSDB_CODE_SUCCESS) {
+    tsdbError("%s failed at line %d since %s", __func__, lino, tstrerror(code));
+  }
+  return code;
+}
+
 int32_t loadDataFileTombDataForAll(STsdbReader* pReader) {
-  int32_t              code = TSDB_CODE_SUCCESS;
-  int32_t              lino = 0;
-  const TTombBlkArray* pBlkArray = NULL;
+  int32_t           code = TSDB_CODE_SUCCESS;
+  int32_t           lino = 0;
+  const STombIndex* pIndex = NULL;
 
   TSDB_CHECK_NULL(pReader, code, lino, _end, TSDB_CODE_INVALID_PARA);
 
@@ -1089,10 +1155,11 @@ int32_t loadDataFileTombDataForAll(STsdbReader* pReader) {
     return TSDB_CODE_SUCCESS;
   }
 
-  code = tsdbDataFileReadTombBlk(pReader->pFileReader, &pBlkArray);
+  code = tsdbDataFileReadTombIndex(pReader->pFileReader, pReader->status.pCurrentFileset->farr[TSDB_FTYPE_TOMB],
+                                   &pIndex);
   TSDB_CHECK_CODE(code, lino, _end);
 
-  code = doLoadTombDataFromTombBlk(pBlkArray, pReader, pReader->pFileReader, true);
+  code = doLoadTombDataFromTombIndex(pIndex, pReader);
   TSDB_CHECK_CODE(code, lino, _end);
 
 _end:
@@ -150,6 +150,13 @@ typedef struct SReadCostSummary {
   double  createScanInfoList;
   double  createSkylineIterTime;
   double  initSttBlockReader;
+  int64_t bloomFilterSkipBlocks;
+  int64_t tombSkipBlocks;
+  int64_t zoneSkipBlocks;
+  int64_t filterProbeBlocks;
+  int64_t filterSkipBlocks;
+  int64_t prefetchBlocks;
+  int64_t filesetPrefetch;
 } SReadCostSummary;
 
 typedef struct STableUidList {
@@ -206,6 +213,8 @@ typedef struct SFilesetIter {
   TFileSetArray*    pFilesetList;  // data file set list
   int32_t           order;
   SSttBlockReader*  pSttBlockReader;  // last file block reader
+  int32_t           nextIndex;        // index of the file set read ahead by pNextReader, -1 if none
+  SDataFileReader*  pNextReader;      // reader of the next file set, opened to read it ahead and then scan it
 } SFilesetIter;
 
 typedef struct SFileDataBlockInfo {
@@ -240,6 +249,7 @@ typedef struct SDataBlockIter {
   int32_t    index;
   SArray*    blockList;  // SArray<SFileDataBlockInfo>
   int32_t    order;
+  int32_t    prefetchIndex;  // the farthest block that read-ahead has been issued for
 } SDataBlockIter;
 
 typedef struct SFileBlockDumpInfo {
@@ -276,6 +286,39 @@ typedef struct SReaderStatus {
   STableBlockScanInfo** pProcMemTableIter;
 } SReaderStatus;
 
+typedef struct SReaderParaInfo SReaderParaInfo;
+
+typedef struct SReaderParaWorker {
+  int32_t          index;
+  SVATaskID        taskId;
+  bool             scheduled;  // a task of the worker is waiting or running in the scan pool
+  bool             done;       // all tables of the worker have been scanned
+  SReaderParaInfo* pPara;
+  STsdbReader*     pReader;    // worker reader on a partition of the table list
+  SSDataBlock*     pResBlock;  // result block of the worker reader
+  int64_t          numOfBlocks;
+  int64_t          numOfRows;
+} SReaderParaWorker;
+
+struct SReaderParaInfo {
+  STsdb*             pTsdb;
+  int32_t            numOfWorkers;
+  SReaderParaWorker* pWorkers;
+  TdThreadMutex      mutex;
+  TdThreadCond       notEmpty;  // a block is queued, or a worker task is completed
+  SSDataBlock**      pSlots;    // result blocks owned by the parallel scan, filled by the worker tasks in turn
+  SSDataBlock**      pFree;     // stack of the empty slots
+  int32_t            numOfFree;
+  SSDataBlock**      pQueue;    // bounded ring buffer of the filled slots
+  int32_t            capacity;
+  int32_t            head;
+  int32_t            numOfQueued;
+  int32_t            numOfScheduled;
+  int32_t            nextWorker;  // the worker to be scheduled first, in round robin
+  int32_t            code;        // the first error reported by workers
+  bool               stop;
+};
+
 struct STsdbReader {
   STsdb*             pTsdb;
   STsdbReaderInfo    info;
@@ -299,6 +342,10 @@ struct STsdbReader {
   bool                 bFilesetDelimited;   // duration by duration output
   TsdReaderNotifyCbFn  notifyFn;
   void*                notifyParam;
+  SReaderParaInfo*     pPara;  // not NULL if the table list is scanned by parallel workers
+  SFilterInfo*         pBlockFilter;  // filter of the query, used to skip clean file blocks by the zone map
+  int16_t*             filterColId;   // sorted non-timestamp columns referred by the filter, for late materialization
+  int32_t              numOfFilterCols;
 };
 
 typedef struct SBrinRecordIter {
@@ -359,6 +406,18 @@ int32_t resetDataBlockIterator(SDataBlockIter* pIter, int32_t order, bool hasPk,
 void    clearDataBlockIterator(SDataBlockIter* pIter, bool needFree);
 void    cleanupDataBlockIterator(SDataBlockIter* pIter, bool hasPk);
 
+// parallel scan API
+int32_t tsdbReaderParaOpen(STsdbReader* pReader, SQueryTableDataCond* pCond, const STableKeyInfo* pTableList,
+                           int32_t numOfTables, int32_t numOfWorkers);
+void    tsdbReaderParaClose(SReaderParaInfo** ppPara);
+int32_t tsdbReaderParaNext(STsdbReader* pReader, bool* hasNext);
+int32_t tsdbReaderParaReset(STsdbReader* pReader, SQueryTableDataCond* pCond);
+int32_t tsdbReaderParaSetTableList(STsdbReader* pReader, const STableKeyInfo* pTableList, int32_t numOfTables);
+int32_t tsdbReaderParaResume(STsdbReader* pReader);
+void    tsdbReaderParaSuspend(STsdbReader* pReader);
+int32_t tsdbReaderAttachSnap(STsdbReader* pReader, STsdbReadSnap* pSnap);
+void    tsdbReaderDetachSnap(STsdbReader* pReader);
+
 typedef struct {
   SArray* pTombData;
 } STableLoadInfo;
@@ -19,6 +19,9 @@
 #include "tsdbDef.h"
 #include "vnd.h"
 
+// upper bound of the bytes fetched by one coalesced read of contiguous pages
+#define TSDB_READ_BATCH_SIZE (4 << 20)
+
 static int32_t tsdbOpenFileImpl(STsdbFD *pFD) {
   int32_t     code = 0;
   int32_t     lino;
@@ -125,6 +128,7 @@ void tsdbCloseFile(STsdbFD **ppFD) {
   STsdbFD *pFD = *ppFD;
   if (pFD) {
     taosMemoryFree(pFD->pBuf);
+    tFree(pFD->pReadBuf);
     int32_t code = taosCloseFile(&pFD->pFD);
     if (code) {
       tsdbError("failed to close file: %s, code:%d reason:%s", pFD->path, code, tstrerror(code));
@@ -202,15 +206,7 @@ _exit:
   return code;
 }
 
-static int32_t tsdbReadFilePage(STsdbFD *pFD, int64_t pgno, int32_t encryptAlgorithm, char *encryptKey) {
-  int32_t code = 0;
-  int32_t lino;
-
-  if (!pFD->pFD) {
-    code = tsdbOpenFileImpl(pFD);
-    TSDB_CHECK_CODE(code, lino, _exit);
-  }
-
+static int64_t tsdbFilePageOffset(STsdbFD *pFD, int64_t pgno) {
   int64_t offset = PAGE_OFFSET(pgno, pFD->szPage);
   if (pFD->lcn > 1) {
     SVnodeCfg *pCfg = &pFD->pTsdb->pVnode->config;
@@ -219,22 +215,11 @@ static int32_t tsdbReadFilePage(STsdbFD *pFD, int64_t pgno, int32_t encryptAlgor
 
     offset -= chunkoffset;
   }
+  return offset;
+}
 
-  // seek
-  int64_t n = taosLSeekFile(pFD->pFD, offset, SEEK_SET);
-  if (n < 0) {
-    TSDB_CHECK_CODE(code = terrno, lino, _exit);
-  }
-
-  // read
-  n = taosReadFile(pFD->pFD, pFD->pBuf, pFD->szPage);
-  if (n < 0) {
-    TSDB_CHECK_CODE(code = terrno, lino, _exit);
-  } else if (n < pFD->szPage) {
-    TSDB_CHECK_CODE(code = TSDB_CODE_FILE_CORRUPTED, lino, _exit);
-  }
-  //}
-
+static int32_t tsdbDecodeFilePage(STsdbFD *pFD, uint8_t *pPage, int64_t pgno, int32_t encryptAlgorithm,
+                                  char *encryptKey) {
   if (encryptAlgorithm == DND_CA_SM4) {
     // if(tsiEncryptAlgorithm == DND_CA_SM4 && (tsiEncryptScope & DND_CS_TSDB) == DND_CS_TSDB){
     unsigned char PacketData[128];
@@ -244,24 +229,55 @@ static int32_t tsdbReadFilePage(STsdbFD *pFD, int64_t pgno, int32_t encryptAlgor
     while (count < pFD->szPage) {
       SCryptOpts opts = {0};
       opts.len = 128;
-      opts.source = pFD->pBuf + count;
+      opts.source = pPage + count;
       opts.result = PacketData;
       opts.unitLen = 128;
       tstrncpy(opts.key, encryptKey, ENCRYPT_KEY_LEN + 1);
 
       NewLen = CBC_Decrypt(&opts);
 
-      memcpy(pFD->pBuf + count, PacketData, NewLen);
+      memcpy(pPage + count, PacketData, NewLen);
       count += NewLen;
     }
     // tsdbDebug("CBC_Decrypt count:%d %s", count, __FUNCTION__);
   }
 
   // check
-  if (pgno > 1 && !taosCheckChecksumWhole(pFD->pBuf, pFD->szPage)) {
+  if (pgno > 1 && !taosCheckChecksumWhole(pPage, pFD->szPage)) {
+    return TSDB_CODE_FILE_CORRUPTED;
+  }
+
+  return 0;
+}
+
+static int32_t tsdbReadFilePage(STsdbFD *pFD, int64_t pgno, int32_t encryptAlgorithm, char *encryptKey) {
+  int32_t code = 0;
+  int32_t lino;
+
+  if (!pFD->pFD) {
+    code = tsdbOpenFileImpl(pFD);
+    TSDB_CHECK_CODE(code, lino, _exit);
+  }
+
+  int64_t offset = tsdbFilePageOffset(pFD, pgno);
+
+  // seek
+  int64_t n = taosLSeekFile(pFD->pFD, offset, SEEK_SET);
+  if (n < 0) {
+    TSDB_CHECK_CODE(code = terrno, lino, _exit);
+  }
+
+  // read
+  n = taosReadFile(pFD->pFD, pFD->pBuf, pFD->szPage);
+  if (n < 0) {
+    TSDB_CHECK_CODE(code = terrno, lino, _exit);
+  } else if (n < pFD->szPage) {
     TSDB_CHECK_CODE(code = TSDB_CODE_FILE_CORRUPTED, lino, _exit);
   }
 
+  code = tsdbDecodeFilePage(pFD, pFD->pBuf, pgno, encryptAlgorithm, encryptKey);
+  TSDB_CHECK_CODE(code, lino, _exit);
+
   pFD->pgno = pgno;
 
 _exit:
@@ -271,6 +287,42 @@ _exit:
   return code;
 }
 
+/*
+ * Read nPage contiguous pages starting from pgno with a single positional read into pFD->pReadBuf, then decrypt and
+ * verify each of them. The last page is kept in pFD->pBuf as if it was read by tsdbReadFilePage. pFD->pReadBuf is
+ * released by the caller once the pages are copied out.
+ */
+static int32_t tsdbReadFilePages(STsdbFD *pFD, int64_t pgno, int64_t nPage, int32_t encryptAlgorithm,
+                                 char *encryptKey) {
+  int32_t code = 0;
+  int32_t lino;
+  int64_t size = nPage * pFD->szPage;
+
+  code = tRealloc(&pFD->pReadBuf, size);
+  TSDB_CHECK_CODE(code, lino, _exit);
+
+  int64_t n = taosPReadFile(pFD->pFD, pFD->pReadBuf, size, tsdbFilePageOffset(pFD, pgno));
+  if (n < 0) {
+    TSDB_CHECK_CODE(code = terrno, lino, _exit);
+  } else if (n < size) {
+    TSDB_CHECK_CODE(code = TSDB_CODE_FILE_CORRUPTED, lino, _exit);
+  }
+
+  for (int64_t iPage = 0; iPage < nPage; iPage++) {
+    code = tsdbDecodeFilePage(pFD, pFD->pReadBuf + iPage * pFD->szPage, pgno + iPage, encryptAlgorithm, encryptKey);
+    TSDB_CHECK_CODE(code, lino, _exit);
+  }
+
+  memcpy(pFD->pBuf, pFD->pReadBuf + (nPage - 1) * pFD->szPage, pFD->szPage);
+  pFD->pgno = pgno + nPage - 1;
+
+_exit:
+  if (code) {
+    TSDB_ERROR_LOG(TD_VID(pFD->pTsdb->pVnode), lino, code);
+  }
+  return code;
+}
+
 int32_t tsdbWriteFile(STsdbFD *pFD, int64_t offset, const uint8_t *pBuf, int64_t size, int32_t encryptAlgorithm,
                       char *encryptKey) {
   int32_t code = 0;
@@ -324,8 +376,29 @@ static int32_t tsdbReadFileImp(STsdbFD *pFD, int64_t offset, uint8_t *pBuf, int6
 
   while (n < size) {
     if (pFD->pgno != pgno) {
-      code = tsdbReadFilePage(pFD, pgno, encryptAlgorithm, encryptKey);
-      TSDB_CHECK_CODE(code, lino, _exit);
+      // number of pages the rest of the request spans, capped by the batch size and stopped before the buffered page
+      int64_t nPage = 1 + (size - n - TMIN(szPgCont - bOffset, size - n) + szPgCont - 1) / szPgCont;
+      nPage = TMIN(nPage, TMAX(TSDB_READ_BATCH_SIZE / pFD->szPage, 1));
+      if (pFD->pgno > pgno) {
+        nPage = TMIN(nPage, pFD->pgno - pgno);
+      }
+
+      if (nPage > 1) {
+        code = tsdbReadFilePages(pFD, pgno, nPage, encryptAlgorithm, encryptKey);
+        TSDB_CHECK_CODE(code, lino, _exit);
+
+        for (int64_t iPage = 0; iPage < nPage - 1; iPage++) {
+          int64_t nRead = szPgCont - bOffset;
+          memcpy(pBuf + n, pFD->pReadBuf + iPage * pFD->szPage + bOffset, nRead);
+
+          n += nRead;
+          pgno++;
+          bOffset = 0;
+        }
+      } else {
+        code = tsdbReadFilePage(pFD, pgno, encryptAlgorithm, encryptKey);
+        TSDB_CHECK_CODE(code, lino, _exit);
+      }
     }
 
     int64_t nRead = TMIN(szPgCont - bOffset, size - n);
@@ -340,6 +413,8 @@ _exit:
   if (code) {
     TSDB_ERROR_LOG(TD_VID(pFD->pTsdb->pVnode), lino, code);
   }
+  // a reader keeps many files open, do not hold a batch sized buffer for each of them between reads
+  tFree(pFD->pReadBuf);
   return code;
 }
 
@@ -560,6 +635,34 @@ _exit:
   return code;
 }
 
+int32_t tsdbPrefetchFile(STsdbFD *pFD, int64_t offset, int64_t size) {
+  int32_t code = 0;
+  int32_t lino;
+
+  // migrated files are served by the s3 page cache, no local read-ahead
+  if (size <= 0 || pFD->lcn > 1) {
+    return code;
+  }
+
+  if (!pFD->pFD) {
+    code = tsdbOpenFileImpl(pFD);
+    TSDB_CHECK_CODE(code, lino, _exit);
+  }
+
+  int64_t pgnoStart = OFFSET_PGNO(LOGIC_TO_FILE_OFFSET(offset, pFD->szPage), pFD->szPage);
+  int64_t pgnoEnd = OFFSET_PGNO(LOGIC_TO_FILE_OFFSET(offset + size - 1, pFD->szPage), pFD->szPage);
+
+  code = taosReadAheadFile(pFD->pFD, PAGE_OFFSET(pgnoStart, pFD->szPage),
+                           (pgnoEnd - pgnoStart + 1) * pFD->szPage);
+  TSDB_CHECK_CODE(code, lino, _exit);
+
+_exit:
+  if (code) {
+    TSDB_ERROR_LOG(TD_VID(pFD->pTsdb->pVnode), lino, code);
+  }
+  return code;
+}
+
 int32_t tsdbFsyncFile(STsdbFD *pFD, int32_t encryptAlgorithm, char *encryptKey) {
   int32_t code = 0;
   int32_t lino;
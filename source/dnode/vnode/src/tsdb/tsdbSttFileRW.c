@@ -491,10 +491,11 @@ struct SSttFileWriter {
   STbStatisBlock  staticBlock[1];
   SBlockData      blockData[1];
   // helper data
-  SSkmInfo skmTb[1];
-  SSkmInfo skmRow[1];
-  SBuffer  local[10];
-  SBuffer *buffers;
+  SSkmInfo  skmTb[1];
+  SSkmInfo  skmRow[1];
+  SBuffer   local[10];
+  SBuffer  *buffers;
+  SHashObj *adaptCmpr;
   // SColCompressInfo2 pInfo;
 };
 
@@ -549,7 +550,8 @@ static int32_t tsdbSttFileDoWriteBlockData(SSttFileWriter *writer) {
   int32_t lino = 0;
 
   tb_uid_t         uid = writer->blockData->suid == 0 ? writer->blockData->uid : writer->blockData->suid;
-  SColCompressInfo info = {.defaultCmprAlg = writer->config->cmprAlg, .pColCmpr = NULL};
+  SColCompressInfo info = {
+      .defaultCmprAlg = writer->config->cmprAlg, .pColCmpr = NULL, .pAdaptCmpr = writer->adaptCmpr};
   code = metaGetColCmpr(writer->config->tsdb->pVnode->pMeta, uid, &(info.pColCmpr));
 
   int32_t encryptAlgorithm = writer->config->tsdb->pVnode->config.tsdbCfg.encryptAlgorithm;
@@ -821,6 +823,12 @@ static int32_t tsdbSttFWriterDoOpen(SSttFileWriter *writer) {
   // range
   writer->ctx->range = (SVersionRange){.minVer = VERSION_MAX, .maxVer = VERSION_MIN};
 
+  // algorithms chosen by tsdbAdaptiveCompress for the columns of this file
+  writer->adaptCmpr = taosHashInit(64, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), false, HASH_NO_LOCK);
+  if (writer->adaptCmpr == NULL) {
+    TAOS_CHECK_GOTO(terrno, &lino, _exit);
+  }
+
   writer->ctx->opened = true;
 
 _exit:
@@ -843,6 +851,7 @@ static void tsdbSttFWriterDoClose(SSttFileWriter *writer) {
   TARRAY2_DESTROY(writer->tombBlkArray, NULL);
   TARRAY2_DESTROY(writer->statisBlkArray, NULL);
   TARRAY2_DESTROY(writer->sttBlkArray, NULL);
+  taosHashCleanup(writer->adaptCmpr);
 }
 
 static int32_t tsdbSttFileDoUpdateHeader(SSttFileWriter *writer) {
@@ -1385,6 +1385,53 @@ SColData *tBlockDataGetColData(SBlockData *pBlockData, int16_t cid) {
   return NULL;
 }
 
+#define TSDB_ADAPT_CMPR_MIN_ROWS 64
+#define TSDB_ADAPT_CMPR_MAX_COLS 4096
+
+typedef struct {
+  uint32_t cfgAlg;  // the algorithm configured for the column when the choice was made
+  uint32_t alg;
+} SAdaptCmprAlg;
+
+/* With tsdbAdaptiveCompress on, the algorithm of a column is chosen by trial compression on the first block of
+ * the table in a file with enough values, and reused by the following blocks, so the trials run once per table
+ * and column in each file rather than once per block. Without a map, or once the map is full, the configured
+ * algorithm is kept.
+ */
+static int32_t tsdbAdaptColCmprAlg(SHashObj *pAdaptCmpr, int64_t uid, SColData *colData, uint32_t *cmprAlg,
+                                   SBuffer *assist) {
+  if (pAdaptCmpr == NULL) {
+    return 0;
+  }
+
+  int64_t        key[2] = {uid, colData->cid};
+  SAdaptCmprAlg *pAlg = taosHashGet(pAdaptCmpr, key, sizeof(key));
+  if (pAlg != NULL && pAlg->cfgAlg == *cmprAlg) {
+    *cmprAlg = pAlg->alg;
+    return 0;
+  }
+  if (pAlg == NULL && taosHashGetSize(pAdaptCmpr) >= TSDB_ADAPT_CMPR_MAX_COLS) {
+    return 0;
+  }
+  if (colData->numOfValue < TSDB_ADAPT_CMPR_MIN_ROWS) {
+    return 0;
+  }
+
+  SAdaptCmprAlg alg = {.cfgAlg = *cmprAlg, .alg = *cmprAlg};
+  int32_t       code = tColDataSelectCmprAlg(colData, &alg.alg, assist);
+  if (code) {
+    return code;
+  }
+
+  code = taosHashPut(pAdaptCmpr, key, sizeof(key), &alg, sizeof(alg));
+  if (code) {
+    return code;
+  }
+
+  *cmprAlg = alg.alg;
+  return 0;
+}
+
 /* buffers[0]: SDiskDataHdr
  * buffers[1]: key part: uid + version + ts + primary keys
  * buffers[2]: SBlockCol part
@@ -1438,6 +1485,12 @@ int32_t tBlockDataCompress(SBlockData *bData, void *pCompr, SBuffer *buffers, SB
       //
     }
 
+    if (tsTsdbAdaptiveCompress) {
+      code = tsdbAdaptColCmprAlg(pInfo->pAdaptCmpr, bData->suid ? bData->suid : bData->uid, colData, &cinfo.cmprAlg,
+                                 assist);
+      TSDB_CHECK_CODE(code, lino, _exit);
+    }
+
     int32_t offset = buffers[3].size;
     code = tColDataCompress(colData, &cinfo, &buffers[3], assist);
     TSDB_CHECK_CODE(code, lino, _exit);
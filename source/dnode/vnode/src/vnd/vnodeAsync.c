@@ -127,6 +127,7 @@ struct {
     [2] = {"vnode-merge", NULL},
     [3] = {"vnode-compact", NULL},
     [4] = {"vnode-retention", NULL},
+    [5] = {"vnode-scan", NULL},
 };
 
 #define MIN_ASYNC_ID 1
@@ -462,11 +463,12 @@ int32_t vnodeAsyncOpen() {
   int32_t lino = 0;
 
   int32_t numOfThreads[] = {
-      0,                        //
-      tsNumOfCommitThreads,     // vnode-commit
-      tsNumOfCommitThreads,     // vnode-merge
-      tsNumOfCompactThreads,    // vnode-compact
-      tsNumOfRetentionThreads,  // vnode-retention
+      0,                          //
+      tsNumOfCommitThreads,       // vnode-commit
+      tsNumOfCommitThreads,       // vnode-merge
+      tsNumOfCompactThreads,      // vnode-compact
+      tsNumOfRetentionThreads,    // vnode-retention
+      tsTsdbParallelScanThreads,  // vnode-scan
   };
 
   for (int32_t i = 1; i < sizeof(GVnodeAsyncs) / sizeof(GVnodeAsyncs[0]); i++) {
@@ -62,6 +62,7 @@ void initTsdbReaderAPI(TsdReader* pReader) {
   pReader->tsdSetReaderTaskId = tsdbReaderSetId;
 
   pReader->tsdSetFilesetDelimited = (void (*)(void*))tsdbSetFilesetDelimited;
+  pReader->tsdSetBlockFilter = (void (*)(void*, void*, const SArray*))tsdbReaderSetBlockFilter;
   pReader->tsdSetSetNotifyCb = (void (*)(void*, TsdReaderNotifyCbFn, void*))tsdbReaderSetNotifyCb;
 
   // file set iterate
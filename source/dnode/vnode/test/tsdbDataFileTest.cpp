@@ -0,0 +1,887 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+
+#include <taoserror.h>
+#include <tglobal.h>
+
+#include "tbloomfilter.h"
+#include "tsdbDataFileRW.h"
+#include "tsdbDef.h"
+#include "tsdbFS2.h"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+
+namespace {
+
+const int32_t kSzPage = 4096;
+const int64_t kBlockGap = 4096;
+const int64_t kFirstBlock = 1000;
+
+// a .head file in the temp directory, written and read through the tsdb file helpers of a vnode-less tsdb
+class TsdbDataFileTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    vnode = (SVnode *)taosMemoryCalloc(1, sizeof(SVnode));
+    ASSERT_NE(vnode, nullptr);
+    vnode->config.vgId = 2;
+    vnode->config.tsdbPageSize = kSzPage;
+
+    tsdb = (STsdb *)taosMemoryCalloc(1, sizeof(STsdb));
+    ASSERT_NE(tsdb, nullptr);
+    tsdb->pVnode = vnode;
+
+    snprintf(path, sizeof(path), "%s%stsdbDataFileTest.head", tsTempDir[0] ? tsTempDir : "/tmp", TD_DIRSEP);
+    fileSize = 0;
+  }
+
+  void TearDown() override {
+    (void)taosRemoveFile(path);
+    taosMemoryFree(tsdb);
+    taosMemoryFree(vnode);
+  }
+
+  // blocks without the column 5 every third block, the records are appended out of block order
+  static void buildZoneMap(int32_t numOfBlocks, TZoneRecordArray *zoneMap, std::vector<SZoneRecord> *expect) {
+    const int16_t cids[] = {2, 3, 5};
+
+    TARRAY2_INIT(zoneMap);
+    for (int32_t b = 0; b < numOfBlocks; b++) {
+      for (int16_t cid : cids) {
+        if (cid == 5 && b % 3 == 0) continue;
+        SZoneRecord record = {
+            .blockOffset = kFirstBlock + b * kBlockGap,
+            .cid = cid,
+            .numOfNull = (int16_t)(b % 7),
+            .min = (int64_t)b * 10 - cid,
+            .max = (int64_t)b * 10 + cid,
+        };
+        expect->push_back(record);
+      }
+    }
+
+    std::vector<SZoneRecord> shuffled(*expect);
+    std::reverse(shuffled.begin(), shuffled.end());
+    for (size_t i = 0; i + 1 < shuffled.size(); i += 2) {
+      std::swap(shuffled[i], shuffled[i + 1]);
+    }
+    for (const SZoneRecord &record : shuffled) {
+      ASSERT_EQ(TARRAY2_APPEND(zoneMap, record), 0);
+    }
+  }
+
+  // the timestamps of block b, which do not overlap with the ones of the other blocks
+  static TSKEY blockKey(int32_t b, int32_t i) { return 1700000000000LL + b * 100000LL + i * 3; }
+
+  // the bloom filters of the timestamps of each block but the blocks without a filter
+  static void buildBlooms(int32_t numOfBlocks, int32_t numOfRows, std::vector<SBloomFilter *> *blooms) {
+    for (int32_t b = 0; b < numOfBlocks; b++) {
+      SBloomFilter *bf = NULL;
+      if (b % 3 != 2) {
+        ASSERT_EQ(tBloomFilterInit(numOfRows, 0.01, &bf), 0);
+        for (int32_t i = 0; i < numOfRows; i++) {
+          TSKEY key = blockKey(b, i);
+          (void)tBloomFilterPut(bf, &key, sizeof(key));
+        }
+      }
+      blooms->push_back(bf);
+    }
+  }
+
+  // header, bloom filters and zone map if any, then the footer, as the data file writer lays out a .head file
+  void writeHead(TZoneRecordArray *zoneMap, int32_t maxBlocks, const std::vector<SBloomFilter *> *blooms = nullptr) {
+    STsdbFD    *fd = NULL;
+    uint8_t     hdr[TSDB_FHDR_SIZE] = {0};
+    SHeadFooter footer;
+
+    memset(&footer, 0, sizeof(footer));
+    ASSERT_EQ(tsdbOpenFile(path, tsdb, TD_FILE_READ | TD_FILE_WRITE | TD_FILE_CREATE | TD_FILE_TRUNC, &fd, 0), 0);
+    ASSERT_EQ(tsdbWriteFile(fd, 0, hdr, TSDB_FHDR_SIZE, 0, NULL), 0);
+    fileSize = TSDB_FHDR_SIZE;
+    if (blooms != nullptr) {
+      // the filters are appended as blocks are written, out of block order when old blocks are carried over
+      TBloomBlkArray bloomBlkArray[1];
+      TARRAY2_INIT(bloomBlkArray);
+      for (int32_t b = (int32_t)blooms->size() - 1; b >= 0; b--) {
+        SBloomFilter *bf = (*blooms)[b];
+        if (bf == NULL) continue;
+        SBloomBlk bloomBlk = {
+            .blockOffset = kFirstBlock + b * kBlockGap,
+            .size = (int32_t)(bf->numUnits * sizeof(uint64_t)),
+            .hashFuncs = bf->hashFunctions,
+        };
+        ASSERT_EQ(tsdbFileWriteBloomData(fd, &bloomBlk, bf->buffer, bloomBlkArray, &fileSize, 0, NULL), 0);
+      }
+      ASSERT_EQ(tsdbFileWriteBloomBlk(fd, bloomBlkArray, footer.bloomBlkPtr, &fileSize, 0, NULL), 0);
+      TARRAY2_DESTROY(bloomBlkArray, NULL);
+    }
+    if (zoneMap != NULL) {
+      ASSERT_EQ(tsdbFileWriteZoneMap(fd, zoneMap, maxBlocks, footer.zoneMapPtr, &fileSize, 0, NULL), 0);
+    }
+    ASSERT_EQ(tsdbFileWriteHeadFooter(fd, &fileSize, &footer, 0, NULL), 0);
+    ASSERT_EQ(tsdbFsyncFile(fd, 0, NULL), 0);
+    tsdbCloseFile(&fd);
+  }
+
+  void readFooter(STsdbFD *fd, SHeadFooter *footer) {
+    ASSERT_EQ(tsdbReadFile(fd, fileSize - sizeof(SHeadFooter), (uint8_t *)footer, sizeof(SHeadFooter), 0, 0, NULL),
+              0);
+  }
+
+  void openReader(SDataFileReader **reader) {
+    SDataFileReaderConfig config;
+    const char           *fname[TSDB_FTYPE_MAX] = {0};
+
+    memset(&config, 0, sizeof(config));
+    config.tsdb = tsdb;
+    config.szPage = kSzPage;
+    config.files[TSDB_FTYPE_HEAD].exist = true;
+    config.files[TSDB_FTYPE_HEAD].file.size = fileSize;
+    fname[TSDB_FTYPE_HEAD] = path;
+    ASSERT_EQ(tsdbDataFileReaderOpen(fname, &config, reader), 0);
+  }
+
+  SVnode *vnode = NULL;
+  STsdb  *tsdb = NULL;
+  char    path[PATH_MAX];
+  int64_t fileSize;
+};
+
+}  // namespace
+
+TEST(tsdbZoneRecordTest, encodeDecode) {
+  SZoneRecord records[] = {
+      {.blockOffset = 0, .cid = 2, .numOfNull = 0, .min = 0, .max = 0},
+      {.blockOffset = INT64_MAX, .cid = INT16_MAX, .numOfNull = INT16_MAX, .min = INT64_MIN, .max = INT64_MAX},
+      {.blockOffset = 123456789, .cid = -1, .numOfNull = 4096, .min = -42, .max = 42},
+  };
+  uint8_t buf[128] = {0};
+
+  for (const SZoneRecord &record : records) {
+    // the records are packed in the file, so they are decoded from unaligned positions
+    uint8_t *p = buf + 1;
+    int32_t  n = tPutZoneRecord(NULL, &record);
+    ASSERT_EQ(n, 28);
+    ASSERT_EQ(tPutZoneRecord(p, &record), n);
+
+    SZoneRecord decoded;
+    memset(&decoded, 0xff, sizeof(decoded));
+    ASSERT_EQ(tGetZoneRecord(p, &decoded), n);
+    ASSERT_EQ(decoded.blockOffset, record.blockOffset);
+    ASSERT_EQ(decoded.cid, record.cid);
+    ASSERT_EQ(decoded.numOfNull, record.numOfNull);
+    ASSERT_EQ(decoded.min, record.min);
+    ASSERT_EQ(decoded.max, record.max);
+  }
+}
+
+TEST_F(TsdbDataFileTest, zoneMapRoundTrip) {
+  const int32_t            numOfBlocks = 1000;
+  const int32_t            maxBlocks = 64;
+  TZoneRecordArray         zoneMap[1];
+  std::vector<SZoneRecord> expect;
+
+  buildZoneMap(numOfBlocks, zoneMap, &expect);
+  writeHead(zoneMap, maxBlocks);
+  TARRAY2_DESTROY(zoneMap, NULL);
+
+  STsdbFD    *fd = NULL;
+  SHeadFooter footer;
+  ASSERT_EQ(tsdbOpenFile(path, tsdb, TD_FILE_READ, &fd, 0), 0);
+  readFooter(fd, &footer);
+  ASSERT_GT(footer.zoneMapPtr->size, 0);
+
+  TZoneBlkArray zoneBlkArray[1];
+  ASSERT_EQ(tsdbFileReadZoneBlk(fd, footer.zoneMapPtr, zoneBlkArray, 0, NULL), 0);
+  ASSERT_EQ(TARRAY2_SIZE(zoneBlkArray), (numOfBlocks + maxBlocks - 1) / maxBlocks);
+
+  // every zone block holds whole data blocks in block offset order and the records come back in (blockOffset, cid)
+  SBuffer          buffer;
+  TZoneRecordArray records[1];
+  size_t           nRecord = 0;
+  int64_t          lastMax = -1;
+
+  tBufferInit(&buffer);
+  TARRAY2_INIT(records);
+  for (int32_t i = 0; i < TARRAY2_SIZE(zoneBlkArray); i++) {
+    const SZoneBlk *zoneBlk = TARRAY2_GET_PTR(zoneBlkArray, i);
+    ASSERT_GT(zoneBlk->minBlockOffset, lastMax);
+    ASSERT_LE(zoneBlk->minBlockOffset, zoneBlk->maxBlockOffset);
+    ASSERT_LE((zoneBlk->maxBlockOffset - zoneBlk->minBlockOffset) / kBlockGap + 1, maxBlocks);
+    lastMax = zoneBlk->maxBlockOffset;
+
+    ASSERT_EQ(tsdbFileReadZoneBlock(fd, zoneBlk, &buffer, records, 0, NULL), 0);
+    ASSERT_EQ(TARRAY2_SIZE(records), zoneBlk->numRec);
+    for (int32_t j = 0; j < TARRAY2_SIZE(records); j++) {
+      const SZoneRecord *record = TARRAY2_GET_PTR(records, j);
+      ASSERT_LT(nRecord, expect.size());
+      ASSERT_EQ(record->blockOffset, expect[nRecord].blockOffset);
+      ASSERT_EQ(record->cid, expect[nRecord].cid);
+      ASSERT_EQ(record->numOfNull, expect[nRecord].numOfNull);
+      ASSERT_EQ(record->min, expect[nRecord].min);
+      ASSERT_EQ(record->max, expect[nRecord].max);
+      nRecord++;
+    }
+  }
+  ASSERT_EQ(nRecord, expect.size());
+
+  // an index entry that does not match its block is reported as corruption
+  SZoneBlk broken = TARRAY2_FIRST(zoneBlkArray);
+  broken.numRec++;
+  ASSERT_EQ(tsdbFileReadZoneBlock(fd, &broken, &buffer, records, 0, NULL), TSDB_CODE_FILE_CORRUPTED);
+  broken = TARRAY2_FIRST(zoneBlkArray);
+  broken.maxBlockOffset = broken.minBlockOffset;
+  ASSERT_EQ(tsdbFileReadZoneBlock(fd, &broken, &buffer, records, 0, NULL), TSDB_CODE_FILE_CORRUPTED);
+
+  TARRAY2_DESTROY(records, NULL);
+  TARRAY2_DESTROY(zoneBlkArray, NULL);
+  tBufferDestroy(&buffer);
+  tsdbCloseFile(&fd);
+}
+
+TEST_F(TsdbDataFileTest, readBlockZone) {
+  const int32_t            numOfBlocks = 300;
+  const int32_t            maxBlocks = 16;
+  TZoneRecordArray         zoneMap[1];
+  std::vector<SZoneRecord> expect;
+
+  buildZoneMap(numOfBlocks, zoneMap, &expect);
+  writeHead(zoneMap, maxBlocks);
+  TARRAY2_DESTROY(zoneMap, NULL);
+
+  SDataFileReader *reader = NULL;
+  openReader(&reader);
+  ASSERT_NE(reader, nullptr);
+
+  const TZoneBlkArray *zoneBlkArray = NULL;
+  ASSERT_EQ(tsdbDataFileReadZoneBlk(reader, &zoneBlkArray), 0);
+  ASSERT_EQ(TARRAY2_SIZE(zoneBlkArray), (numOfBlocks + maxBlocks - 1) / maxBlocks);
+
+  // jump between zone blocks, so each lookup may load a different one
+  TColumnDataAggArray aggs[1];
+  TARRAY2_INIT(aggs);
+  for (int32_t i = 0; i < numOfBlocks; i++) {
+    int32_t b = (i * 37) % numOfBlocks;
+    int64_t blockOffset = kFirstBlock + b * kBlockGap;
+
+    ASSERT_EQ(tsdbDataFileReadBlockZone(reader, blockOffset, aggs), 0);
+    ASSERT_EQ(TARRAY2_SIZE(aggs), (b % 3 == 0) ? 2 : 3);
+    for (int32_t j = 0; j < TARRAY2_SIZE(aggs); j++) {
+      const SColumnDataAgg *agg = TARRAY2_GET_PTR(aggs, j);
+      ASSERT_EQ(agg->numOfNull, b % 7);
+      ASSERT_EQ(agg->min, (int64_t)b * 10 - agg->colId);
+      ASSERT_EQ(agg->max, (int64_t)b * 10 + agg->colId);
+    }
+  }
+
+  // offsets of blocks without zone records, inside and outside the covered range
+  ASSERT_EQ(tsdbDataFileReadBlockZone(reader, kFirstBlock + 1, aggs), 0);
+  ASSERT_EQ(TARRAY2_SIZE(aggs), 0);
+  ASSERT_EQ(tsdbDataFileReadBlockZone(reader, 0, aggs), 0);
+  ASSERT_EQ(TARRAY2_SIZE(aggs), 0);
+  ASSERT_EQ(tsdbDataFileReadBlockZone(reader, kFirstBlock + numOfBlocks * kBlockGap, aggs), 0);
+  ASSERT_EQ(TARRAY2_SIZE(aggs), 0);
+
+  TARRAY2_DESTROY(aggs, NULL);
+  tsdbDataFileReaderClose(&reader);
+}
+
+TEST_F(TsdbDataFileTest, bloomRoundTrip) {
+  const int32_t numOfBlocks = 8;
+  const int32_t numOfRows = 200;
+
+  std::vector<SBloomFilter *> blooms;
+  buildBlooms(numOfBlocks, numOfRows, &blooms);
+  writeHead(NULL, 0, &blooms);
+
+  // the footer points to the index of the filters
+  STsdbFD    *fd = NULL;
+  SHeadFooter footer;
+  int32_t     numOfBlooms = 0;
+  for (SBloomFilter *bf : blooms) numOfBlooms += (bf != NULL);
+  ASSERT_EQ(tsdbOpenFile(path, tsdb, TD_FILE_READ, &fd, 0), 0);
+  readFooter(fd, &footer);
+  tsdbCloseFile(&fd);
+  ASSERT_GE(footer.bloomBlkPtr->offset, TSDB_FHDR_SIZE);
+  ASSERT_EQ(footer.bloomBlkPtr->size, numOfBlooms * sizeof(SBloomBlk));
+  ASSERT_EQ(footer.bloomBlkPtr->offset + footer.bloomBlkPtr->size, fileSize - sizeof(SHeadFooter));
+  ASSERT_EQ(footer.zoneMapPtr->size, 0);
+
+  SDataFileReader *reader = NULL;
+  openReader(&reader);
+  ASSERT_NE(reader, nullptr);
+
+  // the index is sorted by block offset
+  const TBloomBlkArray *bloomBlkArray = NULL;
+  ASSERT_EQ(tsdbDataFileReadBloomBlk(reader, &bloomBlkArray), 0);
+  ASSERT_EQ(TARRAY2_SIZE(bloomBlkArray), numOfBlooms);
+  int32_t idx = 0;
+  for (int32_t b = 0; b < numOfBlocks; b++) {
+    if (blooms[b] == NULL) continue;
+    const SBloomBlk *bloomBlk = TARRAY2_GET_PTR(bloomBlkArray, idx++);
+    ASSERT_EQ(bloomBlk->blockOffset, kFirstBlock + b * kBlockGap);
+    ASSERT_EQ(bloomBlk->size, blooms[b]->numUnits * sizeof(uint64_t));
+    ASSERT_EQ(bloomBlk->hashFuncs, blooms[b]->hashFunctions);
+  }
+
+  // look up the blocks back and forth, which reloads the filter of each one
+  for (int32_t round = 0; round < 2; round++) {
+    for (int32_t b = 0; b < numOfBlocks; b++) {
+      SBrinRecord record = {0};
+      record.blockOffset = kFirstBlock + b * kBlockGap;
+
+      int32_t falsePositives = 0;
+      for (int32_t i = 0; i < numOfRows; i++) {
+        bool  mayContain = false;
+        TSKEY key = blockKey(b, i);
+        ASSERT_EQ(tsdbDataFileBlockMayContain(reader, &record, &key, sizeof(key), &mayContain), 0);
+        ASSERT_TRUE(mayContain);
+
+        key = blockKey(b, i) + 1;
+        ASSERT_EQ(tsdbDataFileBlockMayContain(reader, &record, &key, sizeof(key), &mayContain), 0);
+        falsePositives += mayContain;
+      }
+
+      if (blooms[b] == NULL) {
+        // a block without a filter may contain any key
+        ASSERT_EQ(falsePositives, numOfRows);
+      } else {
+        ASSERT_LT(falsePositives, numOfRows / 10);
+      }
+    }
+  }
+
+  // nor does a block unknown to the index rule anything out
+  SBrinRecord record = {0};
+  record.blockOffset = kFirstBlock + 1;
+  bool  mayContain = false;
+  TSKEY key = blockKey(0, 0) + 1;
+  ASSERT_EQ(tsdbDataFileBlockMayContain(reader, &record, &key, sizeof(key), &mayContain), 0);
+  ASSERT_TRUE(mayContain);
+
+  tsdbDataFileReaderClose(&reader);
+  for (SBloomFilter *bf : blooms) tBloomFilterDestroy(bf);
+}
+
+TEST_F(TsdbDataFileTest, readAhead) {
+  std::vector<SBloomFilter *> blooms;
+  buildBlooms(4, 100, &blooms);
+  writeHead(NULL, 0, &blooms);
+
+  SDataFileReader *reader = NULL;
+  openReader(&reader);
+  ASSERT_NE(reader, nullptr);
+
+  // read-ahead goes through the fds of the reader, which are opened on first use and stay usable for reads after it
+  SBrinRecord record = {0};
+  record.blockOffset = kFirstBlock;
+  record.blockSize = 4096;
+  ASSERT_EQ(tsdbDataFileReadAheadFiles(reader, 8 * 1024 * 1024), 0);
+  ASSERT_EQ(tsdbDataFileReadAheadFiles(reader, 0), 0);
+  ASSERT_EQ(tsdbDataFileReadAheadBlock(reader, &record), 0);
+
+  bool  mayContain = false;
+  TSKEY key = blockKey(0, 10);
+  ASSERT_EQ(tsdbDataFileBlockMayContain(reader, &record, &key, sizeof(key), &mayContain), 0);
+  ASSERT_TRUE(mayContain);
+
+  tsdbDataFileReaderClose(&reader);
+  for (SBloomFilter *bf : blooms) tBloomFilterDestroy(bf);
+}
+
+TEST_F(TsdbDataFileTest, readPagesBatched) {
+  const int64_t        size = 12 * kSzPage;
+  std::vector<uint8_t> data(size);
+  for (int64_t i = 0; i < size; i++) data[i] = (uint8_t)(i * 131 + i / 977);
+
+  STsdbFD *fd = NULL;
+  ASSERT_EQ(tsdbOpenFile(path, tsdb, TD_FILE_READ | TD_FILE_WRITE | TD_FILE_CREATE | TD_FILE_TRUNC, &fd, 0), 0);
+  ASSERT_EQ(tsdbWriteFile(fd, 0, data.data(), size, 0, NULL), 0);
+  ASSERT_EQ(tsdbFsyncFile(fd, 0, NULL), 0);
+  tsdbCloseFile(&fd);
+
+  ASSERT_EQ(tsdbOpenFile(path, tsdb, TD_FILE_READ, &fd, 0), 0);
+  // spans that start and end inside a page, read one after another and backwards over the buffered page
+  const int64_t spans[][2] = {{100, 5 * kSzPage}, {7 * kSzPage, 4 * kSzPage + 17}, {0, size}, {3, 2 * kSzPage}};
+  for (const auto &span : spans) {
+    std::vector<uint8_t> buf(span[1]);
+    ASSERT_EQ(tsdbReadFile(fd, span[0], buf.data(), span[1], 0, 0, NULL), 0);
+    ASSERT_EQ(memcmp(buf.data(), data.data() + span[0], span[1]), 0);
+    // the staging buffer of the coalesced read is not kept by the fd between reads
+    ASSERT_EQ(fd->pReadBuf, nullptr);
+  }
+  tsdbCloseFile(&fd);
+}
+
+TEST_F(TsdbDataFileTest, noZoneMap) {
+  // files written with tsdbZoneMap and tsdbBloomFilter off have empty zone map and bloom pointers in the footer
+  writeHead(NULL, 0);
+
+  SDataFileReader *reader = NULL;
+  openReader(&reader);
+  ASSERT_NE(reader, nullptr);
+
+  const TZoneBlkArray *zoneBlkArray = NULL;
+  ASSERT_EQ(tsdbDataFileReadZoneBlk(reader, &zoneBlkArray), 0);
+  ASSERT_EQ(TARRAY2_SIZE(zoneBlkArray), 0);
+
+  TColumnDataAggArray aggs[1];
+  TARRAY2_INIT(aggs);
+  ASSERT_EQ(tsdbDataFileReadBlockZone(reader, kFirstBlock, aggs), 0);
+  ASSERT_EQ(TARRAY2_SIZE(aggs), 0);
+
+  const TBloomBlkArray *bloomBlkArray = NULL;
+  ASSERT_EQ(tsdbDataFileReadBloomBlk(reader, &bloomBlkArray), 0);
+  ASSERT_EQ(TARRAY2_SIZE(bloomBlkArray), 0);
+
+  SBrinRecord record = {0};
+  record.blockOffset = kFirstBlock;
+  bool  mayContain = false;
+  TSKEY key = blockKey(0, 0) + 1;
+  ASSERT_EQ(tsdbDataFileBlockMayContain(reader, &record, &key, sizeof(key), &mayContain), 0);
+  ASSERT_TRUE(mayContain);
+
+  TARRAY2_DESTROY(aggs, NULL);
+  tsdbDataFileReaderClose(&reader);
+}
+
+// a data block of one table with a timestamp and a bigint column, the values of the bigint column come from valueOf
+static void buildBlockData(STSchema *schema, int32_t nRows, int64_t (*valueOf)(int32_t), SBlockData *bData) {
+  TABLEID tbid = {.suid = 100, .uid = 101};
+  SArray *colVals = taosArrayInit(2, sizeof(SColVal));
+  ASSERT_NE(colVals, nullptr);
+
+  ASSERT_EQ(tBlockDataCreate(bData), 0);
+  ASSERT_EQ(tBlockDataInit(bData, &tbid, schema, NULL, 0), 0);
+  for (int32_t i = 0; i < nRows; i++) {
+    SValue ts = {.type = TSDB_DATA_TYPE_TIMESTAMP};
+    SValue val = {.type = TSDB_DATA_TYPE_BIGINT};
+    ts.val = 1700000000000LL + i * 1000;
+    val.val = valueOf(i);
+
+    SColVal cv[2] = {COL_VAL_VALUE(1, ts), COL_VAL_VALUE(2, val)};
+    taosArrayClear(colVals);
+    ASSERT_NE(taosArrayPush(colVals, &cv[0]), nullptr);
+    ASSERT_NE(taosArrayPush(colVals, &cv[1]), nullptr);
+
+    SRow *row = NULL;
+    ASSERT_EQ(tRowBuild(colVals, schema, &row), 0);
+    TSDBROW tsdbRow = tsdbRowFromTSRow(i + 1, row);
+    ASSERT_EQ(tBlockDataAppendRow(bData, &tsdbRow, schema, tbid.uid), 0);
+    taosMemoryFree(row);
+  }
+  taosArrayDestroy(colVals);
+}
+
+// compress the block and return the algorithm recorded for the bigint column
+static void compressBlockData(SBlockData *bData, SColCompressInfo *info, SBuffer *buffers, uint32_t *alg) {
+  ASSERT_EQ(tBlockDataCompress(bData, info, buffers, buffers + 4), 0);
+
+  SBufferReader br = BUFFER_READER_INITIALIZER(0, &buffers[0]);
+  SDiskDataHdr  hdr = {0};
+  ASSERT_EQ(tGetDiskDataHdr(&br, &hdr), 0);
+
+  br = BUFFER_READER_INITIALIZER(0, &buffers[2]);
+  SBlockCol blockCol = {0};
+  ASSERT_EQ(tGetBlockCol(&br, &blockCol, hdr.fmtVer, hdr.cmprAlg), 0);
+  ASSERT_EQ(blockCol.cid, 2);
+  *alg = blockCol.alg;
+}
+
+static int64_t repeatingValue(int32_t i) { return (i % 16) * 1000000007LL; }
+static int64_t randomValue(int32_t i) { return ((int64_t)taosRand() << 32) | taosRand(); }
+
+TEST(tsdbAdaptiveCompressTest, chooseOncePerFile) {
+  SSchema schemas[2] = {
+      {.type = TSDB_DATA_TYPE_TIMESTAMP, .flags = COL_SMA_ON, .colId = 1, .bytes = 8},
+      {.type = TSDB_DATA_TYPE_BIGINT, .flags = COL_SMA_ON, .colId = 2, .bytes = 8},
+  };
+  STSchema *schema = tBuildTSchema(schemas, 2, 1);
+  ASSERT_NE(schema, nullptr);
+
+  SBuffer buffers[8];
+  for (int32_t i = 0; i < 8; i++) tBufferInit(&buffers[i]);
+
+  uint32_t cfgAlg = 0;
+  SET_COMPRESS(L1_SIMPLE_8B, L2_DISABLED, L2_LVL_MEDIUM, cfgAlg);
+
+  bool adaptive = tsTsdbAdaptiveCompress;
+  tsTsdbAdaptiveCompress = true;
+
+  SBlockData repeating, random, small;
+  buildBlockData(schema, 4096, repeatingValue, &repeating);
+  buildBlockData(schema, 4096, randomValue, &random);
+  buildBlockData(schema, 10, repeatingValue, &small);
+
+  SHashObj *adaptCmpr = taosHashInit(8, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), false, HASH_NO_LOCK);
+  ASSERT_NE(adaptCmpr, nullptr);
+
+  // without a map of the file the configured algorithm is kept
+  uint32_t         alg = 0;
+  SColCompressInfo info = {.pColCmpr = NULL, .defaultCmprAlg = cfgAlg, .pAdaptCmpr = NULL};
+  compressBlockData(&repeating, &info, buffers, &alg);
+  ASSERT_EQ(alg, cfgAlg);
+
+  // a block with too few values does not decide for the file
+  info = {.pColCmpr = NULL, .defaultCmprAlg = cfgAlg, .pAdaptCmpr = adaptCmpr};
+  compressBlockData(&small, &info, buffers, &alg);
+  ASSERT_EQ(alg, cfgAlg);
+  ASSERT_EQ(taosHashGetSize(adaptCmpr), 0);
+
+  // the first block decides, the repeating values compress well with a general purpose compression
+  uint32_t chosen = 0;
+  compressBlockData(&repeating, &info, buffers, &chosen);
+  ASSERT_EQ(taosHashGetSize(adaptCmpr), 1);
+  ASSERT_NE(COMPRESS_L2_TYPE_U32(chosen), L2_DISABLED);
+  ASSERT_NE(COMPRESS_L2_TYPE_U32(chosen), L2_XZ);
+  ASSERT_EQ(COMPRESS_L2_TYPE_LEVEL_U32(chosen), L2_LVL_MEDIUM);
+
+  // and the following blocks of the table reuse the choice without new trials
+  compressBlockData(&random, &info, buffers, &alg);
+  ASSERT_EQ(alg, chosen);
+  ASSERT_EQ(taosHashGetSize(adaptCmpr), 1);
+
+  // the block compressed with the reused algorithm round trips
+  SBuffer whole;
+  tBufferInit(&whole);
+  for (int32_t i = 0; i < 4; i++) {
+    ASSERT_EQ(tBufferPut(&whole, buffers[i].data, buffers[i].size), 0);
+  }
+  SBlockData    out;
+  SBufferReader br = BUFFER_READER_INITIALIZER(0, &whole);
+  ASSERT_EQ(tBlockDataCreate(&out), 0);
+  ASSERT_EQ(tBlockDataDecompress(&br, &out, &buffers[4]), 0);
+  ASSERT_EQ(out.nRow, random.nRow);
+  SColData *expect = tBlockDataGetColData(&random, 2);
+  SColData *actual = tBlockDataGetColData(&out, 2);
+  ASSERT_NE(actual, nullptr);
+  for (int32_t i = 0; i < out.nRow; i++) {
+    ASSERT_EQ(out.aTSKEY[i], random.aTSKEY[i]);
+    SColVal cv1, cv2;
+    ASSERT_EQ(tColDataGetValue(expect, i, &cv1), 0);
+    ASSERT_EQ(tColDataGetValue(actual, i, &cv2), 0);
+    ASSERT_EQ(cv1.value.val, cv2.value.val);
+  }
+
+  // a new configured algorithm for the column is chosen from again
+  uint32_t newCfgAlg = 0;
+  SET_COMPRESS(L1_SIMPLE_8B, L2_DISABLED, L2_LVL_HIGH, newCfgAlg);
+  info.defaultCmprAlg = newCfgAlg;
+  compressBlockData(&repeating, &info, buffers, &alg);
+  ASSERT_EQ(COMPRESS_L2_TYPE_LEVEL_U32(alg), L2_LVL_HIGH);
+  ASSERT_EQ(taosHashGetSize(adaptCmpr), 1);
+
+  tsTsdbAdaptiveCompress = adaptive;
+  taosHashCleanup(adaptCmpr);
+  tBufferDestroy(&whole);
+  tBlockDataDestroy(&out);
+  tBlockDataDestroy(&repeating);
+  tBlockDataDestroy(&random);
+  tBlockDataDestroy(&small);
+  for (int32_t i = 0; i < 8; i++) tBufferDestroy(&buffers[i]);
+  tDestroyTSchema(schema);
+}
+
+namespace {
+
+// the column cache of a vnode-less tsdb, keyed by the data file blocks the columns are read from
+class TsdbColCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    savedCacheSize = tsTsdbBlockCacheSize;
+    tsTsdbBlockCacheSize = 1;
+
+    tsdb = (STsdb *)taosMemoryCalloc(1, sizeof(STsdb));
+    ASSERT_NE(tsdb, nullptr);
+    tsdb->colCache = taosLRUCacheInit(1024 * 1024, 4, .5);
+    ASSERT_NE(tsdb->colCache, nullptr);
+  }
+
+  void TearDown() override {
+    taosLRUCacheEraseUnrefEntries(tsdb->colCache);
+    taosLRUCacheCleanup(tsdb->colCache);
+    taosMemoryFree(tsdb);
+    tsTsdbBlockCacheSize = savedCacheSize;
+  }
+
+  // a bigint column with a null every nullStep rows, no null if nullStep is 0
+  static void makeIntCol(SColData *colData, int16_t cid, int32_t nVal, int32_t nullStep) {
+    tColDataInit(colData, cid, TSDB_DATA_TYPE_BIGINT, 0);
+    for (int32_t i = 0; i < nVal; i++) {
+      SColVal cv;
+      if (nullStep > 0 && i % nullStep == 0) {
+        cv = COL_VAL_NULL(cid, TSDB_DATA_TYPE_BIGINT);
+      } else {
+        SValue value;
+        memset(&value, 0, sizeof(value));
+        value.type = TSDB_DATA_TYPE_BIGINT;
+        value.val = (int64_t)i * 31 - cid;
+        cv = COL_VAL_VALUE(cid, value);
+      }
+      ASSERT_EQ(tColDataAppendValue(colData, &cv), 0);
+    }
+  }
+
+  // a varchar column holding values, nulls and nones, so its bitmap has 2 bits a value
+  static void makeVarCol(SColData *colData, int16_t cid, int32_t nVal) {
+    tColDataInit(colData, cid, TSDB_DATA_TYPE_VARCHAR, 0);
+    for (int32_t i = 0; i < nVal; i++) {
+      char    buf[32];
+      SColVal cv;
+      if (i % 5 == 1) {
+        cv = COL_VAL_NULL(cid, TSDB_DATA_TYPE_VARCHAR);
+      } else if (i % 7 == 2) {
+        cv = COL_VAL_NONE(cid, TSDB_DATA_TYPE_VARCHAR);
+      } else {
+        SValue value;
+        memset(&value, 0, sizeof(value));
+        value.type = TSDB_DATA_TYPE_VARCHAR;
+        value.nData = snprintf(buf, sizeof(buf), "value_%d", i * 13);
+        value.pData = (uint8_t *)buf;
+        cv = COL_VAL_VALUE(cid, value);
+      }
+      ASSERT_EQ(tColDataAppendValue(colData, &cv), 0);
+    }
+  }
+
+  static void checkSameCol(SColData *expect, SColData *colData) {
+    ASSERT_EQ(colData->cid, expect->cid);
+    ASSERT_EQ(colData->type, expect->type);
+    ASSERT_EQ(colData->flag, expect->flag);
+    ASSERT_EQ(colData->nVal, expect->nVal);
+    ASSERT_EQ(colData->nData, expect->nData);
+    for (int32_t i = 0; i < expect->nVal; i++) {
+      SColVal cv1, cv2;
+      ASSERT_EQ(tColDataGetValue(expect, i, &cv1), 0);
+      ASSERT_EQ(tColDataGetValue(colData, i, &cv2), 0);
+      ASSERT_EQ(cv2.flag, cv1.flag);
+      if (!COL_VAL_IS_VALUE(&cv1)) continue;
+      if (IS_VAR_DATA_TYPE(expect->type)) {
+        ASSERT_EQ(cv2.value.nData, cv1.value.nData);
+        ASSERT_EQ(memcmp(cv2.value.pData, cv1.value.pData, cv1.value.nData), 0);
+      } else {
+        ASSERT_EQ(cv2.value.val, cv1.value.val);
+      }
+    }
+  }
+
+  STsdb  *tsdb;
+  int32_t savedCacheSize;
+};
+
+}  // namespace
+
+TEST_F(TsdbColCacheTest, hitAndMiss) {
+  SColData   intCol = {0}, varCol = {0};
+  SBlockData bData = {0};
+  bool       hit = true;
+
+  makeIntCol(&intCol, 2, 1000, 3);
+  makeVarCol(&varCol, 3, 1000);
+
+  // nothing cached yet
+  ASSERT_EQ(tsdbCacheGetColData(tsdb, 1, 7, 4096, 2, &bData, &hit), 0);
+  ASSERT_FALSE(hit);
+  ASSERT_EQ(bData.nColData, 0);
+  ASSERT_EQ(tsdb->colCacheMiss, 1);
+
+  tsdbCacheSetColData(tsdb, 1, 7, 4096, &intCol);
+  tsdbCacheSetColData(tsdb, 1, 7, 4096, &varCol);
+  ASSERT_EQ(taosLRUCacheGetElems(tsdb->colCache), 2);
+
+  // a bigint column with values and nulls is charged with a 1-bit bitmap, a varchar column with all three flags with a
+  // 2-bit bitmap and its offsets
+  ASSERT_EQ(intCol.flag, HAS_VALUE | HAS_NULL);
+  ASSERT_EQ(varCol.flag, HAS_VALUE | HAS_NULL | HAS_NONE);
+  size_t charge = sizeof(SColData) + intCol.nData + BIT1_SIZE(intCol.nVal);
+  charge += sizeof(SColData) + varCol.nData + (varCol.nVal << 2) + BIT2_SIZE(varCol.nVal);
+  ASSERT_EQ(taosLRUCacheGetUsage(tsdb->colCache), charge);
+
+  ASSERT_EQ(tsdbCacheGetColData(tsdb, 1, 7, 4096, 2, &bData, &hit), 0);
+  ASSERT_TRUE(hit);
+  ASSERT_EQ(tsdbCacheGetColData(tsdb, 1, 7, 4096, 3, &bData, &hit), 0);
+  ASSERT_TRUE(hit);
+  ASSERT_EQ(tsdb->colCacheHit, 2);
+  ASSERT_EQ(bData.nColData, 2);
+  checkSameCol(&intCol, &bData.aColData[0]);
+  checkSameCol(&varCol, &bData.aColData[1]);
+
+  // the copies are owned by the block data, the cached columns stay valid after it is destroyed
+  tBlockDataDestroy(&bData);
+  SBlockData bData2 = {0};
+  ASSERT_EQ(tsdbCacheGetColData(tsdb, 1, 7, 4096, 3, &bData2, &hit), 0);
+  ASSERT_TRUE(hit);
+  checkSameCol(&varCol, &bData2.aColData[0]);
+  tBlockDataDestroy(&bData2);
+
+  // any other file, commit or block misses
+  SBlockData bData3 = {0};
+  ASSERT_EQ(tsdbCacheGetColData(tsdb, 2, 7, 4096, 2, &bData3, &hit), 0);
+  ASSERT_FALSE(hit);
+  ASSERT_EQ(tsdbCacheGetColData(tsdb, 1, 8, 4096, 2, &bData3, &hit), 0);
+  ASSERT_FALSE(hit);
+  ASSERT_EQ(tsdbCacheGetColData(tsdb, 1, 7, 8192, 2, &bData3, &hit), 0);
+  ASSERT_FALSE(hit);
+  ASSERT_EQ(tsdbCacheGetColData(tsdb, 1, 7, 4096, 4, &bData3, &hit), 0);
+  ASSERT_FALSE(hit);
+  ASSERT_EQ(bData3.nColData, 0);
+  ASSERT_EQ(tsdb->colCacheMiss, 5);
+  tBlockDataDestroy(&bData3);
+
+  tColDataDestroy(&intCol);
+  tColDataDestroy(&varCol);
+}
+
+TEST_F(TsdbColCacheTest, eviction) {
+  SColData colData = {0};
+  makeIntCol(&colData, 2, 1000, 0);
+
+  // about 8KB a column, 8MB in total for a 1MB cache
+  const int32_t numOfBlocks = 1000;
+  for (int32_t b = 0; b < numOfBlocks; b++) {
+    tsdbCacheSetColData(tsdb, 1, 7, (int64_t)b * 8192, &colData);
+  }
+  ASSERT_LE(taosLRUCacheGetUsage(tsdb->colCache), (size_t)1024 * 1024);
+  ASSERT_LT(taosLRUCacheGetElems(tsdb->colCache), numOfBlocks);
+
+  // the oldest blocks are evicted and the latest one is kept
+  SBlockData bData = {0};
+  bool       hit = true;
+  ASSERT_EQ(tsdbCacheGetColData(tsdb, 1, 7, 0, 2, &bData, &hit), 0);
+  ASSERT_FALSE(hit);
+  ASSERT_EQ(tsdbCacheGetColData(tsdb, 1, 7, (int64_t)(numOfBlocks - 1) * 8192, 2, &bData, &hit), 0);
+  ASSERT_TRUE(hit);
+  checkSameCol(&colData, &bData.aColData[0]);
+  tBlockDataDestroy(&bData);
+
+  // the cache is resized to the option on the next put
+  tsTsdbBlockCacheSize = 2;
+  tsdbCacheSetColData(tsdb, 1, 7, (int64_t)numOfBlocks * 8192, &colData);
+  ASSERT_EQ(taosLRUCacheGetCapacity(tsdb->colCache), (size_t)2 * 1024 * 1024);
+
+  tColDataDestroy(&colData);
+}
+
+TEST_F(TsdbColCacheTest, disabled) {
+  SColData colData = {0};
+  makeIntCol(&colData, 2, 100, 0);
+
+  tsTsdbBlockCacheSize = 0;
+  tsdbCacheSetColData(tsdb, 1, 7, 4096, &colData);
+  ASSERT_EQ(taosLRUCacheGetElems(tsdb->colCache), 0);
+
+  SBlockData bData = {0};
+  bool       hit = true;
+  ASSERT_EQ(tsdbCacheGetColData(tsdb, 1, 7, 4096, 2, &bData, &hit), 0);
+  ASSERT_FALSE(hit);
+  ASSERT_EQ(tsdb->colCacheMiss, 0);
+
+  tBlockDataDestroy(&bData);
+  tColDataDestroy(&colData);
+}
+
+namespace {
+
+// the stt files of a file set only count for the trigger, so the file objects are never dereferenced
+void addSttFiles(STFileSet *fset, int32_t level, int32_t numFile) {
+  SSttLvl *lvl = NULL;
+  ASSERT_EQ(tsdbSttLvlInit(level, &lvl), 0);
+  for (int32_t i = 0; i < numFile; i++) {
+    STFileObj *fobj = (STFileObj *)(uintptr_t)(0x1000 + i);
+    ASSERT_EQ(TARRAY2_APPEND(lvl->fobjArr, fobj), 0);
+  }
+  ASSERT_EQ(TARRAY2_APPEND(fset->lvlArr, lvl), 0);
+}
+
+void clearFSet(STFileSet **fset) {
+  SSttLvl *lvl;
+  TARRAY2_FOREACH((*fset)->lvlArr, lvl) { TARRAY2_CLEAR(lvl->fobjArr, NULL); }
+  tsdbTFileSetClear(fset);
+}
+
+}  // namespace
+
+TEST(TsdbFSetSttTriggerTest, hotAndCold) {
+  SVnode vnode;
+  STsdb  tsdb;
+  memset(&vnode, 0, sizeof(vnode));
+  memset(&tsdb, 0, sizeof(tsdb));
+  tsdb.pVnode = &vnode;
+  tsdb.keepCfg.precision = TSDB_TIME_PRECISION_MILLI;
+  tsdb.keepCfg.days = 1440;
+  vnode.config.sttTrigger = 3;
+
+  int32_t savedWatermark = tsTsdbDisorderWatermark;
+  int64_t now = taosGetTimestampMs();
+
+  // a file set of today takes in-order rows, one of a month ago only late rows
+  STFileSet *hot = NULL, *cold = NULL, *layered = NULL, *full = NULL;
+  ASSERT_EQ(tsdbTFileSetInit(tsdbKeyFid(now, 1440, TSDB_TIME_PRECISION_MILLI), &hot), 0);
+  ASSERT_EQ(tsdbTFileSetInit(tsdbKeyFid(now - 30 * 86400000LL, 1440, TSDB_TIME_PRECISION_MILLI), &cold), 0);
+  ASSERT_EQ(tsdbTFileSetInit(cold->fid, &layered), 0);
+  ASSERT_EQ(tsdbTFileSetInit(cold->fid, &full), 0);
+  addSttFiles(hot, 0, 2);
+  addSttFiles(cold, 0, 2);
+  addSttFiles(layered, 0, 2);
+  addSttFiles(layered, 1, 2);
+  addSttFiles(layered, 2, 3);
+  addSttFiles(full, 0, 1);
+  addSttFiles(full, 1, 14);
+
+  // no watermark
+  tsTsdbDisorderWatermark = 0;
+  ASSERT_EQ(tsdbFSetSttTrigger(&tsdb, hot), 3);
+  ASSERT_EQ(tsdbFSetSttTrigger(&tsdb, cold), 3);
+
+  // the hot path keeps the trigger of the vnode, the cold one enlarges it
+  tsTsdbDisorderWatermark = 7 * 86400;
+  ASSERT_EQ(tsdbFSetSttTrigger(&tsdb, hot), 3);
+  ASSERT_EQ(tsdbFSetSttTrigger(&tsdb, cold), 12);
+
+  // the stt files of the upper levels are merged by readers too, so they lower the trigger of a cold file set, but
+  // never below the trigger of the vnode
+  ASSERT_EQ(tsdbFSetSttTrigger(&tsdb, layered), 11);
+  ASSERT_EQ(tsdbFSetSttTrigger(&tsdb, full), 3);
+
+  // a large trigger is capped by the stt files a reader merges
+  vnode.config.sttTrigger = 8;
+  ASSERT_EQ(tsdbFSetSttTrigger(&tsdb, hot), 8);
+  ASSERT_EQ(tsdbFSetSttTrigger(&tsdb, cold), 16);
+  ASSERT_EQ(tsdbFSetSttTrigger(&tsdb, full), 8);
+
+  // no merge at all
+  vnode.config.sttTrigger = 1;
+  ASSERT_EQ(tsdbFSetSttTrigger(&tsdb, cold), 1);
+
+  tsTsdbDisorderWatermark = savedWatermark;
+  clearFSet(&hot);
+  clearFSet(&cold);
+  clearFSet(&layered);
+  clearFSet(&full);
+}
+
+#pragma GCC diagnostic pop
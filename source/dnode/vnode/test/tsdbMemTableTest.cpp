@@ -0,0 +1,366 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <taoserror.h>
+#include <tglobal.h>
+
+#include "tsdb.h"
+#include "vnd.h"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+
+namespace {
+
+const tb_uid_t kSuid = 1001;
+const tb_uid_t kUid = 2001;
+const int8_t   kSlLevel = 5;
+const TSKEY    kStartTs = 1700000000000LL;
+
+typedef std::pair<TSKEY, int64_t>           TsValue;
+typedef std::tuple<TSKEY, int64_t, int64_t> MemRow;  // ts, version and value of a row in the memtable
+
+// the memtable of one table of a vnode-less tsdb, written through tsdbInsertTableData and read through the table data
+// iterator, with a timestamp and a bigint column
+class TsdbMemTableTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    vnode = (SVnode *)taosMemoryCalloc(1, sizeof(SVnode));
+    ASSERT_NE(vnode, nullptr);
+    vnode->config.vgId = 2;
+    vnode->config.szBuf = VNODE_BUFPOOL_SEGMENTS * 1024 * 1024;
+    vnode->config.tsdbCfg.slLevel = kSlLevel;
+    ASSERT_EQ(taosThreadCondInit(&vnode->poolNotEmpty, NULL), 0);
+    ASSERT_EQ(vnodeOpenBufPool(vnode), 0);
+    vnode->inUse = vnode->freeList;
+    vnode->freeList = vnode->inUse->freeNext;
+    vnode->inUse->freeNext = NULL;
+
+    tsdb = (STsdb *)taosMemoryCalloc(1, sizeof(STsdb));
+    ASSERT_NE(tsdb, nullptr);
+    tsdb->pVnode = vnode;
+    ASSERT_EQ(tsdbMemTableCreate(tsdb, &tsdb->mem), 0);
+
+    SSchema schema[2];
+    memset(schema, 0, sizeof(schema));
+    schema[0].type = TSDB_DATA_TYPE_TIMESTAMP;
+    schema[0].colId = PRIMARYKEY_TIMESTAMP_COL_ID;
+    schema[0].bytes = sizeof(TSKEY);
+    schema[1].type = TSDB_DATA_TYPE_BIGINT;
+    schema[1].colId = PRIMARYKEY_TIMESTAMP_COL_ID + 1;
+    schema[1].bytes = sizeof(int64_t);
+    pTSchema = tBuildTSchema(schema, 2, 1);
+    ASSERT_NE(pTSchema, nullptr);
+  }
+
+  void TearDown() override {
+    if (tsdb != NULL) {
+      tsdbMemTableDestroy(tsdb->mem, false);
+    }
+    if (vnode != NULL) {
+      vnode->inUse = NULL;
+      vnodeCloseBufPool(vnode);
+      (void)taosThreadCondDestroy(&vnode->poolNotEmpty);
+    }
+    taosMemoryFree(pTSchema);
+    taosMemoryFree(tsdb);
+    taosMemoryFree(vnode);
+  }
+
+  SColVal colVal(int32_t iCol, int64_t v) {
+    SValue value;
+    memset(&value, 0, sizeof(value));
+    value.type = pTSchema->columns[iCol].type;
+    value.val = v;
+    return COL_VAL_VALUE(pTSchema->columns[iCol].colId, value);
+  }
+
+  void insert(SSubmitTbData *submit, int64_t version, const std::vector<TsValue> &rows) {
+    int32_t affectedRows = 0;
+
+    submit->suid = kSuid;
+    submit->uid = kUid;
+    submit->sver = pTSchema->version;
+    ASSERT_EQ(tsdbInsertTableData(tsdb, version, submit, &affectedRows), 0);
+    ASSERT_EQ(affectedRows, (int32_t)rows.size());
+    for (const TsValue &row : rows) {
+      expect.push_back(MemRow(row.first, version, row.second));
+    }
+  }
+
+  // one column-format submit of the rows, in the given order
+  void insertCols(int64_t version, const std::vector<TsValue> &rows) {
+    SColData aColData[2];
+    SArray  *aCol = taosArrayInit(2, sizeof(SColData));
+    ASSERT_NE(aCol, nullptr);
+
+    tColDataInit(&aColData[0], pTSchema->columns[0].colId, pTSchema->columns[0].type, 0);
+    tColDataInit(&aColData[1], pTSchema->columns[1].colId, pTSchema->columns[1].type, 0);
+    for (const TsValue &row : rows) {
+      SColVal ts = colVal(0, row.first);
+      SColVal val = colVal(1, row.second);
+      ASSERT_EQ(tColDataAppendValue(&aColData[0], &ts), 0);
+      ASSERT_EQ(tColDataAppendValue(&aColData[1], &val), 0);
+    }
+    ASSERT_NE(taosArrayPush(aCol, &aColData[0]), nullptr);
+    ASSERT_NE(taosArrayPush(aCol, &aColData[1]), nullptr);
+
+    SSubmitTbData submit = {0};
+    submit.flags = SUBMIT_REQ_COLUMN_DATA_FORMAT;
+    submit.aCol = aCol;
+    insert(&submit, version, rows);
+
+    taosArrayDestroyEx(aCol, tColDataDestroy);
+  }
+
+  // one row-format submit of the rows, in the given order
+  void insertRows(int64_t version, const std::vector<TsValue> &rows) {
+    SArray *aRowP = taosArrayInit(rows.size(), POINTER_BYTES);
+    SArray *aColVal = taosArrayInit(2, sizeof(SColVal));
+    ASSERT_NE(aRowP, nullptr);
+    ASSERT_NE(aColVal, nullptr);
+
+    for (const TsValue &row : rows) {
+      SColVal ts = colVal(0, row.first);
+      SColVal val = colVal(1, row.second);
+      SRow   *pRow = NULL;
+
+      taosArrayClear(aColVal);
+      ASSERT_NE(taosArrayPush(aColVal, &ts), nullptr);
+      ASSERT_NE(taosArrayPush(aColVal, &val), nullptr);
+      ASSERT_EQ(tRowBuild(aColVal, pTSchema, &pRow), 0);
+      ASSERT_NE(taosArrayPush(aRowP, &pRow), nullptr);
+    }
+    taosArrayDestroy(aColVal);
+
+    SSubmitTbData submit = {0};
+    submit.aRowP = aRowP;
+    insert(&submit, version, rows);
+
+    for (int32_t i = 0; i < TARRAY_SIZE(aRowP); i++) {
+      tRowDestroy(*(SRow **)taosArrayGet(aRowP, i));
+    }
+    taosArrayDestroy(aRowP);
+  }
+
+  STbData *tbData() { return tsdbGetTbDataFromMemTable(tsdb->mem, kSuid, kUid); }
+
+  // the rows of the table in the iterator order, from the first or last row, or from the key if any
+  std::vector<MemRow> scan(int8_t backward, const TSKEY *from = nullptr) {
+    std::vector<MemRow> rows;
+    STbDataIter         iter;
+    STsdbRowKey         key;
+
+    memset(&key, 0, sizeof(key));
+    if (from != nullptr) {
+      // the same key as a reader of all versions opens the iterator with
+      key.key.ts = *from;
+      key.version = backward ? VERSION_MAX : VERSION_MIN;
+    }
+
+    tsdbTbDataIterOpen(tbData(), from != nullptr ? &key : NULL, backward, &iter);
+    for (TSDBROW *pRow; (pRow = tsdbTbDataIterGet(&iter)) != NULL; (void)tsdbTbDataIterNext(&iter)) {
+      SColVal cv;
+      tsdbRowGetColVal(pRow, pTSchema, 1, &cv);
+      rows.push_back(MemRow(TSDBROW_TS(pRow), TSDBROW_VERSION(pRow), cv.value.val));
+    }
+    return rows;
+  }
+
+  // the number of skiplist nodes of the table, a chunk of rows is one node
+  int32_t countNodes() {
+    STbData          *pTbData = tbData();
+    SMemSkipListNode *pNode = pTbData->sl.pHead->forwards[0];
+    int32_t           nNode = 0;
+
+    for (; pNode != pTbData->sl.pTail; pNode = pNode->forwards[0]) {
+      nNode++;
+    }
+    return nNode;
+  }
+
+  /**
+   * A forward scan returns all the rows put in ascending key order, a backward scan the same rows in the reverse order,
+   * and a scan from a key returns the part of them on the key side of the scan.
+   */
+  void checkScan(const std::vector<TSKEY> &probes) {
+    std::vector<MemRow> forward = scan(0);
+    std::vector<MemRow> backward = scan(1);
+
+    ASSERT_EQ(forward.size(), expect.size());
+    ASSERT_EQ(tsdbGetNRowsInTbData(tbData()), (int32_t)expect.size());
+    for (size_t i = 1; i < forward.size(); i++) {
+      ASSERT_LE(std::get<0>(forward[i - 1]), std::get<0>(forward[i])) << "row:" << i;
+    }
+
+    std::vector<MemRow> sorted(forward);
+    std::vector<MemRow> sortedExpect(expect);
+    std::sort(sorted.begin(), sorted.end());
+    std::sort(sortedExpect.begin(), sortedExpect.end());
+    ASSERT_EQ(sorted, sortedExpect);
+
+    std::reverse(backward.begin(), backward.end());
+    ASSERT_EQ(backward, forward);
+
+    for (TSKEY probe : probes) {
+      std::vector<MemRow> after, before;
+      for (const MemRow &row : forward) {
+        if (std::get<0>(row) >= probe) after.push_back(row);
+      }
+      for (auto it = forward.rbegin(); it != forward.rend(); ++it) {
+        if (std::get<0>(*it) <= probe) before.push_back(*it);
+      }
+      ASSERT_EQ(scan(0, &probe), after) << "probe:" << probe - kStartTs;
+      ASSERT_EQ(scan(1, &probe), before) << "probe:" << probe - kStartTs;
+    }
+  }
+
+  SVnode             *vnode = NULL;
+  STsdb              *tsdb = NULL;
+  STSchema           *pTSchema = NULL;
+  std::vector<MemRow> expect;
+};
+
+std::vector<TsValue> makeRows(int32_t nRow, TSKEY start, TSKEY step, int64_t value) {
+  std::vector<TsValue> rows;
+  for (int32_t i = 0; i < nRow; i++) {
+    rows.push_back(TsValue(start + i * step, value + i));
+  }
+  return rows;
+}
+
+}  // namespace
+
+TEST_F(TsdbMemTableTest, rowsOutOfOrder) {
+  std::vector<TsValue> rows = makeRows(300, kStartTs, 7, 0);
+  std::vector<TsValue> batch;
+
+  // batches of rows arriving in random order, each batch sorted in the submit as the client does
+  uint32_t seed = 7;
+  for (size_t i = rows.size(); i > 1; i--) {
+    std::swap(rows[i - 1], rows[taosRandR(&seed) % i]);
+  }
+  for (size_t i = 0; i < rows.size(); i += 50) {
+    batch.assign(rows.begin() + i, rows.begin() + std::min(i + 50, rows.size()));
+    std::sort(batch.begin(), batch.end());
+    insertRows(100 + i, batch);
+  }
+
+  // and a column-format block in descending order, which is put row by row
+  batch = makeRows(40, kStartTs + 3, 7, 1000);
+  std::reverse(batch.begin(), batch.end());
+  insertCols(1000, batch);
+
+  ASSERT_EQ(countNodes(), (int32_t)expect.size());
+  checkScan({kStartTs - 1, kStartTs, kStartTs + 3, kStartTs + 700, kStartTs + 701, kStartTs + 2093, kStartTs + 5000});
+}
+
+TEST_F(TsdbMemTableTest, overwrite) {
+  // the same keys written again by later versions, as rows and as blocks, are all kept for the readers to merge
+  insertRows(1, makeRows(100, kStartTs, 10, 0));
+  insertRows(2, makeRows(20, kStartTs + 200, 10, 500));
+  insertCols(3, makeRows(30, kStartTs + 500, 10, 800));
+  insertCols(4, makeRows(10, kStartTs + 550, 10, 900));
+
+  std::vector<MemRow> forward = scan(0);
+  for (size_t i = 1; i < forward.size(); i++) {
+    if (std::get<0>(forward[i - 1]) == std::get<0>(forward[i])) {
+      ASSERT_NE(std::get<1>(forward[i - 1]), std::get<1>(forward[i]));
+    }
+  }
+  checkScan({kStartTs + 200, kStartTs + 390, kStartTs + 500, kStartTs + 555, kStartTs + 640, kStartTs + 790});
+}
+
+TEST_F(TsdbMemTableTest, chunkOfInOrderBlock) {
+  // an in-order block is one node, and so is the next one after it
+  insertCols(1, makeRows(100, kStartTs, 10, 0));
+  ASSERT_EQ(countNodes(), 1);
+  ASSERT_EQ(tbData()->sl.pHead->forwards[0]->nRow, 100);
+  insertCols(2, makeRows(100, kStartTs + 1000, 10, 100));
+  ASSERT_EQ(countNodes(), 2);
+
+  // a block before the others is a chunk too
+  insertCols(3, makeRows(50, kStartTs - 1000, 10, 200));
+  ASSERT_EQ(countNodes(), 3);
+  checkScan({kStartTs - 1000, kStartTs - 505, kStartTs, kStartTs + 995, kStartTs + 1000, kStartTs + 1990});
+
+  // a single row is never a chunk
+  insertCols(4, makeRows(1, kStartTs + 5000, 10, 300));
+  ASSERT_EQ(countNodes(), 4);
+  checkScan({kStartTs + 1990, kStartTs + 5000});
+}
+
+TEST_F(TsdbMemTableTest, chunkSplit) {
+  insertCols(1, makeRows(100, kStartTs, 10, 0));
+  insertCols(2, makeRows(100, kStartTs + 1000, 10, 100));
+  ASSERT_EQ(countNodes(), 2);
+
+  // a row into the middle of the first chunk splits it around the row
+  insertRows(3, makeRows(1, kStartTs + 455, 10, 1000));
+  ASSERT_EQ(countNodes(), 4);
+  checkScan({kStartTs + 450, kStartTs + 455, kStartTs + 460});
+
+  // an overwrite of a key inside a chunk, and a block interleaving with both chunks
+  insertRows(4, makeRows(1, kStartTs + 700, 10, 2000));
+  insertCols(5, makeRows(30, kStartTs + 905, 5, 3000));
+  checkScan({kStartTs, kStartTs + 700, kStartTs + 905, kStartTs + 995, kStartTs + 1000, kStartTs + 1050,
+             kStartTs + 1990});
+
+  // an iterator opened before the split keeps walking the old chunk
+  STbDataIter iter;
+  TSKEY       from = kStartTs + 1500;
+  STsdbRowKey key;
+  memset(&key, 0, sizeof(key));
+  key.key.ts = from;
+  tsdbTbDataIterOpen(tbData(), &key, 0, &iter);
+  insertRows(6, makeRows(1, kStartTs + 1705, 10, 4000));
+  for (TSKEY ts = from; ts < kStartTs + 2000; ts += 10) {
+    TSDBROW *pRow = tsdbTbDataIterGet(&iter);
+    ASSERT_NE(pRow, nullptr);
+    ASSERT_EQ(TSDBROW_TS(pRow), ts);
+    (void)tsdbTbDataIterNext(&iter);
+  }
+  ASSERT_EQ(tsdbTbDataIterGet(&iter), nullptr);
+  checkScan({kStartTs + 1700, kStartTs + 1705, kStartTs + 1710});
+}
+
+TEST_F(TsdbMemTableTest, levelGrowsWithRows) {
+  // rows put one node each, the level grows before the batch after the table holds 4^level rows
+  std::vector<TsValue> rows = makeRows(1500, kStartTs, 2, 0);
+  std::reverse(rows.begin(), rows.end());
+  insertCols(1, rows);
+  ASSERT_EQ(tbData()->sl.maxLevel, kSlLevel);
+
+  rows = makeRows(1500, kStartTs + 1, 2, 5000);
+  std::reverse(rows.begin(), rows.end());
+  insertCols(2, rows);
+  ASSERT_EQ(tbData()->sl.maxLevel, kSlLevel + 1);
+  ASSERT_LE(tbData()->sl.level, tbData()->sl.maxLevel);
+  checkScan({kStartTs, kStartTs + 1001, kStartTs + 2998, kStartTs + 2999});
+}
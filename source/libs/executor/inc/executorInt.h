@@ -283,6 +283,7 @@ typedef struct STableScanInfo {
   bool            hasGroupByTag;
   bool            filesetDelimited;
   bool            needCountEmptyTable;
+  SArray*         pFilterCols;  // data columns referred by the filter, NULL if it refers to tags or pseudo columns
 } STableScanInfo;
 
 typedef enum ESubTableInputType {
@@ -56,6 +56,7 @@ typedef struct SHJoinCtx {
   int32_t      probeStartIdx;
   int32_t      probeEndIdx;
   int32_t      probePostIdx;
+  int8_t*      pProbeSkip;
   bool         readMatch;
 } SHJoinCtx;
 
@@ -71,13 +72,6 @@ typedef struct SHJoinColInfo {
   SColumnInfoData* colData;
 } SHJoinColInfo;
 
-typedef struct SBufPageInfo {
-  int32_t pageSize;
-  int32_t offset;
-  char*   data;
-} SBufPageInfo;
-
-
 typedef struct SGroupData {
   SBufRowInfo* rows;
 } SGroupData;
@@ -127,10 +121,20 @@ typedef struct SHJoinExecInfo {
   int64_t buildBlkRows;
   int64_t probeBlkNum;
   int64_t probeBlkRows;
+  int64_t probeSkipRows;
   int64_t resRows;
   int64_t expectRows;
 } SHJoinExecInfo;
 
+// value range of the first key column on the build side, used to skip probe rows before the hash lookup
+typedef struct SHJoinKeyRange {
+  bool    disabled;
+  bool    valid;
+  int8_t  type;
+  int64_t minVal;
+  int64_t maxVal;
+} SHJoinKeyRange;
+
 
 typedef struct SHJoinOperatorInfo {
   EJoinType        joinType;
@@ -145,9 +149,17 @@ typedef struct SHJoinOperatorInfo {
   STimeWindow      tblTimeRange;
   int32_t          pResColNum;
   int8_t*          pResColMap;
-  SArray*          pRowBufs;
+  SDiskbasedBuf*   pRowBuf;      // build side row values, pages beyond hashJoinMemThreshold are spilled to disk
+  char*            pWritePage;
+  int32_t          writePageId;
+  int32_t          writeOffset;
+  char*            pReadPage;
+  int32_t          readPageId;
   SSHashObj*       pKeyHash;
   bool             keyHashBuilt;
+  SHJoinKeyRange   keyRange;
+  int8_t*          probeSkip;
+  int32_t          probeSkipCap;
   SHJoinCtx        ctx;
   SHJoinExecInfo   execInfo;
   int32_t          blkThreshold;
@@ -29,6 +29,27 @@
 #include "thash.h"
 #include "ttypes.h"
 
+// Rows of a block are clustered by group key when the block holds many repeated keys that are not adjacent, so that
+// each group of the block costs one result row lookup and one call of the aggregate functions on a contiguous range
+// instead of one per row.
+#define GROUP_CLUSTER_MIN_ROWS     64
+#define GROUP_CLUSTER_PROBE_BLOCKS 16
+#define GROUP_HASH_NULL            0x5bd1e9955bd1e995ULL
+
+typedef struct SGroupClusterInfo {
+  bool      disabled;       // turned off when blocks hardly ever hold repeated keys
+  int32_t   probeBlocks;    // number of blocks whose keys are hashed
+  int32_t   clusterBlocks;  // number of blocks that are clustered
+  int32_t   capacity;       // number of rows the buffers below are allocated for
+  int32_t   numOfSlots;
+  uint64_t* pHash;          // hash of the group key of each row
+  int32_t*  pRowGroup;      // group of each row
+  int32_t*  pGroupRow;      // first row of each group
+  int32_t*  pGroupOffset;   // start row of each group after clustering
+  int32_t*  pIndex;         // source row of each row after clustering
+  int32_t*  pSlots;         // open addressing table of groups, group + 1, 0 means empty
+} SGroupClusterInfo;
+
 typedef struct SGroupbyOperatorInfo {
   SOptrBasicInfo binfo;
   SAggSupporter  aggSup;
@@ -40,6 +61,7 @@ typedef struct SGroupbyOperatorInfo {
   SGroupResInfo  groupResInfo;
   SExprSupp      scalarSup;
   SOperatorInfo  *pOperator;
+  SGroupClusterInfo cluster;     // clustering of the rows of a block by group key
 } SGroupbyOperatorInfo;
 
 // The sort in partition may be needed later.
@@ -69,6 +91,7 @@ static int32_t* setupColumnOffset(const SSDataBlock* pBlock, int32_t rowCapacity
 static int32_t  setGroupResultOutputBuf(SOperatorInfo* pOperator, SOptrBasicInfo* binfo, int32_t numOfCols, char* pData,
                                         int32_t bytes, uint64_t groupId, SDiskbasedBuf* pBuf, SAggSupporter* pAggSup);
 static int32_t  extractColumnInfo(SNodeList* pNodeList, SArray** pArrayRes);
+static void     destroyGroupClusterInfo(SGroupClusterInfo* pCluster);
 
 static void freeGroupKey(void* param) {
   SGroupKeys* pKey = (SGroupKeys*)param;
@@ -86,6 +109,7 @@ static void destroyGroupOperatorInfo(void* param) {
   taosArrayDestroy(pInfo->pGroupCols);
   taosArrayDestroyEx(pInfo->pGroupColVals, freeGroupKey);
   cleanupExprSupp(&pInfo->scalarSup);
+  destroyGroupClusterInfo(&pInfo->cluster);
 
   if (pInfo->pOperator != NULL) {
     cleanupResultInfo(pInfo->pOperator->pTaskInfo, &pInfo->pOperator->exprSupp, &pInfo->groupResInfo, &pInfo->aggSup,
@@ -285,6 +309,238 @@ static void doAssignGroupKeys(SqlFunctionCtx* pCtx, int32_t numOfOutput, int32_t
   }
 }
 
+static void destroyGroupClusterInfo(SGroupClusterInfo* pCluster) {
+  taosMemoryFreeClear(pCluster->pHash);
+  taosMemoryFreeClear(pCluster->pRowGroup);
+  taosMemoryFreeClear(pCluster->pGroupRow);
+  taosMemoryFreeClear(pCluster->pGroupOffset);
+  taosMemoryFreeClear(pCluster->pIndex);
+  taosMemoryFreeClear(pCluster->pSlots);
+  pCluster->capacity = 0;
+  pCluster->numOfSlots = 0;
+}
+
+static int32_t ensureGroupClusterCapacity(SGroupClusterInfo* pCluster, int32_t rows) {
+  if (rows <= pCluster->capacity) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  int32_t numOfSlots = 1;
+  while (numOfSlots < rows * 2) {
+    numOfSlots <<= 1;
+  }
+
+  destroyGroupClusterInfo(pCluster);
+  pCluster->pHash = taosMemoryMalloc(rows * sizeof(uint64_t));
+  pCluster->pRowGroup = taosMemoryMalloc(rows * sizeof(int32_t));
+  pCluster->pGroupRow = taosMemoryMalloc(rows * sizeof(int32_t));
+  pCluster->pGroupOffset = taosMemoryMalloc((rows + 1) * sizeof(int32_t));
+  pCluster->pIndex = taosMemoryMalloc(rows * sizeof(int32_t));
+  pCluster->pSlots = taosMemoryMalloc(numOfSlots * sizeof(int32_t));
+  if (pCluster->pHash == NULL || pCluster->pRowGroup == NULL || pCluster->pGroupRow == NULL ||
+      pCluster->pGroupOffset == NULL || pCluster->pIndex == NULL || pCluster->pSlots == NULL) {
+    destroyGroupClusterInfo(pCluster);
+    return terrno;
+  }
+
+  pCluster->capacity = rows;
+  pCluster->numOfSlots = numOfSlots;
+  return TSDB_CODE_SUCCESS;
+}
+
+static FORCE_INLINE uint64_t groupHashMix(uint64_t h, uint64_t v) {
+  h = (h ^ v) * 0x9E3779B97F4A7C15ULL;
+  return h ^ (h >> 32);
+}
+
+// hash the group keys of all rows of the block, one key column at a time
+static void hashGroupKeyColumns(SArray* pGroupCols, SSDataBlock* pBlock, uint64_t* pHash) {
+  int32_t rows = pBlock->info.rows;
+  int32_t numOfGroupCols = taosArrayGetSize(pGroupCols);
+
+  memset(pHash, 0, rows * sizeof(uint64_t));
+  for (int32_t i = 0; i < numOfGroupCols; ++i) {
+    SColumn*         pCol = taosArrayGet(pGroupCols, i);
+    SColumnInfoData* pColInfoData = taosArrayGet(pBlock->pDataBlock, pCol->slotId);
+
+    if (IS_VAR_DATA_TYPE(pColInfoData->info.type)) {
+      for (int32_t j = 0; j < rows; ++j) {
+        if (colDataIsNull_var(pColInfoData, j)) {
+          pHash[j] = groupHashMix(pHash[j], GROUP_HASH_NULL);
+        } else {
+          char* val = pColInfoData->pData + pColInfoData->varmeta.offset[j];
+          pHash[j] = groupHashMix(pHash[j], MurmurHash3_32(varDataVal(val), varDataLen(val)));
+        }
+      }
+    } else {
+      int32_t bytes = pColInfoData->info.bytes;
+      bool    hasNull = pColInfoData->hasNull;
+      for (int32_t j = 0; j < rows; ++j) {
+        if (hasNull && colDataIsNull_f(pColInfoData->nullbitmap, j)) {
+          pHash[j] = groupHashMix(pHash[j], GROUP_HASH_NULL);
+        } else if (bytes <= sizeof(uint64_t)) {
+          uint64_t v = 0;
+          memcpy(&v, pColInfoData->pData + j * bytes, bytes);
+          pHash[j] = groupHashMix(pHash[j], v);
+        } else {
+          pHash[j] = groupHashMix(pHash[j], MurmurHash3_32(pColInfoData->pData + j * bytes, bytes));
+        }
+      }
+    }
+  }
+}
+
+static bool groupKeyRowEqual(SArray* pGroupCols, SSDataBlock* pBlock, int32_t row1, int32_t row2) {
+  int32_t numOfGroupCols = taosArrayGetSize(pGroupCols);
+  for (int32_t i = 0; i < numOfGroupCols; ++i) {
+    SColumn*         pCol = taosArrayGet(pGroupCols, i);
+    SColumnInfoData* pColInfoData = taosArrayGet(pBlock->pDataBlock, pCol->slotId);
+
+    bool isNull1 = colDataIsNull_s(pColInfoData, row1);
+    bool isNull2 = colDataIsNull_s(pColInfoData, row2);
+    if (isNull1 != isNull2) {
+      return false;
+    }
+    if (isNull1) {
+      continue;
+    }
+
+    char* val1 = colDataGetData(pColInfoData, row1);
+    char* val2 = colDataGetData(pColInfoData, row2);
+    if (IS_VAR_DATA_TYPE(pColInfoData->info.type)) {
+      if (varDataLen(val1) != varDataLen(val2) || memcmp(varDataVal(val1), varDataVal(val2), varDataLen(val1)) != 0) {
+        return false;
+      }
+    } else if (memcmp(val1, val2, pColInfoData->info.bytes) != 0) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Assign the rows of the block to groups with a block local open addressing table, and reorder the block so that the
+// rows of each group are contiguous while keeping their relative order. The number of groups is returned in
+// pNumOfGroups, 0 means the block is left untouched because clustering would not save anything.
+static int32_t clusterRowsByGroupKey(SGroupbyOperatorInfo* pInfo, SSDataBlock* pBlock, int32_t* pNumOfGroups) {
+  SGroupClusterInfo* pCluster = &pInfo->cluster;
+  int32_t            rows = pBlock->info.rows;
+  int32_t            numOfGroups = 0;
+  int32_t            numOfRuns = 0;
+
+  *pNumOfGroups = 0;
+  if (pCluster->disabled || rows < GROUP_CLUSTER_MIN_ROWS || pBlock->pBlockAgg != NULL) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  int32_t code = ensureGroupClusterCapacity(pCluster, rows);
+  if (code != TSDB_CODE_SUCCESS) {
+    return code;
+  }
+
+  hashGroupKeyColumns(pInfo->pGroupCols, pBlock, pCluster->pHash);
+
+  int32_t mask = pCluster->numOfSlots - 1;
+  memset(pCluster->pSlots, 0, pCluster->numOfSlots * sizeof(int32_t));
+  for (int32_t j = 0; j < rows; ++j) {
+    uint64_t h = pCluster->pHash[j];
+    int32_t  slot = (int32_t)(h & mask);
+    int32_t  group = -1;
+
+    while (pCluster->pSlots[slot] != 0) {
+      int32_t g = pCluster->pSlots[slot] - 1;
+      int32_t first = pCluster->pGroupRow[g];
+      if (pCluster->pHash[first] == h && groupKeyRowEqual(pInfo->pGroupCols, pBlock, first, j)) {
+        group = g;
+        break;
+      }
+      slot = (slot + 1) & mask;
+    }
+
+    if (group < 0) {
+      group = numOfGroups++;
+      pCluster->pSlots[slot] = group + 1;
+      pCluster->pGroupRow[group] = j;
+      pCluster->pGroupOffset[group] = 0;
+    }
+
+    if (j == 0 || pCluster->pRowGroup[j - 1] != group) {
+      numOfRuns += 1;
+    }
+    pCluster->pRowGroup[j] = group;
+    pCluster->pGroupOffset[group] += 1;
+  }
+
+  pCluster->probeBlocks += 1;
+
+  // keys are unique or already adjacent, the row by row path costs the same
+  if (numOfRuns < numOfGroups * 2) {
+    if (pCluster->probeBlocks >= GROUP_CLUSTER_PROBE_BLOCKS && pCluster->clusterBlocks * 4 < pCluster->probeBlocks) {
+      pCluster->disabled = true;
+      qDebug("group by clustering disabled after %d blocks, %d clustered", pCluster->probeBlocks,
+             pCluster->clusterBlocks);
+    }
+    return TSDB_CODE_SUCCESS;
+  }
+
+  // turn the group sizes into start offsets, and use pGroupRow as the write cursor of each group
+  int32_t start = 0;
+  for (int32_t g = 0; g < numOfGroups; ++g) {
+    int32_t size = pCluster->pGroupOffset[g];
+    pCluster->pGroupOffset[g] = start;
+    pCluster->pGroupRow[g] = start;
+    start += size;
+  }
+  pCluster->pGroupOffset[numOfGroups] = rows;
+
+  for (int32_t j = 0; j < rows; ++j) {
+    pCluster->pIndex[pCluster->pGroupRow[pCluster->pRowGroup[j]]++] = j;
+  }
+
+  code = blockDataReorder(pBlock, pCluster->pIndex);
+  if (code != TSDB_CODE_SUCCESS) {
+    return code;
+  }
+
+  pCluster->clusterBlocks += 1;
+  *pNumOfGroups = numOfGroups;
+  return TSDB_CODE_SUCCESS;
+}
+
+static void doHashGroupbyAggByCluster(SOperatorInfo* pOperator, SSDataBlock* pBlock, int32_t numOfGroups) {
+  SExecTaskInfo*        pTaskInfo = pOperator->pTaskInfo;
+  SGroupbyOperatorInfo* pInfo = pOperator->info;
+  SqlFunctionCtx*       pCtx = pOperator->exprSupp.pCtx;
+  int32_t*              pGroupOffset = pInfo->cluster.pGroupOffset;
+
+  for (int32_t g = 0; g < numOfGroups; ++g) {
+    int32_t rowIndex = pGroupOffset[g];
+    int32_t num = pGroupOffset[g + 1] - rowIndex;
+
+    recordNewGroupKeys(pInfo->pGroupCols, pInfo->pGroupColVals, pBlock, rowIndex);
+    if (terrno != TSDB_CODE_SUCCESS) {
+      T_LONG_JMP(pTaskInfo->env, terrno);
+    }
+
+    int32_t len = buildGroupKeys(pInfo->keyBuf, pInfo->pGroupColVals);
+    int32_t ret = setGroupResultOutputBuf(pOperator, &(pInfo->binfo), pOperator->exprSupp.numOfExprs, pInfo->keyBuf,
+                                          len, pBlock->info.id.groupId, pInfo->aggSup.pResultBuf, &pInfo->aggSup);
+    if (ret != TSDB_CODE_SUCCESS) {
+      T_LONG_JMP(pTaskInfo->env, ret);
+    }
+
+    ret = applyAggFunctionOnPartialTuples(pTaskInfo, pCtx, NULL, rowIndex, num, pBlock->info.rows,
+                                          pOperator->exprSupp.numOfExprs);
+    if (ret != TSDB_CODE_SUCCESS) {
+      T_LONG_JMP(pTaskInfo->env, ret);
+    }
+
+    doAssignGroupKeys(pCtx, pOperator->exprSupp.numOfExprs, pBlock->info.rows, rowIndex);
+  }
+
+  pInfo->isInit = true;
+}
+
 static void doHashGroupbyAgg(SOperatorInfo* pOperator, SSDataBlock* pBlock) {
   SExecTaskInfo*        pTaskInfo = pOperator->pTaskInfo;
   SGroupbyOperatorInfo* pInfo = pOperator->info;
@@ -299,6 +555,17 @@ static void doHashGroupbyAgg(SOperatorInfo* pOperator, SSDataBlock* pBlock) {
   int32_t len = 0;
   terrno = TSDB_CODE_SUCCESS;
 
+  int32_t numOfGroups = 0;
+  int32_t code = clusterRowsByGroupKey(pInfo, pBlock, &numOfGroups);
+  if (code != TSDB_CODE_SUCCESS) {
+    T_LONG_JMP(pTaskInfo->env, code);
+  }
+
+  if (numOfGroups > 0) {
+    doHashGroupbyAggByCluster(pOperator, pBlock, numOfGroups);
+    return;
+  }
+
   int32_t num = 0;
   for (int32_t j = 0; j < pBlock->info.rows; ++j) {
     // Compare with the previous row of this column, and do not set the output buffer again if they are identical.
@@ -540,6 +807,14 @@ int32_t createGroupOperatorInfo(SOperatorInfo* downstream, SAggPhysiNode* pAggNo
   code = extractColumnInfo(pAggNode->pGroupKeys, &pInfo->pGroupCols);
   QUERY_CHECK_CODE(code, lino, _error);
 
+  // json keys are rejected row by row, leave them to the row by row path
+  for (int32_t i = 0; i < taosArrayGetSize(pInfo->pGroupCols); ++i) {
+    SColumn* pCol = taosArrayGet(pInfo->pGroupCols, i);
+    if (pCol->type == TSDB_DATA_TYPE_JSON) {
+      pInfo->cluster.disabled = true;
+    }
+  }
+
   int32_t    numOfScalarExpr = 0;
   SExprInfo* pScalarExprInfo = NULL;
   if (pAggNode->pExprs != NULL) {
@@ -52,6 +52,10 @@ int32_t hInnerJoinDo(struct SOperatorInfo* pOperator) {
   }
 
   for (; pCtx->probeStartIdx <= pCtx->probeEndIdx; ++pCtx->probeStartIdx) {
+    if (pCtx->pProbeSkip && pCtx->pProbeSkip[pCtx->probeStartIdx]) {
+      continue;
+    }
+
     if (hJoinCopyKeyColsDataToBuf(pProbe, pCtx->probeStartIdx, &bufLen)) {
       continue;
     }
@@ -22,6 +22,7 @@
 #include "querytask.h"
 #include "tcompare.h"
 #include "tdatablock.h"
+#include "tglobal.h"
 #include "thash.h"
 #include "tmsg.h"
 #include "ttypes.h"
@@ -407,28 +408,66 @@ static int32_t hJoinBuildResColsMap(SHJoinOperatorInfo* pInfo, SHashJoinPhysiNod
 }
 
 
-static FORCE_INLINE int32_t hJoinAddPageToBufs(SArray* pRowBufs) {
-  SBufPageInfo page;
-  page.pageSize = HASH_JOIN_DEFAULT_PAGE_SIZE;
-  page.offset = 0;
-  page.data = taosMemoryMalloc(page.pageSize);
-  if (NULL == page.data) {
-    return terrno;
+static FORCE_INLINE void hJoinReleaseWritePage(SHJoinOperatorInfo* pInfo) {
+  if (pInfo->pWritePage) {
+    setBufPageDirty(pInfo->pWritePage, true);
+    releaseBufPage(pInfo->pRowBuf, pInfo->pWritePage);
+    pInfo->pWritePage = NULL;
+  }
+}
+
+static FORCE_INLINE void hJoinReleaseReadPage(SHJoinOperatorInfo* pInfo) {
+  if (pInfo->pReadPage) {
+    releaseBufPage(pInfo->pRowBuf, pInfo->pReadPage);
+    pInfo->pReadPage = NULL;
   }
+}
+
+static FORCE_INLINE int32_t hJoinAddPageToBufs(SHJoinOperatorInfo* pInfo) {
+  hJoinReleaseWritePage(pInfo);
 
-  if (NULL == taosArrayPush(pRowBufs, &page)) {
+  int32_t pageId = -1;
+  char*   pPage = getNewBufPage(pInfo->pRowBuf, &pageId);
+  if (NULL == pPage) {
     return terrno;
   }
+
+  if (pageId >= (uint16_t)-1) {
+    releaseBufPage(pInfo->pRowBuf, pPage);
+    qError("hash join row buf pages exceed the limit, pageId:%d", pageId);
+    return TSDB_CODE_QRY_EXECUTOR_INTERNAL_ERROR;
+  }
+
+  pInfo->pWritePage = pPage;
+  pInfo->writePageId = pageId;
+  pInfo->writeOffset = 0;
   return TSDB_CODE_SUCCESS;
 }
 
-static int32_t hJoinInitBufPages(SHJoinOperatorInfo* pInfo) {
-  pInfo->pRowBufs = taosArrayInit(32, sizeof(SBufPageInfo));
-  if (NULL == pInfo->pRowBufs) {
-    return terrno;
+static int32_t hJoinInitBufPages(SHJoinOperatorInfo* pInfo, const char* idStr) {
+  int64_t memSize = (int64_t)tsHashJoinMemThreshold * 1048576;
+  int32_t code = createDiskbasedBuf(&pInfo->pRowBuf, HASH_JOIN_DEFAULT_PAGE_SIZE, memSize, idStr, tsTempDir);
+  if (code) {
+    return code;
   }
 
-  return hJoinAddPageToBufs(pInfo->pRowBufs);
+  return hJoinAddPageToBufs(pInfo);
+}
+
+static void hJoinFreeBufPages(SHJoinOperatorInfo* pInfo) {
+  if (NULL == pInfo->pRowBuf) {
+    return;
+  }
+
+  hJoinReleaseWritePage(pInfo);
+  hJoinReleaseReadPage(pInfo);
+
+  if (!isAllDataInMemBuf(pInfo->pRowBuf)) {
+    dBufPrintStatis(pInfo->pRowBuf);
+  }
+
+  destroyDiskbasedBuf(pInfo->pRowBuf);
+  pInfo->pRowBuf = NULL;
 }
 
 static void hJoinFreeTableInfo(SHJoinTableCtx* pTable) {
@@ -439,11 +478,6 @@ static void hJoinFreeTableInfo(SHJoinTableCtx* pTable) {
   taosMemoryFree(pTable->primCol);
 }
 
-static void hJoinFreeBufPage(void* param) {
-  SBufPageInfo* pInfo = (SBufPageInfo*)param;
-  taosMemoryFree(pInfo->data);
-}
-
 static void hJoinDestroyKeyHash(SSHashObj** ppHash) {
   if (NULL == ppHash || NULL == (*ppHash)) {
     return;
@@ -466,19 +500,26 @@ static void hJoinDestroyKeyHash(SSHashObj** ppHash) {
   *ppHash = NULL;
 }
 
-static FORCE_INLINE int32_t hJoinRetrieveColDataFromRowBufs(SArray* pRowBufs, SBufRowInfo* pRow, char** ppData) {
+static FORCE_INLINE int32_t hJoinRetrieveColDataFromRowBufs(SHJoinOperatorInfo* pJoin, SBufRowInfo* pRow, char** ppData) {
   *ppData = NULL;
   
   if ((uint16_t)-1 == pRow->pageId) {
     return TSDB_CODE_SUCCESS;
   }
-  SBufPageInfo *pPage = taosArrayGet(pRowBufs, pRow->pageId);
-  if (NULL == pPage) {
-    qError("fail to get %d page, total:%d", pRow->pageId, (int32_t)taosArrayGetSize(pRowBufs));
-    QRY_ERR_RET(TSDB_CODE_QRY_EXECUTOR_INTERNAL_ERROR);
+
+  // keep the last read page pinned, rows of the same key are mostly stored in the same page
+  if (NULL == pJoin->pReadPage || pJoin->readPageId != pRow->pageId) {
+    hJoinReleaseReadPage(pJoin);
+
+    pJoin->pReadPage = getBufPage(pJoin->pRowBuf, pRow->pageId);
+    if (NULL == pJoin->pReadPage) {
+      qError("fail to get %d page since %s", pRow->pageId, tstrerror(terrno));
+      QRY_ERR_RET(terrno);
+    }
+    pJoin->readPageId = pRow->pageId;
   }
   
-  *ppData = pPage->data + pRow->offset;
+  *ppData = pJoin->pReadPage + pRow->offset;
 
   return TSDB_CODE_SUCCESS;
 }
@@ -493,7 +534,7 @@ static int32_t hJoinCopyResRowsToBlock(SHJoinOperatorInfo* pJoin, int32_t rowNum
   char* pData = NULL;
 
   for (int32_t r = 0; r < rowNum; ++r) {
-    HJ_ERR_RET(hJoinRetrieveColDataFromRowBufs(pJoin->pRowBufs, pRow, &pData));
+    HJ_ERR_RET(hJoinRetrieveColDataFromRowBufs(pJoin, pRow, &pData));
     
     char* pValData = pData + pBuild->valBitMapSize;
     char* pKeyData = pProbe->keyData;
@@ -731,7 +772,7 @@ static FORCE_INLINE void hJoinCopyValColsDataToBuf(SHJoinTableCtx* pTable, int32
 }
 
 
-static FORCE_INLINE int32_t hJoinGetValBufFromPages(SArray* pPages, int32_t bufSize, char** pBuf, SBufRowInfo* pRow) {
+static FORCE_INLINE int32_t hJoinGetValBufFromPages(SHJoinOperatorInfo* pJoin, int32_t bufSize, char** pBuf, SBufRowInfo* pRow) {
   if (0 == bufSize) {
     pRow->pageId = -1;
     return TSDB_CODE_SUCCESS;
@@ -743,16 +784,15 @@ static FORCE_INLINE int32_t hJoinGetValBufFromPages(SArray* pPages, int32_t bufS
   }
   
   do {
-    SBufPageInfo* page = taosArrayGetLast(pPages);
-    if ((page->pageSize - page->offset) >= bufSize) {
-      *pBuf = page->data + page->offset;
-      pRow->pageId = taosArrayGetSize(pPages) - 1;
-      pRow->offset = page->offset;
-      page->offset += bufSize;
+    if (pJoin->pWritePage && (HASH_JOIN_DEFAULT_PAGE_SIZE - pJoin->writeOffset) >= bufSize) {
+      *pBuf = pJoin->pWritePage + pJoin->writeOffset;
+      pRow->pageId = pJoin->writePageId;
+      pRow->offset = pJoin->writeOffset;
+      pJoin->writeOffset += bufSize;
       return TSDB_CODE_SUCCESS;
     }
 
-    int32_t code = hJoinAddPageToBufs(pPages);
+    int32_t code = hJoinAddPageToBufs(pJoin);
     if (code) {
       return code;
     }
@@ -794,7 +834,7 @@ static int32_t hJoinAddRowToHashImpl(SHJoinOperatorInfo* pJoin, SGroupData* pGro
     }
   }
 
-  int32_t code = hJoinGetValBufFromPages(pJoin->pRowBufs, hJoinGetValBufSize(pTable, rowIdx), &pTable->valData, pRow);
+  int32_t code = hJoinGetValBufFromPages(pJoin, hJoinGetValBufSize(pTable, rowIdx), &pTable->valData, pRow);
   if (code) {
     taosMemoryFree(pRow);
     return code;
@@ -874,6 +914,177 @@ static bool hJoinFilterTimeRange(SSDataBlock* pBlock, STimeWindow* pRange, int32
   return true;
 }
 
+#define HJ_KEY_RANGE_UPDATE(_type)                             \
+  do {                                                         \
+    const _type* v = (const _type*)pCol->pData;                \
+    for (int32_t i = startIdx; i <= endIdx; ++i) {             \
+      if (hasNull && colDataIsNull_f(pCol->nullbitmap, i)) {   \
+        continue;                                              \
+      }                                                        \
+      minVal = TMIN(minVal, (int64_t)v[i]);                    \
+      maxVal = TMAX(maxVal, (int64_t)v[i]);                    \
+    }                                                          \
+  } while (0)
+
+#define HJ_KEY_RANGE_MARK(_type)                                                     \
+  do {                                                                               \
+    const _type* v = (const _type*)pCol->pData;                                      \
+    for (int32_t i = s; i <= e; ++i) {                                               \
+      pSkip[i] = (int8_t)(((int64_t)v[i] < minVal) | ((int64_t)v[i] > maxVal));      \
+    }                                                                                \
+  } while (0)
+
+static FORCE_INLINE bool hJoinIsRangeKeyType(int8_t type) {
+  switch (type) {
+    case TSDB_DATA_TYPE_BOOL:
+    case TSDB_DATA_TYPE_TINYINT:
+    case TSDB_DATA_TYPE_SMALLINT:
+    case TSDB_DATA_TYPE_INT:
+    case TSDB_DATA_TYPE_BIGINT:
+    case TSDB_DATA_TYPE_TIMESTAMP:
+    case TSDB_DATA_TYPE_UTINYINT:
+    case TSDB_DATA_TYPE_USMALLINT:
+    case TSDB_DATA_TYPE_UINT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+static void hJoinUpdateKeyRange(SHJoinOperatorInfo* pJoin, int32_t startIdx, int32_t endIdx) {
+  SHJoinKeyRange*  pRange = &pJoin->keyRange;
+  SColumnInfoData* pCol = pJoin->pBuild->keyCols[0].colData;
+
+  if (pRange->disabled) {
+    return;
+  }
+
+  if (!hJoinIsRangeKeyType(pCol->info.type) || (pRange->valid && pRange->type != pCol->info.type)) {
+    pRange->disabled = true;
+    return;
+  }
+
+  bool    hasNull = pCol->hasNull && pCol->nullbitmap != NULL;
+  int64_t minVal = pRange->valid ? pRange->minVal : INT64_MAX;
+  int64_t maxVal = pRange->valid ? pRange->maxVal : INT64_MIN;
+
+  switch (pCol->info.type) {
+    case TSDB_DATA_TYPE_BOOL:
+    case TSDB_DATA_TYPE_TINYINT:
+      HJ_KEY_RANGE_UPDATE(int8_t);
+      break;
+    case TSDB_DATA_TYPE_SMALLINT:
+      HJ_KEY_RANGE_UPDATE(int16_t);
+      break;
+    case TSDB_DATA_TYPE_INT:
+      HJ_KEY_RANGE_UPDATE(int32_t);
+      break;
+    case TSDB_DATA_TYPE_UTINYINT:
+      HJ_KEY_RANGE_UPDATE(uint8_t);
+      break;
+    case TSDB_DATA_TYPE_USMALLINT:
+      HJ_KEY_RANGE_UPDATE(uint16_t);
+      break;
+    case TSDB_DATA_TYPE_UINT:
+      HJ_KEY_RANGE_UPDATE(uint32_t);
+      break;
+    default:
+      HJ_KEY_RANGE_UPDATE(int64_t);
+      break;
+  }
+
+  if (minVal <= maxVal) {
+    pRange->valid = true;
+    pRange->type = pCol->info.type;
+    pRange->minVal = minVal;
+    pRange->maxVal = maxVal;
+  }
+}
+
+/**
+ * For inner join, mark the probe rows whose first key is null or out of the key range of the build side, and shrink
+ * [startIdx, endIdx] to the first and last rows that may match. hasMatch is set to false if no row of the block may
+ * match.
+ */
+static int32_t hJoinFilterProbeByKeyRange(SHJoinOperatorInfo* pJoin, SSDataBlock* pBlock, int32_t* startIdx,
+                                          int32_t* endIdx, bool* hasMatch) {
+  SHJoinKeyRange*  pRange = &pJoin->keyRange;
+  SColumnInfoData* pCol = pJoin->pProbe->keyCols[0].colData;
+
+  *hasMatch = true;
+  pJoin->ctx.pProbeSkip = NULL;
+  if (!IS_INNER_NONE_JOIN(pJoin->joinType, pJoin->subType) || pRange->disabled || !pRange->valid ||
+      pCol->info.type != pRange->type) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  if (pBlock->info.rows > pJoin->probeSkipCap) {
+    int8_t* p = taosMemoryRealloc(pJoin->probeSkip, pBlock->info.rows);
+    if (NULL == p) {
+      return terrno;
+    }
+    pJoin->probeSkip = p;
+    pJoin->probeSkipCap = pBlock->info.rows;
+  }
+
+  int8_t* pSkip = pJoin->probeSkip;
+  int32_t s = *startIdx, e = *endIdx;
+  int64_t minVal = pRange->minVal, maxVal = pRange->maxVal;
+  switch (pCol->info.type) {
+    case TSDB_DATA_TYPE_BOOL:
+    case TSDB_DATA_TYPE_TINYINT:
+      HJ_KEY_RANGE_MARK(int8_t);
+      break;
+    case TSDB_DATA_TYPE_SMALLINT:
+      HJ_KEY_RANGE_MARK(int16_t);
+      break;
+    case TSDB_DATA_TYPE_INT:
+      HJ_KEY_RANGE_MARK(int32_t);
+      break;
+    case TSDB_DATA_TYPE_UTINYINT:
+      HJ_KEY_RANGE_MARK(uint8_t);
+      break;
+    case TSDB_DATA_TYPE_USMALLINT:
+      HJ_KEY_RANGE_MARK(uint16_t);
+      break;
+    case TSDB_DATA_TYPE_UINT:
+      HJ_KEY_RANGE_MARK(uint32_t);
+      break;
+    default:
+      HJ_KEY_RANGE_MARK(int64_t);
+      break;
+  }
+
+  if (pCol->hasNull && pCol->nullbitmap != NULL) {
+    for (int32_t i = s; i <= e; ++i) {
+      pSkip[i] |= (int8_t)colDataIsNull_f(pCol->nullbitmap, i);
+    }
+  }
+
+  int32_t skipRows = 0;
+  for (int32_t i = s; i <= e; ++i) {
+    skipRows += pSkip[i];
+  }
+  pJoin->execInfo.probeSkipRows += skipRows;
+
+  while (s <= e && pSkip[s]) {
+    ++s;
+  }
+  while (e >= s && pSkip[e]) {
+    --e;
+  }
+
+  *startIdx = s;
+  *endIdx = e;
+  if (s > e) {
+    *hasMatch = false;
+    return TSDB_CODE_SUCCESS;
+  }
+
+  pJoin->ctx.pProbeSkip = pSkip;
+  return TSDB_CODE_SUCCESS;
+}
+
 static int32_t hJoinAddBlockRowsToHash(SSDataBlock* pBlock, SHJoinOperatorInfo* pJoin) {
   SHJoinTableCtx* pBuild = pJoin->pBuild;
   int32_t startIdx = 0, endIdx = pBlock->info.rows - 1;
@@ -888,6 +1099,8 @@ static int32_t hJoinAddBlockRowsToHash(SSDataBlock* pBlock, SHJoinOperatorInfo*
     return code;
   }
 
+  hJoinUpdateKeyRange(pJoin, startIdx, endIdx);
+
   size_t bufLen = 0;
   for (int32_t i = startIdx; i <= endIdx; ++i) {
     if (hJoinCopyKeyColsDataToBuf(pBuild, i, &bufLen)) {
@@ -922,6 +1135,9 @@ static int32_t hJoinBuildHash(struct SOperatorInfo* pOperator, bool* queryDone)
     }
   }
 
+  // the filled pages can be spilled from now on
+  hJoinReleaseWritePage(pJoin);
+
   if (IS_INNER_NONE_JOIN(pJoin->joinType, pJoin->subType) && tSimpleHashGetSize(pJoin->pKeyHash) <= 0) {
     hJoinSetDone(pOperator);
     *queryDone = true;
@@ -956,6 +1172,13 @@ static int32_t hJoinPrepareStart(struct SOperatorInfo* pOperator, SSDataBlock* p
   if (code) {
     return code;
   }
+
+  bool hasMatch = true;
+  HJ_ERR_RET(hJoinFilterProbeByKeyRange(pJoin, pBlock, &startIdx, &endIdx, &hasMatch));
+  if (!hasMatch) {
+    return TSDB_CODE_SUCCESS;
+  }
+
   code = hJoinSetValColsData(pBlock, pProbe);
   if (code) {
     return code;
@@ -985,6 +1208,7 @@ void hJoinSetDone(struct SOperatorInfo* pOperator) {
 
   SHJoinOperatorInfo* pInfo = pOperator->info;
   hJoinDestroyKeyHash(&pInfo->pKeyHash);
+  hJoinFreeBufPages(pInfo);
 
   qDebug("hash Join done");  
 }
@@ -1081,9 +1305,10 @@ _end:
 
 static void destroyHashJoinOperator(void* param) {
   SHJoinOperatorInfo* pJoinOperator = (SHJoinOperatorInfo*)param;
-  qDebug("hashJoin exec info, buildBlk:%" PRId64 ", buildRows:%" PRId64 ", probeBlk:%" PRId64 ", probeRows:%" PRId64 ", resRows:%" PRId64, 
-         pJoinOperator->execInfo.buildBlkNum, pJoinOperator->execInfo.buildBlkRows, pJoinOperator->execInfo.probeBlkNum, 
-         pJoinOperator->execInfo.probeBlkRows, pJoinOperator->execInfo.resRows);
+  qDebug("hashJoin exec info, buildBlk:%" PRId64 ", buildRows:%" PRId64 ", probeBlk:%" PRId64 ", probeRows:%" PRId64
+         ", probeSkipRows:%" PRId64 ", resRows:%" PRId64,
+         pJoinOperator->execInfo.buildBlkNum, pJoinOperator->execInfo.buildBlkRows, pJoinOperator->execInfo.probeBlkNum,
+         pJoinOperator->execInfo.probeBlkRows, pJoinOperator->execInfo.probeSkipRows, pJoinOperator->execInfo.resRows);
 
   hJoinDestroyKeyHash(&pJoinOperator->pKeyHash);
 
@@ -1092,7 +1317,8 @@ static void destroyHashJoinOperator(void* param) {
   blockDataDestroy(pJoinOperator->finBlk);
   pJoinOperator->finBlk = NULL;
   taosMemoryFreeClear(pJoinOperator->pResColMap);
-  taosArrayDestroyEx(pJoinOperator->pRowBufs, hJoinFreeBufPage);
+  taosMemoryFreeClear(pJoinOperator->probeSkip);
+  hJoinFreeBufPages(pJoinOperator);
 
   taosMemoryFreeClear(param);
 }
@@ -1196,7 +1422,7 @@ int32_t createHashJoinOperatorInfo(SOperatorInfo** pDownstream, int32_t numOfDow
   
   HJ_ERR_JRET(hJoinBuildResColsMap(pInfo, pJoinNode));
 
-  HJ_ERR_JRET(hJoinInitBufPages(pInfo));
+  HJ_ERR_JRET(hJoinInitBufPages(pInfo, pTaskInfo->id.str));
 
   size_t hashCap = pInfo->pBuild->inputStat.inputRowNum > 0 ? (pInfo->pBuild->inputStat.inputRowNum * 1.5) : 1024;
   pInfo->pKeyHash = tSimpleHashInit(hashCap, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY));
@@ -186,13 +186,23 @@ static SResultRow* getTableGroupOutputBuf(SOperatorInfo* pOperator, uint64_t gro
   return (SResultRow*)((char*)(*pPage) + p1->offset);
 }
 
+// the ignore list is looked up by the parallel scan workers of the tsdb reader concurrently
+static int32_t initTableScanIgnoreList(STableScanInfo* pTableScanInfo) {
+  int32_t tableNum = taosArrayGetSize(pTableScanInfo->base.pTableListInfo->pTableList);
+  pTableScanInfo->pIgnoreTables =
+      taosHashInit(tableNum, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BIGINT), true,
+                   pTableScanInfo->base.cond.parallelScan ? HASH_ENTRY_LOCK : HASH_NO_LOCK);
+  if (NULL == pTableScanInfo->pIgnoreTables) {
+    return terrno;
+  }
+  return TSDB_CODE_SUCCESS;
+}
+
 static int32_t insertTableToScanIgnoreList(STableScanInfo* pTableScanInfo, uint64_t uid) {
   if (NULL == pTableScanInfo->pIgnoreTables) {
-    int32_t tableNum = taosArrayGetSize(pTableScanInfo->base.pTableListInfo->pTableList);
-    pTableScanInfo->pIgnoreTables =
-        taosHashInit(tableNum, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BIGINT), true, HASH_NO_LOCK);
-    if (NULL == pTableScanInfo->pIgnoreTables) {
-      return terrno;
+    int32_t code = initTableScanIgnoreList(pTableScanInfo);
+    if (code != TSDB_CODE_SUCCESS) {
+      return code;
     }
   }
 
@@ -466,22 +476,33 @@ static int32_t loadDataBlock(SOperatorInfo* pOperator, STableScanBase* pTableSca
   }
 
   pCost->totalCheckedRows += pBlock->info.rows;
-  pCost->loadBlocks += 1;
 
+  int64_t      numOfRows = pBlock->info.rows;
   SSDataBlock* p = NULL;
   code = pAPI->tsdReader.tsdReaderRetrieveDataBlock(pTableScanInfo->dataReader, &p, NULL);
   if (p == NULL || code != TSDB_CODE_SUCCESS || p != pBlock) {
     return code;
   }
 
+  // restore the previous value
+  pCost->totalRows -= numOfRows;
+
+  // the reader has evaluated the filter on the filter columns of a clean file block, and no row qualifies
+  if (pBlock->info.rows == 0 && pOperator->exprSupp.pFilterInfo != NULL) {
+    qDebug("%s data block filter out by reader, brange:%" PRId64 "-%" PRId64 ", rows:%" PRId64, GET_TASKID(pTaskInfo),
+           pBlockInfo->window.skey, pBlockInfo->window.ekey, numOfRows);
+    pCost->filterSkipBlocks += 1;
+    (*status) = FUNC_DATA_REQUIRED_FILTEROUT;
+    return TSDB_CODE_SUCCESS;
+  }
+
+  pCost->loadBlocks += 1;
+
   code = doSetTagColumnData(pTableScanInfo, pBlock, pTaskInfo, pBlock->info.rows);
   if (code) {
     return code;
   }
 
-  // restore the previous value
-  pCost->totalRows -= pBlock->info.rows;
-
   if (pOperator->exprSupp.pFilterInfo != NULL) {
     code = doFilter(pBlock, pOperator->exprSupp.pFilterInfo, &pTableScanInfo->matchInfo);
     QUERY_CHECK_CODE(code, lino, _end);
@@ -1290,6 +1311,10 @@ static int32_t groupSeqTableScan(SOperatorInfo* pOperator, SSDataBlock** pResBlo
       pAPI->tsdReader.tsdSetFilesetDelimited(pInfo->base.dataReader);
     }
 
+    if (pOperator->exprSupp.pFilterInfo != NULL) {
+      pAPI->tsdReader.tsdSetBlockFilter(pInfo->base.dataReader, pOperator->exprSupp.pFilterInfo, pInfo->pFilterCols);
+    }
+
     if (pInfo->pResBlock->info.capacity > pOperator->resultInfo.capacity) {
       pOperator->resultInfo.capacity = pInfo->pResBlock->info.capacity;
     }
@@ -1459,10 +1484,42 @@ static void destroyTableScanOperatorInfo(void* param) {
   STableScanInfo* pTableScanInfo = (STableScanInfo*)param;
   blockDataDestroy(pTableScanInfo->pResBlock);
   taosHashCleanup(pTableScanInfo->pIgnoreTables);
+  taosArrayDestroy(pTableScanInfo->pFilterCols);
   destroyTableScanBase(&pTableScanInfo->base, &pTableScanInfo->base.readerAPI);
   taosMemoryFreeClear(param);
 }
 
+static EDealRes collectFilterColsWalker(SNode* pNode, void* pContext) {
+  SArray** ppCols = pContext;
+
+  if (QUERY_NODE_COLUMN == nodeType(pNode)) {
+    SColumnNode* pCol = (SColumnNode*)pNode;
+    if (pCol->colType == COLUMN_TYPE_COLUMN && taosArrayPush(*ppCols, &pCol->colId) != NULL) {
+      return DEAL_RES_CONTINUE;
+    }
+  } else if (QUERY_NODE_FUNCTION != nodeType(pNode) || !fmIsScanPseudoColumnFunc(((SFunctionNode*)pNode)->funcId)) {
+    return DEAL_RES_CONTINUE;
+  }
+
+  // tags and pseudo columns are filled after the data block is loaded, the filter can not be evaluated by the reader
+  taosArrayDestroy(*ppCols);
+  *ppCols = NULL;
+  return DEAL_RES_END;
+}
+
+// the data columns referred by the filter, which are decoded ahead of the other columns of a data block by the reader
+static SArray* collectFilterCols(SNode* pCondition) {
+  if (pCondition == NULL) {
+    return NULL;
+  }
+
+  SArray* pCols = taosArrayInit(4, sizeof(col_id_t));
+  if (pCols != NULL) {
+    nodesWalkExpr(pCondition, collectFilterColsWalker, &pCols);
+  }
+  return pCols;
+}
+
 static void resetClolumnReserve(SSDataBlock* pBlock, int32_t dataRequireFlag) {
   if (pBlock && dataRequireFlag == FUNC_DATA_REQUIRED_NOT_LOAD) {
     int32_t numOfCols = taosArrayGetSize(pBlock->pDataBlock);
@@ -1534,6 +1591,8 @@ int32_t createTableScanOperatorInfo(STableScanPhysiNode* pTableScanNode, SReadHa
   code = filterInitFromNode((SNode*)pTableScanNode->scan.node.pConditions, &pOperator->exprSupp.pFilterInfo, 0);
   QUERY_CHECK_CODE(code, lino, _error);
 
+  pInfo->pFilterCols = collectFilterCols(pTableScanNode->scan.node.pConditions);
+
   pInfo->currentGroupId = -1;
 
   pInfo->tableEndIndex = -1;
@@ -1555,6 +1614,18 @@ int32_t createTableScanOperatorInfo(STableScanPhysiNode* pTableScanNode, SReadHa
 
   pInfo->filesetDelimited = pTableScanNode->filesetDelimited;
 
+  // blocks of different tables can be interleaved only if neither the fileset order nor a repeated scan is required,
+  // and block SMA is useless once the data are loaded by parallel workers.
+  pInfo->base.cond.parallelScan = (pTaskInfo->execModel == OPTR_EXEC_MODEL_BATCH) && !pInfo->filesetDelimited &&
+                                  (pInfo->scanInfo.numOfAsc + pInfo->scanInfo.numOfDesc == 1) &&
+                                  (pInfo->base.dataBlockLoadFlag == FUNC_DATA_REQUIRED_DATA_LOAD);
+
+  // created in advance, so that the pointer is not changed while the workers are running
+  if (pInfo->base.cond.parallelScan) {
+    code = initTableScanIgnoreList(pInfo);
+    QUERY_CHECK_CODE(code, lino, _error);
+  }
+
   taosLRUCacheSetStrictCapacity(pInfo->base.metaCache.pTableMetaEntryCache, false);
   pOperator->fpSet = createOperatorFpSet(optrDummyOpenFn, doTableScanNext, NULL, destroyTableScanOperatorInfo,
                                          optrDefaultBufFn, getTableScannerExecInfo, optrDefaultGetNextExtFn, NULL);
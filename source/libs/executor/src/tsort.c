@@ -2713,7 +2713,116 @@ static int32_t tupleComparFn(const void* pLeft, const void* pRight, void* param)
   return 0;
 }
 
+#define TSORT_PQ_MARK_SKIP(_type)                                                     \
+  do {                                                                                \
+    const _type* v = (const _type*)pCol->pData;                                       \
+    _type        t = *(const _type*)pThreshold;                                       \
+    if (pOrder->order == TSDB_ORDER_ASC) {                                            \
+      for (int32_t i = 0; i < rows; ++i) pSkip[i] = (int8_t)(v[i] > t);               \
+    } else {                                                                          \
+      for (int32_t i = 0; i < rows; ++i) pSkip[i] = (int8_t)(v[i] < t);               \
+    }                                                                                 \
+  } while (0)
+
+#define TSORT_PQ_MARK_SKIP_FLOAT(_type)                                                         \
+  do {                                                                                          \
+    const _type* v = (const _type*)pCol->pData;                                                 \
+    _type        t = *(const _type*)pThreshold;                                                 \
+    if (pOrder->order == TSDB_ORDER_ASC) {                                                      \
+      for (int32_t i = 0; i < rows; ++i) pSkip[i] = (int8_t)(!FLT_EQUAL(v[i], t) & (v[i] > t)); \
+    } else {                                                                                    \
+      for (int32_t i = 0; i < rows; ++i) pSkip[i] = (int8_t)(!FLT_EQUAL(v[i], t) & (v[i] < t)); \
+    }                                                                                           \
+  } while (0)
+
+/**
+ * Once the bounded queue is full, its top is the worst row kept so far. A row whose first order key sorts strictly
+ * after the key of the top would be rejected by taosBQPush anyway, so mark such rows with one typed scan of the key
+ * column instead of comparing them tuple by tuple. Ties and NaN values are left to the full comparison.
+ */
+static int32_t tsortPQMarkSkipRows(SSortHandle* pHandle, SSDataBlock* pBlock, int8_t* pSkip, bool* pMarked) {
+  *pMarked = false;
+
+  if (taosBQSize(pHandle->pBoundedQueue) != taosBQMaxSize(pHandle->pBoundedQueue) + 1) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  SBlockOrderInfo* pOrder = taosArrayGet(pHandle->pSortInfo, 0);
+  if (pOrder == NULL) {
+    return terrno;
+  }
+
+  SColumnInfoData* pCol = taosArrayGet(pBlock->pDataBlock, pOrder->slotId);
+  if (pCol == NULL) {
+    return terrno;
+  }
+
+  PriorityQueueNode* pTop = taosBQTop(pHandle->pBoundedQueue);
+  void*              pThreshold = NULL;
+  TAOS_CHECK_RETURN(
+      tupleDescGetField((TupleDesc*)pTop->data, pOrder->slotId, blockDataGetNumOfCols(pBlock), &pThreshold));
+  if (pThreshold == NULL) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  int32_t rows = pBlock->info.rows;
+  switch (pCol->info.type) {
+    case TSDB_DATA_TYPE_BOOL:
+    case TSDB_DATA_TYPE_TINYINT:
+      TSORT_PQ_MARK_SKIP(int8_t);
+      break;
+    case TSDB_DATA_TYPE_SMALLINT:
+      TSORT_PQ_MARK_SKIP(int16_t);
+      break;
+    case TSDB_DATA_TYPE_INT:
+      TSORT_PQ_MARK_SKIP(int32_t);
+      break;
+    case TSDB_DATA_TYPE_BIGINT:
+    case TSDB_DATA_TYPE_TIMESTAMP:
+      TSORT_PQ_MARK_SKIP(int64_t);
+      break;
+    case TSDB_DATA_TYPE_UTINYINT:
+      TSORT_PQ_MARK_SKIP(uint8_t);
+      break;
+    case TSDB_DATA_TYPE_USMALLINT:
+      TSORT_PQ_MARK_SKIP(uint16_t);
+      break;
+    case TSDB_DATA_TYPE_UINT:
+      TSORT_PQ_MARK_SKIP(uint32_t);
+      break;
+    case TSDB_DATA_TYPE_UBIGINT:
+      TSORT_PQ_MARK_SKIP(uint64_t);
+      break;
+    case TSDB_DATA_TYPE_FLOAT:
+      TSORT_PQ_MARK_SKIP_FLOAT(float);
+      break;
+    case TSDB_DATA_TYPE_DOUBLE:
+      TSORT_PQ_MARK_SKIP_FLOAT(double);
+      break;
+    default:
+      return TSDB_CODE_SUCCESS;
+  }
+
+  // a null key sorts after the threshold unless nulls come first
+  if (pCol->hasNull && pCol->nullbitmap != NULL) {
+    for (int32_t i = 0; i < rows; ++i) {
+      if (colDataIsNull_f(pCol->nullbitmap, i)) {
+        pSkip[i] = pOrder->nullFirst ? 0 : 1;
+      }
+    }
+  }
+
+  *pMarked = true;
+  return TSDB_CODE_SUCCESS;
+}
+
 static int32_t tsortOpenForPQSort(SSortHandle* pHandle) {
+  int32_t code = TSDB_CODE_SUCCESS;
+  int8_t* pSkip = NULL;
+  int32_t skipCap = 0;
+  int64_t numOfRows = 0;
+  int64_t numOfSkipped = 0;
+
   pHandle->pBoundedQueue = createBoundedQueue(pHandle->pqMaxRows, tsortPQCompFn, destroyTuple, pHandle);
   if (NULL == pHandle->pBoundedQueue) {
     return TSDB_CODE_OUT_OF_MEMORY;
@@ -2734,7 +2843,7 @@ static int32_t tsortOpenForPQSort(SSortHandle* pHandle) {
   while (1) {
     // fetch data
     SSDataBlock* pBlock = NULL;
-    TAOS_CHECK_RETURN(pHandle->fetchfp(source->param, &pBlock));
+    TAOS_CHECK_GOTO(pHandle->fetchfp(source->param, &pBlock), NULL, _end);
     if (NULL == pBlock) {
       break;
     }
@@ -2744,10 +2853,7 @@ static int32_t tsortOpenForPQSort(SSortHandle* pHandle) {
     }
 
     if (pHandle->pDataBlock == NULL) {
-      int32_t code = createOneDataBlock(pBlock, false, &pHandle->pDataBlock);
-      if (code) {
-        return code;
-      }
+      TAOS_CHECK_GOTO(createOneDataBlock(pBlock, false, &pHandle->pDataBlock), NULL, _end);
     }
 
     size_t colNum = blockDataGetNumOfCols(pBlock);
@@ -2756,7 +2862,8 @@ static int32_t tsortOpenForPQSort(SSortHandle* pHandle) {
       for (size_t colIdx = 0; colIdx < colNum; ++colIdx) {
         SColumnInfoData* pCol = taosArrayGet(pBlock->pDataBlock, colIdx);
         if (pCol == NULL) {
-          return terrno;
+          code = terrno;
+          goto _end;
         }
 
         tupleLen += pCol->info.bytes;
@@ -2766,8 +2873,27 @@ static int32_t tsortOpenForPQSort(SSortHandle* pHandle) {
       }
     }
 
+    if (pBlock->info.rows > skipCap) {
+      int8_t* p = taosMemoryRealloc(pSkip, pBlock->info.rows);
+      if (p == NULL) {
+        code = terrno;
+        goto _end;
+      }
+      pSkip = p;
+      skipCap = pBlock->info.rows;
+    }
+
+    bool marked = false;
+    TAOS_CHECK_GOTO(tsortPQMarkSkipRows(pHandle, pBlock, pSkip, &marked), NULL, _end);
+    numOfRows += pBlock->info.rows;
+
     ReferencedTuple refTuple = {.desc.data = (char*)pBlock, .desc.type = ReferencedTupleType, .rowIndex = 0};
     for (size_t rowIdx = 0; rowIdx < pBlock->info.rows; ++rowIdx) {
+      if (marked && pSkip[rowIdx]) {
+        numOfSkipped++;
+        continue;
+      }
+
       refTuple.rowIndex = rowIdx;
       pqNode.data = &refTuple;
       PriorityQueueNode* pPushedNode = taosBQPush(pHandle->pBoundedQueue, &pqNode);
@@ -2775,15 +2901,17 @@ static int32_t tsortOpenForPQSort(SSortHandle* pHandle) {
         // do nothing if push failed
       } else {
         pPushedNode->data = NULL;
-        int32_t code = createAllocatedTuple(pBlock, colNum, tupleLen, rowIdx, (TupleDesc**)&pPushedNode->data);
-        if (code) {
-          return code;
-        }
+        TAOS_CHECK_GOTO(createAllocatedTuple(pBlock, colNum, tupleLen, rowIdx, (TupleDesc**)&pPushedNode->data), NULL,
+                        _end);
       }
     }
   }
 
-  return TSDB_CODE_SUCCESS;
+  qDebug("%s pq sort done, rows:%" PRId64 ", skipped by threshold:%" PRId64, pHandle->idStr, numOfRows, numOfSkipped);
+
+_end:
+  taosMemoryFree(pSkip);
+  return code;
 }
 
 static int32_t tsortPQSortNextTuple(SSortHandle* pHandle, STupleHandle **pTupleHandle) {
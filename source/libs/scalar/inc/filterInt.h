@@ -99,6 +99,7 @@ typedef struct SFilterRange {
 typedef bool (*rangeCompFunc)(const void *, const void *, const void *, const void *, __compar_fn_t);
 typedef int32_t (*filter_desc_compare_func)(const void *, const void *);
 typedef int32_t (*filter_exec_func)(void *, int32_t, SColumnInfoData *, SColumnDataAgg *, int16_t, int32_t *, bool *);
+typedef void (*filter_blk_func)(void *, int32_t, int8_t *);
 typedef int32_t (*filer_get_col_from_name)(void *, int32_t, char *, void **);
 
 typedef struct SFilterDataInfo {
@@ -203,15 +204,19 @@ typedef struct SFilterUnit {
 } SFilterUnit;
 
 typedef struct SFilterComUnit {
-  void    *colData;  // pointer to SColumnInfoData
-  void    *valData;
-  void    *valData2;
-  uint16_t colId;
-  uint16_t dataSize;
-  uint8_t  dataType;
-  uint8_t  optr;
-  int8_t   func;
-  int8_t   rfunc;
+  void           *colData;  // pointer to SColumnInfoData
+  void           *valData;
+  void           *valData2;
+  uint16_t        colId;
+  uint16_t        dataSize;
+  uint8_t         dataType;
+  uint8_t         optr;
+  int8_t          func;
+  int8_t          rfunc;
+  int8_t          blkOptr;  // operator of the block kernel
+  int32_t         inNum;    // number of values in inVals
+  uint64_t       *inVals;   // values of a short IN list, for the block kernel
+  filter_blk_func blkFunc;  // evaluates the unit on all rows of a block, NULL if not supported
 } SFilterComUnit;
 
 typedef struct SFilterPCtx {
@@ -265,6 +270,8 @@ struct SFilterInfo {
   uint32_t          blkGroupNum;
   uint32_t         *blkUnits;
   int8_t           *blkUnitRes;
+  int8_t           *blkGroupRes;     // result of one group of filterExecuteImplBlock, reused across blocks
+  int32_t           blkGroupResCap;  // number of rows blkGroupRes can hold
   void             *pTable;
   SArray           *blkList;
   bool             isStrict;
@@ -504,6 +511,7 @@ struct SFilterInfo {
 extern bool          filterDoCompare(__compar_fn_t func, uint8_t optr, void *left, void *right);
 extern int32_t       filterGetCompFunc(__compar_fn_t *func, int32_t type, int32_t optr);
 extern __compar_fn_t filterGetCompFuncEx(int32_t lType, int32_t rType, int32_t optr);
+extern int32_t       filterSetExecFunc(SFilterInfo *info);
 
 #ifdef __cplusplus
 }
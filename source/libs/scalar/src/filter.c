@@ -2128,9 +2128,15 @@ void filterFreeInfo(SFilterInfo *info) {
   }
   taosArrayDestroy(info->sclCtx.fltSclRange);
 
+  if (info->cunits) {
+    for (uint32_t i = 0; i < info->unitNum; ++i) {
+      taosMemoryFreeClear(info->cunits[i].inVals);
+    }
+  }
   taosMemoryFreeClear(info->cunits);
   taosMemoryFreeClear(info->blkUnitRes);
   taosMemoryFreeClear(info->blkUnits);
+  taosMemoryFreeClear(info->blkGroupRes);
 
   for (int32_t i = 0; i < FLD_TYPE_MAX; ++i) {
     for (uint32_t f = 0; f < info->fields[i].num; ++f) {
@@ -3148,8 +3154,351 @@ int32_t filterPostProcessRange(SFilterInfo *info) {
   return TSDB_CODE_SUCCESS;
 }
 
+enum {
+  FLT_BLK_RANGE_EE = 0,  // the first eight values follow the order of gRangeCompare
+  FLT_BLK_RANGE_EI,
+  FLT_BLK_RANGE_IE,
+  FLT_BLK_RANGE_II,
+  FLT_BLK_GT,
+  FLT_BLK_GE,
+  FLT_BLK_LT,
+  FLT_BLK_LE,
+  FLT_BLK_EQ,
+  FLT_BLK_NE,
+  FLT_BLK_IN,
+  FLT_BLK_NOT_IN,
+  FLT_BLK_IS_NULL,
+  FLT_BLK_IS_NOT_NULL,
+};
+
+#define FLT_BLK_MAX_IN_VALS 16
+#define FLT_BLK_MAX_GROUPS  16
+
+#define FLT_BLK_LOOP(_cond)                   \
+  do {                                        \
+    for (int32_t i = 0; i < numOfRows; ++i) { \
+      p[i] &= (int8_t)(_cond);                \
+    }                                         \
+  } while (0)
+
+// same results as compareFloatVal/compareDoubleVal, where NaN is less than any other value
+#define FLT_BLK_FEQ(_v, _x) (FLT_EQUAL(_v, _x) ? 1 : 0)
+#define FLT_BLK_FGT(_v, _x) ((FLT_BLK_FEQ(_v, _x) ^ 1) & ((_v) > (_x)))
+#define FLT_BLK_FGE(_v, _x) (FLT_BLK_FEQ(_v, _x) | ((_v) > (_x)))
+#define FLT_BLK_FLT(_v, _x) (((_v) != (_v)) | ((FLT_BLK_FEQ(_v, _x) ^ 1) & ((_v) < (_x))))
+#define FLT_BLK_FLE(_v, _x) (((_v) != (_v)) | FLT_BLK_FEQ(_v, _x) | ((_v) < (_x)))
+
+#define FLT_BLK_DEFINE_INT_KERNEL(_name, _type)                                         \
+  static void _name(void *pUnit, int32_t numOfRows, int8_t *p) {                        \
+    SFilterComUnit *cunit = (SFilterComUnit *)pUnit;                                    \
+    const _type    *v = (const _type *)((SColumnInfoData *)cunit->colData)->pData;      \
+    _type           lo = *(const _type *)cunit->valData;                                \
+    _type           hi = *(const _type *)cunit->valData2;                               \
+    switch (cunit->blkOptr) {                                                           \
+      case FLT_BLK_RANGE_EE:                                                            \
+        FLT_BLK_LOOP((v[i] > lo) & (v[i] < hi));                                        \
+        break;                                                                          \
+      case FLT_BLK_RANGE_EI:                                                            \
+        FLT_BLK_LOOP((v[i] > lo) & (v[i] <= hi));                                       \
+        break;                                                                          \
+      case FLT_BLK_RANGE_IE:                                                            \
+        FLT_BLK_LOOP((v[i] >= lo) & (v[i] < hi));                                       \
+        break;                                                                          \
+      case FLT_BLK_RANGE_II:                                                            \
+        FLT_BLK_LOOP((v[i] >= lo) & (v[i] <= hi));                                      \
+        break;                                                                          \
+      case FLT_BLK_GT:                                                                  \
+        FLT_BLK_LOOP(v[i] > lo);                                                        \
+        break;                                                                          \
+      case FLT_BLK_GE:                                                                  \
+        FLT_BLK_LOOP(v[i] >= lo);                                                       \
+        break;                                                                          \
+      case FLT_BLK_LT:                                                                  \
+        FLT_BLK_LOOP(v[i] < hi);                                                        \
+        break;                                                                          \
+      case FLT_BLK_LE:                                                                  \
+        FLT_BLK_LOOP(v[i] <= hi);                                                       \
+        break;                                                                          \
+      case FLT_BLK_EQ:                                                                  \
+        FLT_BLK_LOOP(v[i] == lo);                                                       \
+        break;                                                                          \
+      case FLT_BLK_NE:                                                                  \
+        FLT_BLK_LOOP(v[i] != lo);                                                       \
+        break;                                                                          \
+      default:                                                                          \
+        break;                                                                          \
+    }                                                                                   \
+  }
+
+#define FLT_BLK_DEFINE_FLOAT_KERNEL(_name, _type)                                       \
+  static void _name(void *pUnit, int32_t numOfRows, int8_t *p) {                        \
+    SFilterComUnit *cunit = (SFilterComUnit *)pUnit;                                    \
+    const _type    *v = (const _type *)((SColumnInfoData *)cunit->colData)->pData;      \
+    _type           lo = *(const _type *)cunit->valData;                                \
+    _type           hi = *(const _type *)cunit->valData2;                               \
+    switch (cunit->blkOptr) {                                                           \
+      case FLT_BLK_RANGE_EE:                                                            \
+        FLT_BLK_LOOP(FLT_BLK_FGT(v[i], lo) & FLT_BLK_FLT(v[i], hi));                    \
+        break;                                                                          \
+      case FLT_BLK_RANGE_EI:                                                            \
+        FLT_BLK_LOOP(FLT_BLK_FGT(v[i], lo) & FLT_BLK_FLE(v[i], hi));                    \
+        break;                                                                          \
+      case FLT_BLK_RANGE_IE:                                                            \
+        FLT_BLK_LOOP(FLT_BLK_FGE(v[i], lo) & FLT_BLK_FLT(v[i], hi));                    \
+        break;                                                                          \
+      case FLT_BLK_RANGE_II:                                                            \
+        FLT_BLK_LOOP(FLT_BLK_FGE(v[i], lo) & FLT_BLK_FLE(v[i], hi));                    \
+        break;                                                                          \
+      case FLT_BLK_GT:                                                                  \
+        FLT_BLK_LOOP(FLT_BLK_FGT(v[i], lo));                                            \
+        break;                                                                          \
+      case FLT_BLK_GE:                                                                  \
+        FLT_BLK_LOOP(FLT_BLK_FGE(v[i], lo));                                            \
+        break;                                                                          \
+      case FLT_BLK_LT:                                                                  \
+        FLT_BLK_LOOP(FLT_BLK_FLT(v[i], hi));                                            \
+        break;                                                                          \
+      case FLT_BLK_LE:                                                                  \
+        FLT_BLK_LOOP(FLT_BLK_FLE(v[i], hi));                                            \
+        break;                                                                          \
+      case FLT_BLK_EQ:                                                                  \
+        FLT_BLK_LOOP(FLT_BLK_FEQ(v[i], lo));                                            \
+        break;                                                                          \
+      case FLT_BLK_NE:                                                                  \
+        FLT_BLK_LOOP(FLT_BLK_FEQ(v[i], lo) ^ 1);                                        \
+        break;                                                                          \
+      default:                                                                          \
+        break;                                                                          \
+    }                                                                                   \
+  }
+
+// IN lists are matched on the bit pattern of the value, the same as the hash lookup of setChkInBytesN
+#define FLT_BLK_DEFINE_IN_KERNEL(_name, _type)                                          \
+  static void _name(void *pUnit, int32_t numOfRows, int8_t *p) {                        \
+    SFilterComUnit *cunit = (SFilterComUnit *)pUnit;                                    \
+    const _type    *v = (const _type *)((SColumnInfoData *)cunit->colData)->pData;      \
+    _type           vals[FLT_BLK_MAX_IN_VALS];                                          \
+    int32_t         num = cunit->inNum;                                                 \
+    int8_t          neg = (cunit->blkOptr == FLT_BLK_NOT_IN) ? 1 : 0;                   \
+    for (int32_t k = 0; k < num; ++k) {                                                 \
+      vals[k] = (_type)cunit->inVals[k];                                                \
+    }                                                                                   \
+    for (int32_t i = 0; i < numOfRows; ++i) {                                           \
+      int8_t hit = 0;                                                                   \
+      for (int32_t k = 0; k < num; ++k) {                                               \
+        hit |= (int8_t)(v[i] == vals[k]);                                               \
+      }                                                                                 \
+      p[i] &= hit ^ neg;                                                                \
+    }                                                                                   \
+  }
+
+FLT_BLK_DEFINE_INT_KERNEL(filterBlkCompInt8, int8_t)
+FLT_BLK_DEFINE_INT_KERNEL(filterBlkCompInt16, int16_t)
+FLT_BLK_DEFINE_INT_KERNEL(filterBlkCompInt32, int32_t)
+FLT_BLK_DEFINE_INT_KERNEL(filterBlkCompInt64, int64_t)
+FLT_BLK_DEFINE_INT_KERNEL(filterBlkCompUint8, uint8_t)
+FLT_BLK_DEFINE_INT_KERNEL(filterBlkCompUint16, uint16_t)
+FLT_BLK_DEFINE_INT_KERNEL(filterBlkCompUint32, uint32_t)
+FLT_BLK_DEFINE_INT_KERNEL(filterBlkCompUint64, uint64_t)
+FLT_BLK_DEFINE_FLOAT_KERNEL(filterBlkCompFloat, float)
+FLT_BLK_DEFINE_FLOAT_KERNEL(filterBlkCompDouble, double)
+FLT_BLK_DEFINE_IN_KERNEL(filterBlkIn8, uint8_t)
+FLT_BLK_DEFINE_IN_KERNEL(filterBlkIn16, uint16_t)
+FLT_BLK_DEFINE_IN_KERNEL(filterBlkIn32, uint32_t)
+FLT_BLK_DEFINE_IN_KERNEL(filterBlkIn64, uint64_t)
+
+static void filterBlkIsNull(void *pUnit, int32_t numOfRows, int8_t *p) {
+  SFilterComUnit  *cunit = (SFilterComUnit *)pUnit;
+  SColumnInfoData *pCol = (SColumnInfoData *)cunit->colData;
+  int8_t           neg = (cunit->blkOptr == FLT_BLK_IS_NOT_NULL) ? 1 : 0;
+
+  if (!pCol->hasNull || (!IS_VAR_DATA_TYPE(pCol->info.type) && pCol->nullbitmap == NULL)) {
+    if (!neg) {
+      (void)memset(p, 0, numOfRows);
+    }
+    return;
+  }
+
+  if (IS_VAR_DATA_TYPE(pCol->info.type)) {
+    const int32_t *offset = pCol->varmeta.offset;
+    FLT_BLK_LOOP((offset[i] == -1) ^ neg);
+  } else {
+    const char *bm = pCol->nullbitmap;
+    FLT_BLK_LOOP(colDataIsNull_f(bm, i) ^ neg);
+  }
+}
+
+static void filterBlkExecUnit(SFilterComUnit *cunit, int32_t numOfRows, int8_t *p) {
+  SColumnInfoData *pCol = (SColumnInfoData *)cunit->colData;
+
+  (*cunit->blkFunc)(cunit, numOfRows, p);
+
+  if (cunit->blkOptr == FLT_BLK_IS_NULL || cunit->blkOptr == FLT_BLK_IS_NOT_NULL) {
+    return;
+  }
+
+  // null rows never satisfy a comparison
+  if (pCol->hasNull && pCol->nullbitmap != NULL) {
+    const char *bm = pCol->nullbitmap;
+    FLT_BLK_LOOP(colDataIsNull_f(bm, i) ^ 1);
+  }
+}
+
+static int32_t filterSetBlkInVals(SFilterComUnit *cunit, SHashObj *pHash, int32_t width) {
+  int32_t num = taosHashGetSize(pHash);
+  if (num > FLT_BLK_MAX_IN_VALS) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  cunit->inVals = taosMemoryCalloc(FLT_BLK_MAX_IN_VALS, sizeof(*cunit->inVals));
+  if (NULL == cunit->inVals) {
+    return terrno;
+  }
+
+  int32_t n = 0;
+  void   *pIter = taosHashIterate(pHash, NULL);
+  while (pIter) {
+    size_t keyLen = 0;
+    void  *key = taosHashGetKey(pIter, &keyLen);
+    if (keyLen != width || n >= FLT_BLK_MAX_IN_VALS) {
+      taosHashCancelIterate(pHash, pIter);
+      taosMemoryFreeClear(cunit->inVals);
+      return TSDB_CODE_SUCCESS;
+    }
+
+    switch (width) {
+      case 1:
+        cunit->inVals[n++] = *(uint8_t *)key;
+        break;
+      case 2:
+        cunit->inVals[n++] = *(uint16_t *)key;
+        break;
+      case 4:
+        cunit->inVals[n++] = *(uint32_t *)key;
+        break;
+      default:
+        cunit->inVals[n++] = *(uint64_t *)key;
+        break;
+    }
+
+    pIter = taosHashIterate(pHash, pIter);
+  }
+
+  cunit->inNum = n;
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t filterSetBlkFunc(SFilterInfo *info, SFilterUnit *unit, SFilterComUnit *cunit) {
+  uint8_t type = cunit->dataType;
+  uint8_t optr = cunit->optr;
+
+  cunit->blkFunc = NULL;
+  cunit->blkOptr = -1;
+  cunit->inVals = NULL;
+  cunit->inNum = 0;
+
+  if (optr == OP_TYPE_IS_NULL || optr == OP_TYPE_IS_NOT_NULL) {
+    cunit->blkOptr = (optr == OP_TYPE_IS_NULL) ? FLT_BLK_IS_NULL : FLT_BLK_IS_NOT_NULL;
+    cunit->blkFunc = filterBlkIsNull;
+    return TSDB_CODE_SUCCESS;
+  }
+
+  if (unit->right.type != FLD_TYPE_VALUE || cunit->valData == NULL || cunit->valData2 == NULL) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  if (optr == OP_TYPE_IN || optr == OP_TYPE_NOT_IN) {
+    if (!IS_NUMERIC_TYPE(type) && type != TSDB_DATA_TYPE_TIMESTAMP) {
+      return TSDB_CODE_SUCCESS;
+    }
+    if (!FILTER_GET_FLAG(FILTER_UNIT_RIGHT_FIELD(info, unit)->flag, FLD_DATA_IS_HASH)) {
+      return TSDB_CODE_SUCCESS;
+    }
+
+    int32_t width = tDataTypes[type].bytes;
+    FLT_ERR_RET(filterSetBlkInVals(cunit, (SHashObj *)cunit->valData, width));
+    if (NULL == cunit->inVals) {
+      return TSDB_CODE_SUCCESS;
+    }
+
+    cunit->blkOptr = (optr == OP_TYPE_IN) ? FLT_BLK_IN : FLT_BLK_NOT_IN;
+    switch (width) {
+      case 1:
+        cunit->blkFunc = filterBlkIn8;
+        break;
+      case 2:
+        cunit->blkFunc = filterBlkIn16;
+        break;
+      case 4:
+        cunit->blkFunc = filterBlkIn32;
+        break;
+      case 8:
+        cunit->blkFunc = filterBlkIn64;
+        break;
+      default:
+        taosMemoryFreeClear(cunit->inVals);
+        cunit->inNum = 0;
+        break;
+    }
+    return TSDB_CODE_SUCCESS;
+  }
+
+  if (cunit->rfunc >= 0) {
+    cunit->blkOptr = cunit->rfunc;
+  } else if (optr == OP_TYPE_EQUAL) {
+    cunit->blkOptr = FLT_BLK_EQ;
+  } else if (optr == OP_TYPE_NOT_EQUAL) {
+    cunit->blkOptr = FLT_BLK_NE;
+  } else {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  switch (type) {
+    case TSDB_DATA_TYPE_TINYINT:
+      cunit->blkFunc = filterBlkCompInt8;
+      break;
+    case TSDB_DATA_TYPE_SMALLINT:
+      cunit->blkFunc = filterBlkCompInt16;
+      break;
+    case TSDB_DATA_TYPE_INT:
+      cunit->blkFunc = filterBlkCompInt32;
+      break;
+    case TSDB_DATA_TYPE_BIGINT:
+    case TSDB_DATA_TYPE_TIMESTAMP:
+      cunit->blkFunc = filterBlkCompInt64;
+      break;
+    case TSDB_DATA_TYPE_UTINYINT:
+      cunit->blkFunc = filterBlkCompUint8;
+      break;
+    case TSDB_DATA_TYPE_USMALLINT:
+      cunit->blkFunc = filterBlkCompUint16;
+      break;
+    case TSDB_DATA_TYPE_UINT:
+      cunit->blkFunc = filterBlkCompUint32;
+      break;
+    case TSDB_DATA_TYPE_UBIGINT:
+      cunit->blkFunc = filterBlkCompUint64;
+      break;
+    case TSDB_DATA_TYPE_FLOAT:
+      // a NaN constant orders differently from the plain comparison, leave it to the generic path
+      if (!isnan(GET_FLOAT_VAL(cunit->valData)) && !isnan(GET_FLOAT_VAL(cunit->valData2))) {
+        cunit->blkFunc = filterBlkCompFloat;
+      }
+      break;
+    case TSDB_DATA_TYPE_DOUBLE:
+      if (!isnan(GET_DOUBLE_VAL(cunit->valData)) && !isnan(GET_DOUBLE_VAL(cunit->valData2))) {
+        cunit->blkFunc = filterBlkCompDouble;
+      }
+      break;
+    default:
+      break;
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
 int32_t filterGenerateComInfo(SFilterInfo *info) {
-  info->cunits = taosMemoryMalloc(info->unitNum * sizeof(*info->cunits));
+  info->cunits = taosMemoryCalloc(info->unitNum, sizeof(*info->cunits));
   info->blkUnitRes = taosMemoryMalloc(sizeof(*info->blkUnitRes) * info->unitNum);
   info->blkUnits = taosMemoryMalloc(sizeof(*info->blkUnits) * (info->unitNum + 1) * info->groupNum);
   if (NULL == info->cunits || NULL == info->blkUnitRes || NULL == info->blkUnits) {
@@ -3178,6 +3527,8 @@ int32_t filterGenerateComInfo(SFilterInfo *info) {
 
     info->cunits[i].dataSize = FILTER_UNIT_COL_SIZE(info, unit);
     info->cunits[i].dataType = FILTER_UNIT_DATA_TYPE(unit);
+
+    FLT_ERR_RET(filterSetBlkFunc(info, unit, &info->cunits[i]));
   }
 
   return TSDB_CODE_SUCCESS;
@@ -3732,6 +4083,82 @@ int32_t filterExecuteImpl(void *pinfo, int32_t numOfRows, SColumnInfoData *pRes,
   FLT_RET(TSDB_CODE_SUCCESS);
 }
 
+static int32_t filterExecuteImplBlock(void *pinfo, int32_t numOfRows, SColumnInfoData *pRes, SColumnDataAgg *statis,
+                                      int16_t numOfCols, int32_t *numOfQualified, bool *all) {
+  SFilterInfo *info = (SFilterInfo *)pinfo;
+  int32_t      result = 0;
+
+  for (uint32_t u = 0; u < info->unitNum; ++u) {
+    SColumnInfoData *pCol = (SColumnInfoData *)info->cunits[u].colData;
+    if (pCol == NULL || pCol->info.type != info->cunits[u].dataType) {
+      return filterExecuteImpl(pinfo, numOfRows, pRes, statis, numOfCols, numOfQualified, all);
+    }
+  }
+
+  *all = true;
+  FLT_ERR_RET(filterExecuteBasedOnStatis(info, numOfRows, pRes, statis, numOfCols, all, &result));
+  if (result == 0) {
+    FLT_RET(TSDB_CODE_SUCCESS);
+  }
+
+  int8_t *p = (int8_t *)pRes->pData;
+  int8_t *gRes = NULL;
+
+  if (info->groupNum > 1) {
+    if (info->blkGroupResCap < numOfRows) {
+      gRes = taosMemoryRealloc(info->blkGroupRes, numOfRows);
+      if (NULL == gRes) {
+        FLT_ERR_RET(terrno);
+      }
+      info->blkGroupRes = gRes;
+      info->blkGroupResCap = numOfRows;
+    }
+    gRes = info->blkGroupRes;
+    (void)memset(p, 0, numOfRows);
+  }
+
+  // units of a group are ANDed, groups are ORed
+  for (uint32_t g = 0; g < info->groupNum; ++g) {
+    SFilterGroup *group = &info->groups[g];
+    int8_t       *r = gRes ? gRes : p;
+
+    (void)memset(r, 1, numOfRows);
+    for (uint32_t u = 0; u < group->unitNum; ++u) {
+      filterBlkExecUnit(&info->cunits[group->unitIdxs[u]], numOfRows, r);
+    }
+
+    if (gRes) {
+      for (int32_t i = 0; i < numOfRows; ++i) {
+        p[i] |= gRes[i];
+      }
+    }
+  }
+
+  int32_t qualified = 0;
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    qualified += p[i];
+  }
+
+  *numOfQualified += qualified;
+  *all = (qualified == numOfRows);
+
+  FLT_RET(TSDB_CODE_SUCCESS);
+}
+
+static bool filterCanExecuteByBlock(SFilterInfo *info) {
+  if (info->groupNum == 0 || info->groupNum > FLT_BLK_MAX_GROUPS) {
+    return false;
+  }
+
+  for (uint32_t i = 0; i < info->unitNum; ++i) {
+    if (info->cunits[i].blkFunc == NULL) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 int32_t filterSetExecFunc(SFilterInfo *info) {
   if (FILTER_ALL_RES(info)) {
     info->func = filterExecuteImplAll;
@@ -3743,6 +4170,11 @@ int32_t filterSetExecFunc(SFilterInfo *info) {
     return TSDB_CODE_SUCCESS;
   }
 
+  if (filterCanExecuteByBlock(info)) {
+    info->func = filterExecuteImplBlock;
+    return TSDB_CODE_SUCCESS;
+  }
+
   if (info->unitNum > 1) {
     info->func = filterExecuteImpl;
     return TSDB_CODE_SUCCESS;
@@ -1420,6 +1420,207 @@ TEST(scalarModelogicTest, diff_columns_or_and_or) {
 }
 #endif
 
+namespace {
+
+// sets the rows of nullRows of the column in slot null, the values under them are kept
+void flttSetNullRows(SSDataBlock *src, int32_t slot, const int32_t *nullRows, int32_t num) {
+  SColumnInfoData *pColumn = (SColumnInfoData *)taosArrayGet(src->pDataBlock, slot);
+  ASSERT_NE(pColumn, nullptr);
+  for (int32_t i = 0; i < num; ++i) {
+    colDataSetNULL(pColumn, nullRows[i]);
+  }
+}
+
+// runs the filter through the block kernels, then through the row-at-a-time path with the kernels cleared, both on
+// the block twice to reuse the buffers kept in the filter, and checks every result against eRes
+void flttCheckBlockExec(SNode *pNode, SSDataBlock *src, const int8_t *eRes) {
+  SFilterInfo *filter = NULL;
+  ASSERT_EQ(filterInitFromNode(pNode, &filter, 0), 0);
+  ASSERT_FALSE(filter->scalarMode);
+
+  SFilterColumnParam param = {(int32_t)taosArrayGetSize(src->pDataBlock), src->pDataBlock};
+  ASSERT_EQ(filterSetDataFromSlotId(filter, &param), 0);
+  for (uint32_t u = 0; u < filter->unitNum; ++u) {
+    ASSERT_NE(filter->cunits[u].blkFunc, nullptr);
+  }
+
+  for (int32_t round = 0; round < 4; ++round) {
+    if (round == 2) {
+      for (uint32_t u = 0; u < filter->unitNum; ++u) {
+        filter->cunits[u].blkFunc = NULL;
+      }
+      ASSERT_EQ(filterSetExecFunc(filter), 0);
+    }
+
+    SColumnInfoData *pRes = NULL;
+    int32_t          status = 0;
+    int32_t          qualified = 0;
+    ASSERT_EQ(filterExecute(filter, src, &pRes, NULL, param.numOfCols, &status), 0);
+    for (int32_t i = 0; i < src->info.rows; ++i) {
+      ASSERT_EQ(((int8_t *)pRes->pData)[i], eRes[i]) << "row:" << i << " round:" << round;
+      qualified += eRes[i];
+    }
+    if (qualified == src->info.rows) {
+      ASSERT_EQ(status, FILTER_RESULT_ALL_QUALIFIED);
+    } else if (qualified == 0) {
+      ASSERT_EQ(status, FILTER_RESULT_NONE_QUALIFIED);
+    } else {
+      ASSERT_EQ(status, FILTER_RESULT_PARTIAL_QUALIFIED);
+    }
+    colDataDestroy(pRes);
+    taosMemoryFree(pRes);
+  }
+
+  filterFreeInfo(filter);
+}
+
+// a filter of one comparison of a double column against a double value, the last row is null
+void flttCheckDoubleCompare(EOperatorType opType, double value, const int8_t *eRes) {
+  SNode       *pLeft = NULL, *pRight = NULL, *opNode = NULL;
+  double       leftv[8] = {1.0, 1.0 + 1e-7, 1.0 - 1e-7, 1.001, 0.5, 2.0, NAN, 1.0};
+  int32_t      nullRows[1] = {7};
+  SSDataBlock *src = NULL;
+  int32_t      rowNum = sizeof(leftv) / sizeof(leftv[0]);
+
+  flttMakeColumnNode(&pLeft, &src, TSDB_DATA_TYPE_DOUBLE, sizeof(double), rowNum, leftv);
+  flttSetNullRows(src, ((SColumnNode *)pLeft)->slotId, nullRows, 1);
+  flttMakeValueNode(&pRight, TSDB_DATA_TYPE_DOUBLE, &value);
+  flttMakeOpNode(&opNode, opType, TSDB_DATA_TYPE_BOOL, pLeft, pRight);
+
+  flttCheckBlockExec(opNode, src, eRes);
+
+  nodesDestroyNode(opNode);
+  blockDataDestroy(src);
+}
+
+// a filter of an IN or NOT IN list of int values on an int column with null rows
+void flttCheckIntInList(EOperatorType opType, const int8_t *eRes) {
+  SNode       *pLeft = NULL, *pRight = NULL, *listNode = NULL, *opNode = NULL;
+  int32_t      leftv[10] = {1, 2, 3, 4, 5, 6, 7, -2, 5, 2};
+  int32_t      rightv[4] = {2, 5, 7, -2};
+  int32_t      nullRows[2] = {1, 8};
+  SSDataBlock *src = NULL;
+  int32_t      rowNum = sizeof(leftv) / sizeof(leftv[0]);
+
+  flttMakeColumnNode(&pLeft, &src, TSDB_DATA_TYPE_INT, sizeof(int32_t), rowNum, leftv);
+  flttSetNullRows(src, ((SColumnNode *)pLeft)->slotId, nullRows, 2);
+  SNodeList *list = NULL;
+  ASSERT_EQ(nodesMakeList(&list), 0);
+  for (int32_t i = 0; i < 4; ++i) {
+    flttMakeValueNode(&pRight, TSDB_DATA_TYPE_INT, &rightv[i]);
+    nodesListAppend(list, pRight);
+  }
+  flttMakeListNode(&listNode, list, TSDB_DATA_TYPE_INT);
+  flttMakeOpNode(&opNode, opType, TSDB_DATA_TYPE_BOOL, pLeft, listNode);
+
+  flttCheckBlockExec(opNode, src, eRes);
+
+  nodesDestroyNode(opNode);
+  blockDataDestroy(src);
+}
+
+}  // namespace
+
+TEST(blockExecTest, double_compare_epsilon_and_nan) {
+  // values within FLT_EQUAL of 1.0 are equal to it, NaN is less than any value, null rows never qualify
+  int8_t eEqual[8] = {1, 1, 1, 0, 0, 0, 0, 0};
+  int8_t eGreater[8] = {0, 0, 0, 1, 0, 1, 0, 0};
+  int8_t eGreaterEqual[8] = {1, 1, 1, 1, 0, 1, 0, 0};
+  int8_t eLower[8] = {0, 0, 0, 0, 1, 0, 1, 0};
+  int8_t eLowerEqual[8] = {1, 1, 1, 0, 1, 0, 1, 0};
+
+  flttCheckDoubleCompare(OP_TYPE_EQUAL, 1.0, eEqual);
+  flttCheckDoubleCompare(OP_TYPE_GREATER_THAN, 1.0, eGreater);
+  flttCheckDoubleCompare(OP_TYPE_GREATER_EQUAL, 1.0, eGreaterEqual);
+  flttCheckDoubleCompare(OP_TYPE_LOWER_THAN, 1.0, eLower);
+  flttCheckDoubleCompare(OP_TYPE_LOWER_EQUAL, 1.0, eLowerEqual);
+}
+
+TEST(blockExecTest, double_range) {
+  SNode       *pLeft1 = NULL, *pRight1 = NULL, *pLeft2 = NULL, *pRight2 = NULL, *opNode1 = NULL, *opNode2 = NULL;
+  SNode       *logicNode = NULL;
+  double       leftv[8] = {1.0, 1.0 + 1e-7, 1.0 - 1e-7, 1.001, 0.5, 2.0, NAN, 1.5};
+  double       lo = 1.0, hi = 2.0;
+  int32_t      nullRows[1] = {7};
+  int8_t       eRes[8] = {1, 1, 1, 1, 0, 0, 0, 0};
+  SSDataBlock *src = NULL;
+  int32_t      rowNum = sizeof(leftv) / sizeof(leftv[0]);
+
+  // c >= 1.0 and c < 2.0 on the same column, merged into one range unit
+  SNodeList *list = NULL;
+  ASSERT_EQ(nodesMakeList(&list), 0);
+  flttMakeColumnNode(&pLeft1, &src, TSDB_DATA_TYPE_DOUBLE, sizeof(double), rowNum, leftv);
+  flttSetNullRows(src, ((SColumnNode *)pLeft1)->slotId, nullRows, 1);
+  flttMakeValueNode(&pRight1, TSDB_DATA_TYPE_DOUBLE, &lo);
+  flttMakeOpNode(&opNode1, OP_TYPE_GREATER_EQUAL, TSDB_DATA_TYPE_BOOL, pLeft1, pRight1);
+  nodesListAppend(list, opNode1);
+
+  flttMakeColumnNode(&pLeft2, NULL, TSDB_DATA_TYPE_DOUBLE, sizeof(double), rowNum, NULL);
+  tstrncpy(((SColumnNode *)pLeft2)->dbName, ((SColumnNode *)pLeft1)->dbName, TSDB_DB_NAME_LEN);
+  flttMakeValueNode(&pRight2, TSDB_DATA_TYPE_DOUBLE, &hi);
+  flttMakeOpNode(&opNode2, OP_TYPE_LOWER_THAN, TSDB_DATA_TYPE_BOOL, pLeft2, pRight2);
+  nodesListAppend(list, opNode2);
+  flttMakeLogicNodeFromList(&logicNode, LOGIC_COND_TYPE_AND, list);
+
+  flttCheckBlockExec(logicNode, src, eRes);
+
+  nodesDestroyNode(logicNode);
+  blockDataDestroy(src);
+}
+
+TEST(blockExecTest, int_in_and_not_in_list) {
+  // null rows qualify for neither IN nor NOT IN
+  int8_t eIn[10] = {0, 0, 0, 0, 1, 0, 1, 1, 0, 1};
+  int8_t eNotIn[10] = {1, 0, 1, 1, 0, 1, 0, 0, 0, 0};
+
+  flttCheckIntInList(OP_TYPE_IN, eIn);
+  flttCheckIntInList(OP_TYPE_NOT_IN, eNotIn);
+}
+
+TEST(blockExecTest, null_rows_and_or_groups) {
+  SNode       *pLeft1 = NULL, *pRight1 = NULL, *pLeft2 = NULL, *pRight2 = NULL, *opNode1 = NULL, *opNode2 = NULL;
+  SNode       *logicNode = NULL;
+  int64_t      leftv1[8] = {1, 5, 9, 3, 7, 0, 10, 4};
+  int16_t      leftv2[8] = {0, 0, 0, 8, 9, 0, 0, 0};
+  int64_t      rightv1 = 6;
+  int16_t      rightv2 = 7;
+  int32_t      nullRows1[2] = {2, 5};
+  int32_t      nullRows2[1] = {4};
+  SSDataBlock *src = NULL;
+  int32_t      rowNum = sizeof(leftv1) / sizeof(leftv1[0]);
+
+  // a > 6 or b is null or b > 7, each a group of its own with its own scratch result
+  SNodeList *list = NULL;
+  ASSERT_EQ(nodesMakeList(&list), 0);
+  flttMakeColumnNode(&pLeft1, &src, TSDB_DATA_TYPE_BIGINT, sizeof(int64_t), rowNum, leftv1);
+  flttSetNullRows(src, ((SColumnNode *)pLeft1)->slotId, nullRows1, 2);
+  flttMakeValueNode(&pRight1, TSDB_DATA_TYPE_BIGINT, &rightv1);
+  flttMakeOpNode(&opNode1, OP_TYPE_GREATER_THAN, TSDB_DATA_TYPE_BOOL, pLeft1, pRight1);
+  nodesListAppend(list, opNode1);
+
+  flttMakeColumnNode(&pLeft2, &src, TSDB_DATA_TYPE_SMALLINT, sizeof(int16_t), rowNum, leftv2);
+  flttSetNullRows(src, ((SColumnNode *)pLeft2)->slotId, nullRows2, 1);
+  flttMakeOpNode(&opNode2, OP_TYPE_IS_NULL, TSDB_DATA_TYPE_BOOL, pLeft2, NULL);
+  nodesListAppend(list, opNode2);
+
+  SNode *pLeft3 = NULL, *pRight3 = NULL, *opNode3 = NULL;
+  flttMakeColumnNode(&pLeft3, NULL, TSDB_DATA_TYPE_SMALLINT, sizeof(int16_t), rowNum, NULL);
+  ((SColumnNode *)pLeft3)->slotId = ((SColumnNode *)pLeft2)->slotId;
+  ((SColumnNode *)pLeft3)->colId = ((SColumnNode *)pLeft2)->colId;
+  tstrncpy(((SColumnNode *)pLeft3)->dbName, ((SColumnNode *)pLeft2)->dbName, TSDB_DB_NAME_LEN);
+  flttMakeValueNode(&pRight3, TSDB_DATA_TYPE_SMALLINT, &rightv2);
+  flttMakeOpNode(&opNode3, OP_TYPE_GREATER_THAN, TSDB_DATA_TYPE_BOOL, pLeft3, pRight3);
+  nodesListAppend(list, opNode3);
+  flttMakeLogicNodeFromList(&logicNode, LOGIC_COND_TYPE_OR, list);
+
+  // row 3: b = 8, row 4: a = 7 and b null, row 6: a = 10; the null a of rows 2 and 5 never qualifies
+  int8_t eRes[8] = {0, 0, 0, 1, 1, 0, 1, 0};
+  flttCheckBlockExec(logicNode, src, eRes);
+
+  nodesDestroyNode(logicNode);
+  blockDataDestroy(src);
+}
+
 template <class SignedT, class UnsignedT>
 int32_t compareSignedWithUnsigned(SignedT l, UnsignedT r) {
   if (l < 0) return -1;
@@ -1274,6 +1274,45 @@ int64_t taosPReadFile(TdFilePtr pFile, void *buf, int64_t count, int64_t offset)
   return ret;
 }
 
+int32_t taosReadAheadFile(TdFilePtr pFile, int64_t offset, int64_t count) {
+  if (pFile == NULL || count <= 0) {
+    return 0;
+  }
+
+  int32_t code = 0;
+
+#ifdef WINDOWS
+  // no equivalent hint, the cache manager does its own read-ahead
+#else
+#if FILE_WITH_LOCK
+  (void)taosThreadRwlockRdlock(&(pFile->rwlock));
+#endif
+
+  if (pFile->fd >= 0) {
+#if defined(_TD_DARWIN_64)
+    struct radvisory ra = {.ra_offset = offset, .ra_count = (int)TMIN(count, INT32_MAX)};
+    if (-1 == fcntl(pFile->fd, F_RDADVISE, &ra)) {
+      code = TAOS_SYSTEM_ERROR(errno);
+    }
+#else
+    int ret = posix_fadvise(pFile->fd, offset, count, POSIX_FADV_WILLNEED);
+    if (0 != ret) {
+      code = TAOS_SYSTEM_ERROR(ret);
+    }
+#endif
+  }
+
+#if FILE_WITH_LOCK
+  (void)taosThreadRwlockUnlock(&(pFile->rwlock));
+#endif
+#endif
+
+  if (code) {
+    terrno = code;
+  }
+  return code;
+}
+
 int32_t taosFsyncFile(TdFilePtr pFile) {
   if (pFile == NULL) {
     return 0;
@@ -323,6 +323,7 @@ static const int32_t TEST_NUMBER = 1;
 #define SIMPLE8B_MAX_INT64 ((uint64_t)1152921504606846974LL)
 
 #define safeInt64Add(a, b) (((a >= 0) && (b <= INT64_MAX - a)) || ((a < 0) && (b >= INT64_MIN - a)))
+#define TS_COMPRESS_SIMD_BATCH 256
 
 bool lossyFloat = false;
 bool lossyDouble = false;
@@ -576,10 +577,17 @@ int32_t tsDecompressINTImp(const char *const input, const int32_t nelements, cha
 /* ----------------------------------------------Bool Compression ---------------------------------------------- */
 // TODO: You can also implement it using RLE method.
 int32_t tsCompressBoolImp(const char *const input, const int32_t nelements, char *const output) {
-  int32_t pos = -1;
+  int32_t i = 0;
   int32_t ele_per_byte = BITS_PER_BYTE / 2;
 
-  for (int32_t i = 0; i < nelements; i++) {
+  if (tsSIMDEnable && tsAVX2Supported) {
+    // packs whole bytes only, and leaves invalid values to the loop below to report
+    i = tsCompressBoolImpAvx2(input, nelements, output);
+    if (i < 0) i = 0;
+  }
+
+  int32_t pos = i / ele_per_byte - 1;
+  for (; i < nelements; i++) {
     if (i % ele_per_byte == 0) {
       pos++;
       output[pos] = 0;
@@ -607,10 +615,16 @@ int32_t tsCompressBoolImp(const char *const input, const int32_t nelements, char
 }
 
 int32_t tsDecompressBoolImp(const char *const input, const int32_t nelements, char *const output) {
-  int32_t ipos = -1, opos = 0;
+  int32_t i = 0;
   int32_t ele_per_byte = BITS_PER_BYTE / 2;
 
-  for (int32_t i = 0; i < nelements; i++) {
+  if (tsSIMDEnable && tsAVX2Supported) {
+    i = tsDecompressBoolImpAvx2(input, nelements, output);
+    if (i < 0) i = 0;
+  }
+
+  int32_t ipos = i / ele_per_byte - 1, opos = i;
+  for (; i < nelements; i++) {
     if (i % ele_per_byte == 0) {
       ipos++;
     }
@@ -778,14 +792,39 @@ int32_t tsCompressTimestampImp(const char *const input, const int32_t nelements,
   uint8_t  flags = 0, flag1 = 0, flag2 = 0;
   uint64_t dd1 = 0, dd2 = 0;
 
+  // with AVX2 the zigzag encoded delta of deltas are computed in batches ahead of the byte packing
+  uint64_t zigzags[TS_COMPRESS_SIMD_BATCH];
+  int32_t  nzigzag = 0, izigzag = 0;
+  bool     simd = tsSIMDEnable && tsAVX2Supported;
+
   for (int32_t i = 0; i < nelements; i++) {
-    int64_t curr_value = istream[i];
-    if (!safeInt64Add(curr_value, -prev_value)) goto _exit_over;
-    int64_t curr_delta = curr_value - prev_value;
-    if (!safeInt64Add(curr_delta, -prev_delta)) goto _exit_over;
-    int64_t delta_of_delta = curr_delta - prev_delta;
-    // zigzag encode the value.
-    uint64_t zigzag_value = ZIGZAG_ENCODE(int64_t, delta_of_delta);
+    uint64_t zigzag_value;
+    if (simd && izigzag == nzigzag && i >= 2) {
+      nzigzag = tsCompressTimestampDeltaAvx2(istream, i, TMIN(TS_COMPRESS_SIMD_BATCH, nelements - i), zigzags);
+      if (nzigzag < 0) goto _exit_over;
+      izigzag = 0;
+      if (nzigzag == 0) {
+        // the rest is shorter than a vector
+        simd = false;
+        prev_value = istream[i - 1];
+        prev_delta = istream[i - 1] - istream[i - 2];
+      }
+    }
+
+    if (izigzag < nzigzag) {
+      zigzag_value = zigzags[izigzag++];
+    } else {
+      int64_t curr_value = istream[i];
+      if (!safeInt64Add(curr_value, -prev_value)) goto _exit_over;
+      int64_t curr_delta = curr_value - prev_value;
+      if (!safeInt64Add(curr_delta, -prev_delta)) goto _exit_over;
+      int64_t delta_of_delta = curr_delta - prev_delta;
+      // zigzag encode the value.
+      zigzag_value = ZIGZAG_ENCODE(int64_t, delta_of_delta);
+      prev_value = curr_value;
+      prev_delta = curr_delta;
+    }
+
     if (i % 2 == 0) {
       flags = 0;
       dd1 = zigzag_value;
@@ -826,8 +865,6 @@ int32_t tsCompressTimestampImp(const char *const input, const int32_t nelements,
       }
       _pos += flag2;
     }
-    prev_value = curr_value;
-    prev_delta = curr_delta;
   }
 
   if (nelements % 2 == 1) {
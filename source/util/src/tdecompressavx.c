@@ -601,3 +601,105 @@ int32_t tsDecompressTimestampAvx512(const char *const input, const int32_t nelem
   return -1;
 #endif
 }
+
+int32_t tsCompressTimestampDeltaAvx2(const int64_t *input, int32_t start, int32_t nelements, uint64_t *output) {
+#ifdef __AVX2__
+  if (start < 2) {
+    return 0;
+  }
+
+  // a - b overflows if a and b have different signs and the sign of the result differs from a
+  __m256i overflow = _mm256_setzero_si256();
+  __m256i zero = _mm256_setzero_si256();
+  int32_t i = 0;
+
+  for (; i + 4 <= nelements; i += 4) {
+    const int64_t *p = input + start + i;
+    __m256i        x0 = _mm256_loadu_si256((const __m256i *)p);
+    __m256i        x1 = _mm256_loadu_si256((const __m256i *)(p - 1));
+    __m256i        x2 = _mm256_loadu_si256((const __m256i *)(p - 2));
+    __m256i        d0 = _mm256_sub_epi64(x0, x1);
+    __m256i        d1 = _mm256_sub_epi64(x1, x2);
+    __m256i        dd = _mm256_sub_epi64(d0, d1);
+
+    overflow = _mm256_or_si256(overflow, _mm256_and_si256(_mm256_xor_si256(x0, x1), _mm256_xor_si256(x0, d0)));
+    overflow = _mm256_or_si256(overflow, _mm256_and_si256(_mm256_xor_si256(x1, x2), _mm256_xor_si256(x1, d1)));
+    overflow = _mm256_or_si256(overflow, _mm256_and_si256(_mm256_xor_si256(d0, d1), _mm256_xor_si256(d0, dd)));
+
+    // zigzag encode, there is no 64 bits arithmetic right shift in AVX2
+    __m256i sign = _mm256_cmpgt_epi64(zero, dd);
+    _mm256_storeu_si256((__m256i *)(output + i), _mm256_xor_si256(_mm256_slli_epi64(dd, 1), sign));
+  }
+
+  if (_mm256_movemask_pd(_mm256_castsi256_pd(overflow))) {
+    return -1;
+  }
+  return i;
+#else
+  uError("unable run %s without avx2 instructions", __func__);
+  return -1;
+#endif
+}
+
+int32_t tsCompressBoolImpAvx2(const char *const input, const int32_t nelements, char *const output) {
+#ifdef __AVX2__
+  int32_t i = 0;
+  __m256i invalid = _mm256_setzero_si256();
+  __m256i maxValue = _mm256_set1_epi8(TSDB_DATA_BOOL_NULL);
+  __m256i weight2 = _mm256_set1_epi16(0x0401);
+  __m256i weight4 = _mm256_set1_epi32(0x00100001);
+  // the packed byte is the lowest byte of each 32 bits lane
+  __m256i gather = _mm256_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 4, 8, 12, -1, -1,
+                                    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+
+  for (; i + 32 <= nelements; i += 32) {
+    __m256i v = _mm256_loadu_si256((const __m256i *)(input + i));
+    invalid = _mm256_or_si256(invalid, _mm256_xor_si256(_mm256_min_epu8(v, maxValue), v));
+
+    // b0 | b1 << 2 | b2 << 4 | b3 << 6 for every 4 values
+    __m256i packed = _mm256_madd_epi16(_mm256_maddubs_epi16(v, weight2), weight4);
+    packed = _mm256_shuffle_epi8(packed, gather);
+    packed = _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 4, 1, 1, 1, 1, 1, 1));
+    _mm_storel_epi64((__m128i *)(output + i / 4), _mm256_castsi256_si128(packed));
+  }
+
+  if (!_mm256_testz_si256(invalid, invalid)) {
+    return -1;
+  }
+  return i;
+#else
+  uError("unable run %s without avx2 instructions", __func__);
+  return -1;
+#endif
+}
+
+int32_t tsDecompressBoolImpAvx2(const char *const input, const int32_t nelements, char *const output) {
+#ifdef __AVX2__
+  int32_t i = 0;
+  // output byte j takes the 2 bits at position j % 4 of input byte j / 4
+  __m256i spread = _mm256_setr_epi8(0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 6, 6, 6, 6,
+                                    7, 7, 7, 7);
+  __m256i mask = _mm256_set1_epi32(0xC0300C03);
+  __m256i one = _mm256_set1_epi32(0x40100401);
+  __m256i two = _mm256_set1_epi32(0x80200802);
+
+  for (; i + 32 <= nelements; i += 32) {
+    int64_t bits;
+    memcpy(&bits, input + i / 4, sizeof(bits));
+
+    // the shuffle works within 128 bits lanes, so put the low 4 bytes in the low lane and the high ones in the high
+    __m256i v = _mm256_setr_epi32((int32_t)bits, 0, 0, 0, (int32_t)(bits >> 32), 0, 0, 0);
+    v = _mm256_shuffle_epi8(v, _mm256_and_si256(spread, _mm256_set1_epi8(3)));
+    v = _mm256_and_si256(v, mask);
+
+    __m256i isTrue = _mm256_and_si256(_mm256_cmpeq_epi8(v, one), _mm256_set1_epi8(1));
+    __m256i isNull = _mm256_and_si256(_mm256_cmpeq_epi8(v, two), _mm256_set1_epi8(TSDB_DATA_BOOL_NULL));
+    _mm256_storeu_si256((__m256i *)(output + i), _mm256_or_si256(isTrue, isNull));
+  }
+
+  return i;
+#else
+  uError("unable run %s without avx2 instructions", __func__);
+  return -1;
+#endif
+}
@@ -655,3 +655,130 @@ TEST(utilTest, decompressTimestampPerf) {
   refreshSeed();
   decompressPerfTest<int64_t>("timestamp", tsCompressTimestamp, tsDecompressTimestamp, 0, 1000000000L);
 }
+
+#ifdef __AVX2__
+// the AVX2 paths are built in but only taken when the cpu has AVX2, as the server decides at startup
+static bool cpuHasAvx2() {
+  char sse42 = 0, avx = 0, avx2 = 0, fma = 0, avx512 = 0;
+  if (taosGetCpuInstructions(&sse42, &avx, &avx2, &fma, &avx512) != 0) {
+    return false;
+  }
+  return avx2 != 0;
+}
+
+// restores the SIMD switches the tests flip, so the tests after them run with the detected ones
+struct SimdFlagsGuard {
+  SimdFlagsGuard() : simdEnable(tsSIMDEnable), avx2Supported(tsAVX2Supported) {}
+  ~SimdFlagsGuard() {
+    tsSIMDEnable = simdEnable;
+    tsAVX2Supported = avx2Supported;
+  }
+
+  char simdEnable;
+  char avx2Supported;
+};
+
+template <typename T, typename CompF>
+static void compressSimdTest(const char* typname, std::vector<T>& origData, const CompF& compress,
+                             int32_t nround) {
+  std::vector<char> compData1(origData.size() * sizeof(T) + 1);
+  std::vector<char> compData2(origData.size() * sizeof(T) + 1);
+
+  tsSIMDEnable = 0;
+  int32_t cnt1 = compress(origData.data(), origData.size() * sizeof(T), origData.size(), compData1.data(),
+                          compData1.size(), ONE_STAGE_COMP, nullptr, 0);
+  auto    ms1 = measureRunTime(
+      [&]() {
+        compress(origData.data(), origData.size() * sizeof(T), origData.size(), compData1.data(), compData1.size(),
+                 ONE_STAGE_COMP, nullptr, 0);
+      },
+      nround);
+
+  tsSIMDEnable = 1;
+  tsAVX2Supported = 1;
+  int32_t cnt2 = compress(origData.data(), origData.size() * sizeof(T), origData.size(), compData2.data(),
+                          compData2.size(), ONE_STAGE_COMP, nullptr, 0);
+  auto    ms2 = measureRunTime(
+      [&]() {
+        compress(origData.data(), origData.size() * sizeof(T), origData.size(), compData2.data(), compData2.size(),
+                 ONE_STAGE_COMP, nullptr, 0);
+      },
+      nround);
+
+  // the SIMD encoders must produce exactly the same bytes
+  ASSERT_EQ(cnt1, cnt2);
+  ASSERT_EQ(0, memcmp(compData1.data(), compData2.data(), cnt1));
+  if (nround > 1) {
+    std::cout << "Compression of " << nround * origData.size() << " " << typname << " without SIMD costs " << ms1
+              << " ms, using AVX2 costs " << ms2 << " ms\n";
+  }
+}
+
+TEST(utilTest, compressTimestampSimd) {
+  if (!cpuHasAvx2()) GTEST_SKIP();
+  SimdFlagsGuard guard;
+  refreshSeed();
+  for (int32_t r = 1; r <= 1024; ++r) {
+    std::vector<int64_t> data(r);
+    int64_t              ts = 1700000000000L;
+    for (auto& v : data) v = (ts += 1000 + taosRand() % 3);
+    compressSimdTest<int64_t>("timestamp", data, tsCompressTimestamp, 1);
+  }
+}
+
+// a benchmark, run it with --gtest_also_run_disabled_tests
+TEST(utilTest, DISABLED_compressTimestampSimdPerf) {
+  if (!cpuHasAvx2()) GTEST_SKIP();
+  SimdFlagsGuard guard;
+  refreshSeed();
+  std::vector<int64_t> data(1 * 1024 * 1024);
+  int64_t              ts = 1700000000000L;
+  for (auto& v : data) v = (ts += 1000 + taosRand() % 3);
+  compressSimdTest<int64_t>("timestamp", data, tsCompressTimestamp, 100);
+}
+
+TEST(utilTest, compressBoolSimd) {
+  if (!cpuHasAvx2()) GTEST_SKIP();
+  SimdFlagsGuard guard;
+  refreshSeed();
+  for (int32_t r = 1; r <= 1024; ++r) {
+    std::vector<int8_t> data(r);
+    for (auto& v : data) v = taosRand() % 3;
+    compressSimdTest<int8_t>("bool", data, tsCompressBool, 1);
+
+    // and decode them back with SIMD
+    std::vector<char>   compData(r + 1);
+    std::vector<int8_t> decompData(r);
+    int32_t cnt = tsCompressBool(data.data(), r, r, compData.data(), compData.size(), ONE_STAGE_COMP, nullptr, 0);
+    ASSERT_EQ(r, tsDecompressBool(compData.data(), cnt, r, decompData.data(), r, ONE_STAGE_COMP, nullptr, 0));
+    ASSERT_EQ(data, decompData);
+  }
+}
+
+// a benchmark, run it with --gtest_also_run_disabled_tests
+TEST(utilTest, DISABLED_compressBoolSimdPerf) {
+  if (!cpuHasAvx2()) GTEST_SKIP();
+  SimdFlagsGuard guard;
+  refreshSeed();
+  std::vector<int8_t> data(1 * 1024 * 1024);
+  for (auto& v : data) v = taosRand() % 3;
+  compressSimdTest<int8_t>("bool", data, tsCompressBool, 100);
+
+  std::vector<char>   compData(data.size() + 1);
+  std::vector<int8_t> decompData(data.size());
+  int32_t cnt = tsCompressBool(data.data(), data.size(), data.size(), compData.data(), compData.size(), ONE_STAGE_COMP,
+                               nullptr, 0);
+  double  ms[2];
+  for (int32_t simd = 0; simd < 2; ++simd) {
+    tsSIMDEnable = simd;
+    ms[simd] = measureRunTime(
+        [&]() {
+          tsDecompressBool(compData.data(), cnt, data.size(), decompData.data(), decompData.size(), ONE_STAGE_COMP,
+                           nullptr, 0);
+        },
+        100);
+  }
+  std::cout << "Decompression of " << 100 * data.size() << " bool without SIMD costs " << ms[0]
+            << " ms, using AVX2 costs " << ms[1] << " ms\n";
+}
+#endif
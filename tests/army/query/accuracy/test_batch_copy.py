@@ -0,0 +1,92 @@
+from frame.log import *
+from frame.cases import *
+from frame.sql import *
+from frame.caseBase import *
+from frame import *
+from frame.eos import *
+import copy
+
+
+class TDTestCase(TBase):
+    """Verify that the columns of clean file blocks, copied with the null bitmap translated a byte at a time and the
+       var data values copied in a batch, return the same rows as the row by row copy of descending scans
+    """
+
+    def init(self, conn, logSql, replicaVar=1):
+        self.replicaVar = int(replicaVar)
+        tdLog.debug("start to execute %s" % __file__)
+        tdSql.init(conn.cursor())
+        self.numOfRows = 3000
+        self.startTs = 1700000000000
+
+    def is_null(self, table, j):
+        return table in ("t_null", "t_mixed") and j % 3 == 0
+
+    def is_none(self, table, j):
+        return table in ("t_none", "t_mixed") and j % 4 == 1
+
+    def insert(self, table):
+        for k in range(0, self.numOfRows, 1000):
+            sql = f"insert into db_bc.{table} values"
+            partial = f"insert into db_bc.{table} (ts) values"
+            numOfPartial = 0
+            for j in range(k, k + 1000):
+                if self.is_none(table, j):
+                    partial += f"({self.startTs + j * 1000})"
+                    numOfPartial += 1
+                elif self.is_null(table, j):
+                    sql += f"({self.startTs + j * 1000}, null, null, null, null, null, null, null, null, null)"
+                else:
+                    sql += (f"({self.startTs + j * 1000}, {j}, {j * 1000003}, {j * 0.5}, {j % 30000}, {j % 100}, "
+                            f"{j % 2 == 0}, {j * 0.25}, 'v{j % 97}{'x' * (j % 10)}', 'n{j}')")
+            tdSql.execute(sql)
+            if numOfPartial > 0:
+                tdSql.execute(partial)
+
+    def prepare_db(self):
+        tdSql.execute("create database db_bc vgroups 1 stt_trigger 1 minrows 10 maxrows 1000;")
+        # t_value has values only, t_null null rows, t_none rows without the columns, t_mixed both of them, whose
+        # bitmap takes two bits a row
+        for t in ["t_value", "t_null", "t_none", "t_mixed"]:
+            tdSql.execute(f"create table db_bc.{t} (ts timestamp, c1 int, c2 bigint, c3 double, c4 smallint, "
+                          f"c5 tinyint, c6 bool, c7 float, c8 varchar(32), c9 nchar(16));")
+            self.insert(t)
+        tdSql.execute("flush database db_bc;")
+
+    def check_table(self, table):
+        # the dumps of whole blocks start on a byte of the bitmap, those of the ranges below mostly do not
+        for cond in ["", f"where ts >= {self.startTs + 13000}", f"where ts >= {self.startTs + 1000000} "
+                     f"and ts < {self.startTs + 2400000}"]:
+            tdSql.query(f"select * from db_bc.{table} {cond} order by ts;")
+            asc = copy.deepcopy(tdSql.res)
+            tdSql.query(f"select * from db_bc.{table} {cond} order by ts desc;")
+            desc = copy.deepcopy(tdSql.res)
+            desc.reverse()
+            if asc != desc:
+                tdLog.exit(f"{table} {cond} returns different rows in ascending and descending order")
+
+        tdSql.query(f"select c1, c8, c9 from db_bc.{table} order by ts;")
+        tdSql.checkRows(self.numOfRows)
+        for j in range(self.numOfRows):
+            if self.is_null(table, j) or self.is_none(table, j):
+                expect = [None, None, None]
+            else:
+                expect = [j, f"v{j % 97}{'x' * (j % 10)}", f"n{j}"]
+            if list(tdSql.res[j]) != expect:
+                tdLog.exit(f"{table} row {j} returns {tdSql.res[j]}, expect {expect}")
+
+    def test_batch_copy(self):
+        self.prepare_db()
+        for t in ["t_value", "t_null", "t_none", "t_mixed"]:
+            self.check_table(t)
+
+    def run(self):
+        self.test_batch_copy()
+
+    def stop(self):
+        tdSql.execute("drop database if exists db_bc;")
+        tdSql.close()
+        tdLog.success("%s successfully executed" % __file__)
+
+tdCases.addWindows(__file__, TDTestCase())
+tdCases.addLinux(__file__, TDTestCase())
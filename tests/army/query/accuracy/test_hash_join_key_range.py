@@ -0,0 +1,87 @@
+from frame.log import *
+from frame.cases import *
+from frame.sql import *
+from frame.caseBase import *
+from frame import *
+from frame.eos import *
+import copy
+
+
+class TDTestCase(TBase):
+    """Verify that skipping the probe rows out of the key range of the build side of an inner hash join returns the
+       same rows as the merge join
+    """
+
+    def init(self, conn, logSql, replicaVar=1):
+        self.replicaVar = int(replicaVar)
+        tdLog.debug("start to execute %s" % __file__)
+        tdSql.init(conn.cursor())
+        self.startTs = 1700000000000
+
+    def insert(self, table, rows):
+        for k in range(0, len(rows), 2000):
+            sql = f"insert into db_hjr.{table} values"
+            for j in rows[k:k + 2000]:
+                k1 = "null" if j % 17 == 0 else f"{j // 3}"
+                sql += f"({self.startTs + j * 1000}, {j}, {k1}, {j % 100}, {j % 200}, {j * 10}, 'v{j % 13}')"
+            tdSql.execute(sql)
+
+    def prepare_db(self):
+        tdSql.execute("create database db_hjr vgroups 1 stt_trigger 1 minrows 10 maxrows 1000;")
+        for t in ["ta", "tb", "tc", "td"]:
+            tdSql.execute(f"create table db_hjr.{t} (ts timestamp, c1 int, k1 int, k2 tinyint, k3 smallint unsigned, "
+                          f"k4 bigint, c4 varchar(16));")
+
+        # tb overlaps the second half of ta, tc is disjoint from ta, td holds sparse rows inside and around ta
+        self.insert("ta", list(range(0, 10000)))
+        self.insert("tb", list(range(5000, 15000)))
+        self.insert("tc", list(range(20000, 30000)))
+        self.insert("td", list(range(-500, 10500, 97)))
+        tdSql.execute("flush database db_hjr;")
+        # rows in the memtable as well
+        self.insert("tb", list(range(15000, 15100)))
+        self.insert("tc", list(range(30000, 30100)))
+
+    def query_all(self, hint):
+        results = []
+        for l, r in [("ta", "tb"), ("tb", "ta"), ("ta", "tc"), ("tc", "ta"), ("ta", "td"), ("td", "tb")]:
+            sqls = [
+                f"select {hint} count(*), sum(a.c1), sum(b.c1) from db_hjr.{l} a join db_hjr.{r} b on a.ts = b.ts;",
+                f"select {hint} a.ts, a.c1, b.c1, b.c4 from db_hjr.{l} a join db_hjr.{r} b "
+                f"on a.ts = b.ts and a.k1 = b.k1 order by a.ts;",
+                f"select {hint} count(*), sum(a.k1) from db_hjr.{l} a join db_hjr.{r} b on a.ts = b.ts and a.k2 = b.k2;",
+                f"select {hint} count(*), sum(b.k3) from db_hjr.{l} a join db_hjr.{r} b on a.ts = b.ts and a.k3 = b.k3;",
+                f"select {hint} count(*), max(a.k4) from db_hjr.{l} a join db_hjr.{r} b "
+                f"on a.ts = b.ts and a.k4 = b.k4 where a.c1 % 3 = 0;",
+                f"select {hint} count(*), count(b.c1) from db_hjr.{l} a left join db_hjr.{r} b "
+                f"on a.ts = b.ts and a.k1 = b.k1;",
+            ]
+            for sql in sqls:
+                tdSql.query(sql)
+                results.append((sql, copy.deepcopy(tdSql.res)))
+        return results
+
+    def test_hash_join_key_range(self):
+        self.prepare_db()
+
+        merge = self.query_all("")
+        hashed = self.query_all("/*+ hash_join() */")
+        for i in range(len(merge)):
+            if merge[i][1] != hashed[i][1]:
+                tdLog.exit(f"hash join returns different result for {hashed[i][0]}: {merge[i][1]} vs {hashed[i][1]}")
+
+        tdSql.query("select /*+ hash_join() */ a.ts, b.c1 from db_hjr.ta a join db_hjr.tc b on a.ts = b.ts;")
+        tdSql.checkRows(0)
+        tdSql.query("select /*+ hash_join() */ count(*) from db_hjr.ta a join db_hjr.tb b on a.ts = b.ts;")
+        tdSql.checkData(0, 0, 5000)
+
+    def run(self):
+        self.test_hash_join_key_range()
+
+    def stop(self):
+        tdSql.execute("drop database if exists db_hjr;")
+        tdSql.close()
+        tdLog.success("%s successfully executed" % __file__)
+
+tdCases.addWindows(__file__, TDTestCase())
+tdCases.addLinux(__file__, TDTestCase())
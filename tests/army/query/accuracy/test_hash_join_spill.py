@@ -0,0 +1,89 @@
+from frame.log import *
+from frame.cases import *
+from frame.sql import *
+from frame.caseBase import *
+from frame import *
+from frame.eos import *
+import copy
+
+
+class TDTestCase(TBase):
+    """Verify that a hash join whose build side rows exceed hashJoinMemThreshold, and are flushed to the temp dir,
+       returns the same rows as the merge join
+    """
+    updatecfgDict = {
+        "hashJoinMemThreshold": "32",
+    }
+
+    def init(self, conn, logSql, replicaVar=1):
+        self.replicaVar = int(replicaVar)
+        tdLog.debug("start to execute %s" % __file__)
+        tdSql.init(conn.cursor())
+        self.numOfRows = 40000
+        self.startTs = 1700000000000
+
+    def payload(self, j):
+        # about 1.8KB a row, so that the smaller side still holds about 40MB of row values; the row id at both ends is
+        # checked after the join
+        return f"{j:08d}" + "x" * (1500 + j % 300) + f"{j:08d}"
+
+    def insert(self, table, rows):
+        for k in range(0, len(rows), 400):
+            sql = f"insert into db_hj.{table} values"
+            for j in rows[k:k + 400]:
+                sql += f"({self.startTs + j * 1000}, {j}, {j % 50}, '{self.payload(j)}')"
+            tdSql.execute(sql)
+
+    def prepare_db(self):
+        tdSql.execute("create database db_hj vgroups 1 buffer 256 stt_trigger 1;")
+        tdSql.execute("create table db_hj.ta (ts timestamp, c1 int, c2 int, c4 varchar(2000));")
+        tdSql.execute("create table db_hj.tb (ts timestamp, c1 int, c2 int, c4 varchar(2000));")
+
+        # tb holds every other row of ta and rows beyond the end of ta
+        self.insert("ta", list(range(self.numOfRows)))
+        self.insert("tb", list(range(0, self.numOfRows, 2)) + list(range(self.numOfRows, self.numOfRows + 2000)))
+        tdSql.execute("flush database db_hj;")
+
+    def query_all(self, hint):
+        sqls = [
+            f"select {hint} count(*), sum(a.c1), sum(b.c1), sum(length(a.c4)), sum(length(b.c4)) "
+            f"from db_hj.ta a join db_hj.tb b on a.ts = b.ts;",
+            f"select {hint} a.ts, a.c1, b.c1, substr(a.c4, 1, 8), substr(b.c4, length(b.c4) - 7, 8) "
+            f"from db_hj.ta a join db_hj.tb b on a.ts = b.ts where a.c1 % 997 = 0 order by a.ts;",
+            f"select {hint} count(*), sum(b.c1), sum(length(b.c4)) "
+            f"from db_hj.ta a join db_hj.tb b on a.ts = b.ts and a.c2 = b.c2 where b.c2 < 10;",
+            f"select {hint} count(*), count(b.c1), sum(length(b.c4)) from db_hj.ta a left join db_hj.tb b on a.ts = b.ts;",
+            f"select {hint} a.ts, a.c1, b.c1, substr(b.c4, 1, 8) from db_hj.ta a left join db_hj.tb b on a.ts = b.ts "
+            f"where a.c1 >= 12000 and a.c1 < 12010 order by a.ts;",
+        ]
+        results = []
+        for sql in sqls:
+            tdSql.query(sql)
+            results.append(copy.deepcopy(tdSql.res))
+        return results
+
+    def test_hash_join_spill(self):
+        self.prepare_db()
+
+        merge = self.query_all("")
+        hashed = self.query_all("/*+ hash_join() */")
+        for i in range(len(merge)):
+            if merge[i] != hashed[i]:
+                tdLog.exit(f"spilled hash join returns different result for query {i}: {merge[i]} vs {hashed[i]}")
+
+        tdSql.query("select /*+ hash_join() */ count(*) from db_hj.ta a join db_hj.tb b on a.ts = b.ts;")
+        tdSql.checkData(0, 0, self.numOfRows // 2)
+        tdSql.query("select /*+ hash_join() */ substr(b.c4, 1, 8) from db_hj.ta a join db_hj.tb b on a.ts = b.ts "
+                    "order by a.ts desc limit 1;")
+        tdSql.checkData(0, 0, f"{self.numOfRows - 2:08d}")
+
+    def run(self):
+        self.test_hash_join_spill()
+
+    def stop(self):
+        tdSql.execute("drop database if exists db_hj;")
+        tdSql.close()
+        tdLog.success("%s successfully executed" % __file__)
+
+tdCases.addWindows(__file__, TDTestCase())
+tdCases.addLinux(__file__, TDTestCase())
@@ -0,0 +1,97 @@
+from frame.log import *
+from frame.cases import *
+from frame.sql import *
+from frame.caseBase import *
+from frame import *
+from frame.eos import *
+import copy
+
+
+class TDTestCase(TBase):
+    """Verify that evaluating the scan filter on the filter columns of a clean file block before loading the others
+       returns the same rows as loading the whole block
+    """
+
+    def init(self, conn, logSql, replicaVar=1):
+        self.replicaVar = int(replicaVar)
+        tdLog.debug("start to execute %s" % __file__)
+        tdSql.init(conn.cursor())
+
+    def prepare_db(self, db, compositeKey):
+        # the reader never decodes the filter columns first for tables with a composite primary key, the same rows are
+        # written with a unique key column so that both databases hold the same data
+        pk = "pk int primary key" if compositeKey else "pk int"
+        tdSql.execute(f"create database {db} vgroups 1 stt_trigger 1 minrows 10 maxrows 200;")
+        tdSql.execute(f"create stable {db}.st (ts timestamp, {pk}, c1 int, c2 double, c3 bigint, c4 varchar(16), "
+                      f"c5 nchar(16)) tags(t1 int);")
+        for i in range(10):
+            tdSql.execute(f"create table {db}.ct_{i} using {db}.st tags({i});")
+
+        # c1 grows with time, so a selective filter on it keeps rows of a few 200-row blocks only; c3 is null in every
+        # third block
+        start_ts = 1700000000000
+        for i in range(10):
+            sql = f"insert into {db}.ct_{i} values"
+            for j in range(2000):
+                c3 = "null" if (j // 200) % 3 == 1 else f"{j * 7 - i}"
+                sql += f"({start_ts + j * 1000}, 0, {i * 10000 + j}, {j * 0.5 + i}, {c3}, 'v{j % 11}', 'n{j % 5}')"
+            tdSql.execute(sql)
+        tdSql.execute(f"flush database {db};")
+
+        # rows updated in the memtable make some blocks merged, which are loaded as a whole
+        tdSql.execute(f"insert into {db}.ct_2 values({start_ts + 500 * 1000}, 0, 20600, -1.0, -1, 'upd', 'upd');")
+        tdSql.execute(f"insert into {db}.ct_4 values({start_ts + 1900 * 1000}, 0, -7, 1e9, 7, 'upd', 'upd');")
+
+    def query_all(self, db):
+        sqls = [
+            # the filter drops every row of most blocks
+            f"select ts, c1, c2, c3, c4, c5 from {db}.st where c1 = 20600 order by ts, c1;",
+            f"select ts, c1, c2, c4 from {db}.st where c1 >= 30100 and c1 < 30250 order by ts, c1;",
+            f"select count(*), sum(c2), max(c3), last(c5) from {db}.st where c2 > 1003.5 and c2 < 1004.5;",
+            f"select ts, c1, c3, c5 from {db}.st where c1 < 0 or c1 > 95000 order by ts, c1;",
+            f"select ts, c1, c2 from {db}.ct_2 where c4 = 'upd' order by ts;",
+            # filters on a column with nulls and on var-length columns
+            f"select count(*), sum(c1), max(c2) from {db}.st where c3 > 13900;",
+            f"select count(*), sum(c1), min(c2) from {db}.st where c3 is null and c1 % 10000 < 300;",
+            f"select ts, c1, c2 from {db}.st where c4 = 'v3' and c5 = 'n1' and c1 % 10000 < 100 order by ts, c1;",
+            # filters keeping some or all rows of a block
+            f"select count(*), sum(c1), sum(c3) from {db}.st where c1 % 10000 >= 1000;",
+            f"select tbname, count(*), first(c2), last(c4) from {db}.st where c1 % 2 = 0 partition by tbname "
+            f"order by tbname;",
+            f"select ts, c1, c2, c4 from {db}.st where c1 > 50000 order by ts desc, c1 desc limit 100;",
+            f"select count(*), max(c2) from {db}.st where c1 > 1000000;",
+        ]
+        results = []
+        for sql in sqls:
+            tdSql.query(sql)
+            results.append(copy.deepcopy(tdSql.res))
+        return results
+
+    def test_late_materialize(self):
+        self.prepare_db("db_whole", True)
+        self.prepare_db("db_late", False)
+
+        whole = self.query_all("db_whole")
+        late = self.query_all("db_late")
+        for i in range(len(whole)):
+            if whole[i] != late[i]:
+                tdLog.exit(f"late materialization returns different result for query {i}: {whole[i]} vs {late[i]}")
+
+        # the projection of the filter column alone loads the whole block as well
+        tdSql.query("select ts, c1 from db_late.st where c1 = 20600 order by ts, c1;")
+        tdSql.checkRows(2)
+        tdSql.query("select ts, c1, c2 from db_late.st where c1 = 20600 order by ts, c1;")
+        tdSql.checkRows(2)
+        tdSql.checkData(0, 2, -1.0)
+
+    def run(self):
+        self.test_late_materialize()
+
+    def stop(self):
+        tdSql.execute("drop database if exists db_whole;")
+        tdSql.execute("drop database if exists db_late;")
+        tdSql.close()
+        tdLog.success("%s successfully executed" % __file__)
+
+tdCases.addWindows(__file__, TDTestCase())
+tdCases.addLinux(__file__, TDTestCase())
@@ -0,0 +1,87 @@
+from frame.log import *
+from frame.cases import *
+from frame.sql import *
+from frame.caseBase import *
+from frame import *
+from frame.eos import *
+import copy
+
+
+class TDTestCase(TBase):
+    """Verify that scanning the child tables of a vnode with parallel workers returns the same rows as the serial scan
+    """
+    updatecfgDict = {
+        "tsdbParallelScanThreads": "4",
+        "tsdbParallelScanVnodeWorkers": "4",
+        "tsdbParallelScanMinTables": "1000000",
+    }
+
+    def init(self, conn, logSql, replicaVar=1):
+        self.replicaVar = int(replicaVar)
+        tdLog.debug("start to execute %s" % __file__)
+        tdSql.init(conn.cursor())
+
+    def prepare_data(self):
+        tdSql.execute("create database db_para vgroups 1 stt_trigger 1 minrows 10 maxrows 200;")
+        tdSql.execute("use db_para;")
+        tdSql.execute("create stable st (ts timestamp, c1 int, c2 double, c3 varchar(16)) tags(t1 int);")
+        for i in range(40):
+            tdSql.execute(f"create table ct_{i} using st tags({i});")
+
+        # rows in data files, then overlapping rows in stt files, then the latest rows in the memtable
+        start_ts = 1700000000000
+        for r in range(3):
+            for i in range(40):
+                sql = f"insert into ct_{i} values"
+                for j in range(500):
+                    ts = start_ts + (j * 3 + r) * 1000
+                    sql += f"({ts}, {i * 1000 + j}, {j * 0.5}, 'v{(i + j + r) % 7}')"
+                tdSql.execute(sql)
+            if r < 2:
+                tdSql.execute("flush database db_para;")
+
+        tdSql.execute(f"delete from ct_3 where ts < {start_ts + 300 * 1000};")
+
+    def query_all(self, sqls):
+        results = []
+        for sql in sqls:
+            tdSql.query(sql)
+            results.append(copy.deepcopy(tdSql.res))
+        return results
+
+    def test_parallel_scan(self):
+        sqls = [
+            "select count(*), sum(c1), max(c2), min(ts) from db_para.st;",
+            "select count(*), sum(c1) from db_para.st where c1 % 3 = 1;",
+            "select tbname, count(*), last(c1), first(c3) from db_para.st partition by tbname order by tbname;",
+            "select * from db_para.st order by ts, t1;",
+            "select ts, c1, c3 from db_para.st where c3 = 'v2' order by ts, c1;",
+            "select _wstart, count(*), sum(c1) from db_para.st interval(10m) order by _wstart;",
+        ]
+
+        # no reader has enough tables for two workers
+        serial = self.query_all(sqls)
+
+        tdSql.execute("alter all dnodes 'tsdbParallelScanMinTables 1';")
+        parallel = self.query_all(sqls)
+
+        for i in range(len(sqls)):
+            if serial[i] != parallel[i]:
+                tdLog.exit(f"parallel scan returns different result, sql:{sqls[i]}, rows:{len(serial[i])} vs {len(parallel[i])}")
+
+        tdSql.query("select count(*) from db_para.st;")
+        tdSql.checkData(0, 0, 40 * 1500 - 300)
+
+        tdSql.execute("alter all dnodes 'tsdbParallelScanMinTables 1000000';")
+
+    def run(self):
+        self.prepare_data()
+        self.test_parallel_scan()
+
+    def stop(self):
+        tdSql.execute("drop database db_para;")
+        tdSql.close()
+        tdLog.success("%s successfully executed" % __file__)
+
+tdCases.addWindows(__file__, TDTestCase())
+tdCases.addLinux(__file__, TDTestCase())
@@ -0,0 +1,89 @@
+from frame.log import *
+from frame.cases import *
+from frame.sql import *
+from frame.caseBase import *
+from frame import *
+from frame.eos import *
+import copy
+
+
+class TDTestCase(TBase):
+    """Verify that skipping the rows below the top-N threshold of the bounded priority queue sort returns the same rows
+       as the full sort
+    """
+
+    def init(self, conn, logSql, replicaVar=1):
+        self.replicaVar = int(replicaVar)
+        tdLog.debug("start to execute %s" % __file__)
+        tdSql.init(conn.cursor())
+
+    def prepare_db(self):
+        tdSql.execute("create database db_topn vgroups 2 stt_trigger 1 minrows 10 maxrows 4096;")
+        tdSql.execute("create stable db_topn.st (ts timestamp, c1 int, c2 double, c3 bigint, c4 varchar(16), "
+                      "c5 bool) tags(t1 int);")
+        for i in range(4):
+            tdSql.execute(f"create table db_topn.ct_{i} using db_topn.st tags({i});")
+
+        # 20000 rows of each table span several sort input blocks, c1 repeats so that rows tie on the first order key,
+        # c2 and c3 are null every 7 and 13 rows
+        start_ts = 1700000000000
+        for i in range(4):
+            for b in range(4):
+                sql = f"insert into db_topn.ct_{i} values"
+                for j in range(b * 5000, (b + 1) * 5000):
+                    c2 = "null" if j % 7 == 0 else f"{((j * 37 + i * 11) % 10007) * 0.25 - 1000}"
+                    c3 = "null" if j % 13 == 0 else f"{(j * 7919 + i) % 100003 - 50000}"
+                    sql += f"({start_ts + j * 1000}, {(j * 31 + i) % 997}, {c2}, {c3}, 'v{(j * 17) % 1009}', {j % 3 == 0})"
+                tdSql.execute(sql)
+            if i % 2 == 0:
+                tdSql.execute("flush database db_topn;")
+
+    def check_topn(self, sql, limit, offset=0):
+        tdSql.query(f"{sql} limit {limit} offset {offset};")
+        topn = copy.deepcopy(tdSql.res)
+        tdSql.query(f"{sql};")
+        full = copy.deepcopy(tdSql.res)[offset:offset + limit]
+        if topn != full:
+            tdLog.exit(f"top-N sort returns different rows from the full sort: {sql} limit {limit} offset {offset}")
+
+    def test_pq_topn(self):
+        self.prepare_db()
+
+        orders = [
+            "c1, ts",
+            "c1 desc, ts",
+            "c2, ts",
+            "c2 desc, ts",
+            "c2 nulls last, ts",
+            "c2 desc nulls first, ts",
+            "c3, ts desc",
+            "c3 desc nulls last, ts",
+            "c4, ts",
+            "c5 desc, ts",
+            "ts desc",
+        ]
+        for order in orders:
+            for limit, offset in [(1, 0), (10, 0), (100, 50), (3000, 0)]:
+                self.check_topn(f"select ts, c1, c2, c3, c4 from db_topn.ct_1 order by {order}", limit, offset)
+                self.check_topn(f"select ts, c1, c2, c3, c4, t1 from db_topn.st order by {order}, t1", limit, offset)
+
+        # the order key is an expression or the input is filtered before the sort
+        self.check_topn("select ts, c1, c2 from db_topn.st order by c1 * 2 - c3, ts, t1", 20)
+        self.check_topn("select ts, c1, c3 from db_topn.st where c1 > 900 order by c3 desc, ts, t1", 50)
+        self.check_topn("select ts, c1 from db_topn.ct_2 where c1 = 500 order by c1, ts", 5)
+
+        tdSql.query("select c1 from db_topn.st order by c1 limit 1;")
+        tdSql.checkData(0, 0, 0)
+        tdSql.query("select c3 from db_topn.st order by c3 desc nulls first limit 1;")
+        tdSql.checkData(0, 0, None)
+
+    def run(self):
+        self.test_pq_topn()
+
+    def stop(self):
+        tdSql.execute("drop database if exists db_topn;")
+        tdSql.close()
+        tdLog.success("%s successfully executed" % __file__)
+
+tdCases.addWindows(__file__, TDTestCase())
+tdCases.addLinux(__file__, TDTestCase())
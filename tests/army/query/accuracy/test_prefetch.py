@@ -0,0 +1,134 @@
+from frame.log import *
+from frame.cases import *
+from frame.sql import *
+from frame.caseBase import *
+from frame.srvCtl import *
+from frame import *
+from frame.eos import *
+import copy
+import glob
+import re
+import time
+
+
+class TDTestCase(TBase):
+    """Verify that reading ahead file blocks and the file sets on other disks returns the same rows as reading
+       without read-ahead, in both scan orders
+    """
+    updatecfgDict = {
+        "tsdbPrefetchBlocks": "0",
+        "tsdbDebugFlag": "143",
+    }
+
+    def init(self, conn, logSql, replicaVar=1):
+        self.replicaVar = int(replicaVar)
+        tdLog.debug("start to execute %s" % __file__)
+        tdSql.init(conn.cursor())
+        self.numOfDays = 12
+        self.numOfTables = 4
+        self.startTs = 1700000000000
+
+    def prepare_data(self):
+        # one file set a day, spread over the data disks, each with many small blocks
+        tdSql.execute("create database db_prefetch vgroups 1 duration 1d keep 3650d stt_trigger 1 minrows 10 maxrows 200;")
+        tdSql.execute("create stable db_prefetch.st (ts timestamp, c1 int, c2 double, c3 varchar(16)) tags(t1 int);")
+        for i in range(self.numOfTables):
+            tdSql.execute(f"create table db_prefetch.ct_{i} using db_prefetch.st tags({i});")
+
+        for d in range(self.numOfDays):
+            for i in range(self.numOfTables):
+                sql = f"insert into db_prefetch.ct_{i} values"
+                for j in range(1000):
+                    ts = self.startTs + d * 86400000 + j * 60000
+                    sql += f"({ts}, {i * 100000 + d * 1000 + j}, {j * 0.5}, 'v{(i + j) % 7}')"
+                tdSql.execute(sql)
+            tdSql.execute("flush database db_prefetch;")
+
+        # a hole of deleted file sets and rows in the memtable on top of the files
+        tdSql.execute(f"delete from db_prefetch.st where ts >= {self.startTs + 4 * 86400000} and "
+                      f"ts < {self.startTs + 6 * 86400000};")
+        tdSql.execute(f"insert into db_prefetch.ct_1 values({self.startTs + 7 * 86400000 + 30000}, -1, -1.0, 'mem');")
+
+    def query_all(self):
+        mid = self.startTs + 3 * 86400000 + 12345
+        sqls = [
+            "select count(*), sum(c1), min(ts), max(ts) from db_prefetch.st;",
+            "select ts, c1, c3 from db_prefetch.st order by ts asc, c1 limit 3000;",
+            "select ts, c1, c3 from db_prefetch.st order by ts desc, c1 limit 3000;",
+            "select ts, c1 from db_prefetch.ct_1 order by ts desc;",
+            "select _wstart, count(*), sum(c1) from db_prefetch.st interval(1d) order by _wstart desc;",
+            f"select count(*), sum(c1) from db_prefetch.st where ts > {mid} and ts < {mid + 5 * 86400000};",
+            "select tbname, first(c1), last(c1), count(*) from db_prefetch.st partition by tbname order by tbname;",
+        ]
+        results = []
+        for sql in sqls:
+            tdSql.query(sql)
+            results.append(copy.deepcopy(tdSql.res))
+        return results
+
+    def test_prefetch(self):
+        plain = self.query_all()
+
+        for blocks in (1, 8, 1024):
+            tdSql.execute(f"alter all dnodes 'tsdbPrefetchBlocks {blocks}';")
+            ahead = self.query_all()
+            for i in range(len(plain)):
+                if plain[i] != ahead[i]:
+                    tdLog.exit(f"read-ahead of {blocks} blocks returns different result for query {i}, "
+                               f"rows:{len(plain[i])} vs {len(ahead[i])}")
+
+        tdSql.query("select count(*) from db_prefetch.st;")
+        tdSql.checkData(0, 0, (self.numOfDays - 2) * self.numOfTables * 1000 + 1)
+
+        tdSql.execute("alter all dnodes 'tsdbPrefetchBlocks 0';")
+
+    def prefetched_readers(self):
+        # the readers that issued read-ahead, from the io-cost summary logged when a reader is closed
+        time.sleep(2)
+        count = 0
+        for file in glob.glob(f"{sc.clusterRootPath()}/dnode*/log/taosdlog.*"):
+            with open(file, errors="ignore") as f:
+                for line in f:
+                    m = re.search(r"prefetch-blocks:(\d+)", line)
+                    if m is not None and int(m.group(1)) > 0:
+                        count += 1
+        return count
+
+    def test_prefetch_desc(self):
+        # scans of many tables in descending order, the blocks of all tables are read in one sorted block list
+        sqls = [
+            "select ts, c1 from db_prefetch.st order by ts desc;",
+            "select _wstart, count(*), sum(c1) from db_prefetch.st interval(1h) order by _wstart desc;",
+            "select last(c1), last(ts) from db_prefetch.st where c1 % 3 = 0;",
+        ]
+        tdSql.execute("alter all dnodes 'tsdbPrefetchBlocks 0';")
+        plain = []
+        for sql in sqls:
+            tdSql.query(sql)
+            plain.append(copy.deepcopy(tdSql.res))
+
+        tdSql.execute("alter all dnodes 'tsdbPrefetchBlocks 8';")
+        before = self.prefetched_readers()
+        for i in range(len(sqls)):
+            tdSql.query(sqls[i])
+            if tdSql.res != plain[i]:
+                tdLog.exit(f"read-ahead returns different result for descending query {i}")
+        after = self.prefetched_readers()
+        tdLog.info(f"readers with read-ahead before:{before} after:{after}")
+        if after <= before:
+            tdLog.exit("descending scans of many tables issue no read-ahead")
+
+        tdSql.execute("alter all dnodes 'tsdbPrefetchBlocks 0';")
+
+    def run(self):
+        self.prepare_data()
+        self.test_prefetch()
+        self.test_prefetch_desc()
+
+    def stop(self):
+        tdSql.execute("drop database if exists db_prefetch;")
+        tdSql.close()
+        tdLog.success("%s successfully executed" % __file__)
+
+tdCases.addWindows(__file__, TDTestCase())
+tdCases.addLinux(__file__, TDTestCase())
@@ -0,0 +1,131 @@
+from frame.log import *
+from frame.cases import *
+from frame.sql import *
+from frame.caseBase import *
+from frame import *
+from frame.eos import *
+import copy
+
+
+class TDTestCase(TBase):
+    """Verify that skipping file blocks covered by a tomb record, and pruning covered tomb records, returns the same
+       rows as a database that never held the deleted rows
+    """
+
+    def init(self, conn, logSql, replicaVar=1):
+        self.replicaVar = int(replicaVar)
+        tdLog.debug("start to execute %s" % __file__)
+        tdSql.init(conn.cursor())
+        self.numOfTables = 6
+        self.numOfRows = 2000
+        self.startTs = 1700000000000
+        # the rows of each table kept by the deleting database, ts -> (c1, c2)
+        self.rows = {}
+
+    def create_db(self, db):
+        tdSql.execute(f"create database {db} vgroups 1 stt_trigger 1 minrows 10 maxrows 200;")
+        tdSql.execute(f"create stable {db}.st (ts timestamp, c1 int, c2 double) tags(t1 int);")
+        for i in range(self.numOfTables):
+            tdSql.execute(f"create table {db}.ct_{i} using {db}.st tags({i});")
+
+    def ts(self, j):
+        return self.startTs + j * 1000
+
+    def insert(self, db, i, rows):
+        sql = f"insert into {db}.ct_{i} values"
+        for j, (c1, c2) in sorted(rows.items()):
+            sql += f"({j}, {c1}, {c2})"
+        tdSql.execute(sql)
+        self.rows[i].update(rows)
+
+    def delete(self, db, i, skey, ekey):
+        tdSql.execute(f"delete from {db}.ct_{i} where ts >= {skey} and ts <= {ekey};")
+        for ts in [ts for ts in self.rows[i] if skey <= ts <= ekey]:
+            del self.rows[i][ts]
+
+    def prepare_delete_db(self, db):
+        self.create_db(db)
+        for i in range(self.numOfTables):
+            self.rows[i] = {}
+            self.insert(db, i, {self.ts(j): (i * 100000 + j, j * 0.5) for j in range(self.numOfRows)})
+        tdSql.execute(f"flush database {db};")
+
+        # each table holds 10 file blocks of 200 rows, the deletes below cover whole blocks, parts of blocks and the
+        # boundary between two blocks
+        self.delete(db, 0, self.ts(400), self.ts(999))
+        self.delete(db, 1, self.ts(0), self.ts(self.numOfRows - 1))
+        self.delete(db, 2, self.ts(350), self.ts(650))
+        # retention style deletes of one table, each covers the previous one
+        for k in range(1, 6):
+            self.delete(db, 3, self.startTs - 1000000, self.ts(k * 200 - 1))
+        tdSql.execute(f"flush database {db};")
+
+        # rows written after the delete are newer than the tomb record, the blocks holding them must not be skipped
+        self.insert(db, 0, {self.ts(j): (-j, -0.5 * j) for j in range(500, 700)})
+        self.insert(db, 3, {self.ts(j): (-j, -0.5 * j) for j in range(100, 150)})
+        tdSql.execute(f"flush database {db};")
+
+        # a delete covering a block that was rewritten after an older delete
+        self.delete(db, 0, self.ts(600), self.ts(799))
+        self.delete(db, 4, self.ts(1000), self.ts(1399))
+        tdSql.execute(f"flush database {db};")
+
+        # deletes still in the memtable
+        self.delete(db, 5, self.ts(1800), self.ts(self.numOfRows - 1))
+
+    def prepare_plain_db(self, db):
+        self.create_db(db)
+        for i in range(self.numOfTables):
+            rows = self.rows[i]
+            sql = f"insert into {db}.ct_{i} values"
+            for ts, (c1, c2) in sorted(rows.items()):
+                sql += f"({ts}, {c1}, {c2})"
+            if len(rows) > 0:
+                tdSql.execute(sql)
+        tdSql.execute(f"flush database {db};")
+
+    def query_all(self, db):
+        sqls = [
+            f"select count(*), sum(c1), min(ts), max(ts) from {db}.st;",
+            f"select tbname, count(*), sum(c1), first(c1), last(c1) from {db}.st partition by tbname order by tbname;",
+            f"select ts, c1, c2 from {db}.ct_0 where ts >= {self.ts(300)} and ts < {self.ts(1100)} order by ts;",
+            f"select ts, c1, c2 from {db}.ct_0 where ts >= {self.ts(300)} and ts < {self.ts(1100)} order by ts desc;",
+            f"select ts, c1 from {db}.ct_3 order by ts limit 300;",
+            f"select ts, c1 from {db}.ct_3 order by ts desc limit 300;",
+            f"select count(*) from {db}.ct_1;",
+            f"select ts, c1 from {db}.ct_2 where ts >= {self.ts(200)} and ts < {self.ts(800)} order by ts;",
+            f"select _wstart, count(*), sum(c1) from {db}.st interval(200s) order by _wstart;",
+            f"select last(ts), last(c1) from {db}.ct_5;",
+            f"select count(*), sum(c1) from {db}.st where c1 < 0;",
+        ]
+        results = []
+        for sql in sqls:
+            tdSql.query(sql)
+            results.append(copy.deepcopy(tdSql.res))
+        return results
+
+    def test_tomb_index(self):
+        self.prepare_delete_db("db_tomb")
+        self.prepare_plain_db("db_plain")
+
+        plain = self.query_all("db_plain")
+        deleted = self.query_all("db_tomb")
+        for i in range(len(plain)):
+            if plain[i] != deleted[i]:
+                tdLog.exit(f"tomb index returns different result for query {i}: {plain[i]} vs {deleted[i]}")
+
+        for i in range(self.numOfTables):
+            tdSql.query(f"select count(*) from db_tomb.ct_{i};")
+            tdSql.checkData(0, 0, len(self.rows[i]))
+
+    def run(self):
+        self.test_tomb_index()
+
+    def stop(self):
+        tdSql.execute("drop database if exists db_tomb;")
+        tdSql.execute("drop database if exists db_plain;")
+        tdSql.close()
+        tdLog.success("%s successfully executed" % __file__)
+
+tdCases.addWindows(__file__, TDTestCase())
+tdCases.addLinux(__file__, TDTestCase())
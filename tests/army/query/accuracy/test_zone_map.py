@@ -0,0 +1,92 @@
+from frame.log import *
+from frame.cases import *
+from frame.sql import *
+from frame.caseBase import *
+from frame import *
+from frame.eos import *
+import copy
+
+
+class TDTestCase(TBase):
+    """Verify that skipping clean file blocks by the zone map of the .head file returns the same rows as reading them
+    """
+    updatecfgDict = {
+        "tsdbZoneMap": "0",
+    }
+
+    def init(self, conn, logSql, replicaVar=1):
+        self.replicaVar = int(replicaVar)
+        tdLog.debug("start to execute %s" % __file__)
+        tdSql.init(conn.cursor())
+
+    def prepare_db(self, db, zoneMap):
+        tdSql.execute(f"alter all dnodes 'tsdbZoneMap {zoneMap}';")
+        tdSql.execute(f"create database {db} vgroups 1 stt_trigger 1 minrows 10 maxrows 200;")
+        tdSql.execute(f"create stable {db}.st (ts timestamp, c1 int, c2 double, c3 bigint, c4 varchar(16)) tags(t1 int);")
+        for i in range(10):
+            tdSql.execute(f"create table {db}.ct_{i} using {db}.st tags({i});")
+
+        # c1 and c2 grow with time, so each 200-row block covers a narrow value range; c3 is null in every other block
+        start_ts = 1700000000000
+        for i in range(10):
+            sql = f"insert into {db}.ct_{i} values"
+            for j in range(2000):
+                c3 = "null" if (j // 200) % 2 == 1 else f"{j * 7 - i}"
+                sql += f"({start_ts + j * 1000}, {i * 10000 + j}, {j * 0.5 + i}, {c3}, 'v{j % 11}')"
+            tdSql.execute(sql)
+        tdSql.execute(f"flush database {db};")
+
+        # rows updated or deleted in the memtable make some blocks merged, where the zone map must not be used
+        tdSql.execute(f"insert into {db}.ct_2 values({start_ts + 500 * 1000}, -1, -1.0, -1, 'upd');")
+        tdSql.execute(f"delete from {db}.ct_3 where ts >= {start_ts + 1200 * 1000} and ts < {start_ts + 1300 * 1000};")
+        tdSql.execute(f"insert into {db}.ct_4 values({start_ts + 1900 * 1000}, 99999999, 1e9, 7, 'upd');")
+
+    def query_all(self, db):
+        sqls = [
+            f"select count(*), sum(c1) from {db}.st where c1 = 20600;",
+            f"select ts, c1, c2 from {db}.st where c1 between 30100 and 30250 order by ts, c1;",
+            f"select ts, c1 from {db}.st where c1 < 0 or c1 > 90000000 order by ts, c1;",
+            f"select count(*) from {db}.st where c2 > 1003.5 and c2 < 1004.5;",
+            f"select count(*), max(c3) from {db}.st where c3 is not null and c3 > 13000;",
+            f"select count(*) from {db}.st where c3 is null;",
+            f"select tbname, count(*), first(c1), last(c1) from {db}.st where c1 % 10000 >= 1250 and c1 % 10000 < 1260 "
+            f"partition by tbname order by tbname;",
+            f"select ts, c1, c4 from {db}.ct_2 where c1 <= 0 or c4 = 'upd' order by ts;",
+            f"select count(*) from {db}.ct_3 where c1 >= 31100 and c1 < 31400;",
+            f"select count(*) from {db}.st where c1 > 1000000000;",
+            f"select count(*), sum(c1) from {db}.st where c1 >= 0;",
+        ]
+        results = []
+        for sql in sqls:
+            tdSql.query(sql)
+            results.append(copy.deepcopy(tdSql.res))
+        return results
+
+    def test_zone_map(self):
+        self.prepare_db("db_nozone", 0)
+        self.prepare_db("db_zone", 1)
+
+        plain = self.query_all("db_nozone")
+        pruned = self.query_all("db_zone")
+        for i in range(len(plain)):
+            if plain[i] != pruned[i]:
+                tdLog.exit(f"zone map pruning returns different result for query {i}: {plain[i]} vs {pruned[i]}")
+
+        tdSql.query("select count(*) from db_zone.st where c1 = 20600;")
+        tdSql.checkData(0, 0, 1)
+        tdSql.query("select count(*) from db_zone.ct_3 where c1 >= 31100 and c1 < 31400;")
+        tdSql.checkData(0, 0, 200)
+
+        tdSql.execute("alter all dnodes 'tsdbZoneMap 0';")
+
+    def run(self):
+        self.test_zone_map()
+
+    def stop(self):
+        tdSql.execute("drop database if exists db_nozone;")
+        tdSql.execute("drop database if exists db_zone;")
+        tdSql.close()
+        tdLog.success("%s successfully executed" % __file__)
+
+tdCases.addWindows(__file__, TDTestCase())
+tdCases.addLinux(__file__, TDTestCase())
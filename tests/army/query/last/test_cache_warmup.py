@@ -0,0 +1,101 @@
+from frame.log import *
+from frame.cases import *
+from frame.sql import *
+from frame.caseBase import *
+from frame.srvCtl import *
+from frame import *
+from frame.eos import *
+import copy
+import time
+
+
+class TDTestCase(TBase):
+    """Verify that warming up the last cache from rocksdb on vnode open returns the same last/last_row results as
+       loading the cache on demand, and never hides rows written while the warm-up runs
+    """
+    updatecfgDict = {
+        "tsdbCacheWarmup": "1",
+    }
+
+    def init(self, conn, logSql, replicaVar=1):
+        self.replicaVar = int(replicaVar)
+        tdLog.debug("start to execute %s" % __file__)
+        tdSql.init(conn.cursor())
+        self.numOfTables = 50
+        self.startTs = 1700000000000
+
+    def prepare_data(self):
+        tdSql.execute("create database db_warmup vgroups 2 cachemodel 'both' stt_trigger 1;")
+        tdSql.execute("create stable db_warmup.st (ts timestamp, c1 int, c2 double, c3 varchar(16)) tags(t1 int);")
+        for i in range(self.numOfTables):
+            tdSql.execute(f"create table db_warmup.ct_{i} using db_warmup.st tags({i});")
+
+        # the latest value of c2 and c3 is null in odd tables, so last() and last_row() differ there
+        for i in range(self.numOfTables):
+            sql = f"insert into db_warmup.ct_{i} values"
+            for j in range(100):
+                c2 = "null" if i % 2 == 1 and j >= 90 else f"{j * 0.5 + i}"
+                c3 = "null" if i % 2 == 1 and j >= 95 else f"'v{i}_{j}'"
+                sql += f"({self.startTs + j * 1000}, {i * 1000 + j}, {c2}, {c3})"
+            tdSql.execute(sql)
+        tdSql.execute("flush database db_warmup;")
+
+    def query_all(self):
+        sqls = [
+            "select last(*) from db_warmup.st;",
+            "select last_row(*) from db_warmup.st;",
+            "select tbname, last(ts), last(c1), last(c2), last(c3) from db_warmup.st partition by tbname order by tbname;",
+            "select tbname, last_row(ts), last_row(c1), last_row(c2), last_row(c3) from db_warmup.st "
+            "partition by tbname order by tbname;",
+        ]
+        results = []
+        for sql in sqls:
+            tdSql.query(sql)
+            results.append(copy.deepcopy(tdSql.res))
+        return results
+
+    def check_same(self, expect, actual, tag):
+        for i in range(len(expect)):
+            if expect[i] != actual[i]:
+                tdLog.exit(f"{tag}: last cache returns different result for query {i}, {expect[i]} vs {actual[i]}")
+
+    def restart(self, warmup):
+        tdSql.execute(f"alter all dnodes 'tsdbCacheWarmup {warmup}';")
+        sc.dnodeStop(1)
+        sc.dnodeStart(1)
+        time.sleep(3)
+
+    def test_cache_warmup(self):
+        expect = self.query_all()
+
+        # the cache is warmed up from rocksdb on vnode open
+        self.restart(1)
+        self.check_same(expect, self.query_all(), "warm-up on")
+
+        # rows written right after the restart race with the warm-up and must win over the values it fetched
+        self.restart(1)
+        for i in range(0, self.numOfTables, 5):
+            tdSql.execute(f"insert into db_warmup.ct_{i} values({self.startTs + 200 * 1000}, {-i}, null, 'new{i}');")
+        time.sleep(2)
+        for i in range(0, self.numOfTables, 5):
+            tdSql.query(f"select last(c1), last(c3), last_row(c2) from db_warmup.ct_{i};")
+            tdSql.checkData(0, 0, -i)
+            tdSql.checkData(0, 1, f"new{i}")
+            tdSql.checkData(0, 2, None)
+        after = self.query_all()
+
+        # the cache is loaded on demand and returns the same values
+        self.restart(0)
+        self.check_same(after, self.query_all(), "warm-up off")
+
+    def run(self):
+        self.prepare_data()
+        self.test_cache_warmup()
+
+    def stop(self):
+        tdSql.execute("drop database if exists db_warmup;")
+        tdSql.close()
+        tdLog.success("%s successfully executed" % __file__)
+
+tdCases.addWindows(__file__, TDTestCase())
+tdCases.addLinux(__file__, TDTestCase())
@@ -0,0 +1,154 @@
+###################################################################
+#           Copyright (c) 2016 by TAOS Technologies, Inc.
+#                     All rights reserved.
+#
+#  This file is proprietary and confidential to TAOS Technologies.
+#  No part of this file may be reproduced, stored, transmitted,
+#  disclosed or used in any form or by any means other than as
+#  expressly provided by the written permission from Jianhui Tao
+#
+###################################################################
+
+# -*- coding: utf-8 -*-
+
+import os
+import glob
+import re
+import time
+import copy
+
+from frame.log import *
+from frame.cases import *
+from frame.sql import *
+from frame.caseBase import *
+from frame.srvCtl import *
+from frame import *
+from frame.eos import *
+
+
+class TDTestCase(TBase):
+    """Verify that committing the file sets of a vnode with several threads writes the same data and file set
+       layout as the serial commit
+    """
+    updatecfgDict = {
+        "tsdbCommitThreads": "1",
+    }
+
+    def init(self, conn, logSql, replicaVar=1):
+        self.replicaVar = int(replicaVar)
+        tdLog.debug("start to execute %s" % __file__)
+        tdSql.init(conn.cursor())
+        self.numOfDays = 10
+        self.numOfTables = 8
+        self.numOfRows = 200
+        self.startTs = 1700000000000
+
+    def insertRound(self, db, round):
+        # every round writes rows to each of the numOfDays file sets and overwrites part of the previous round
+        for i in range(self.numOfTables):
+            sql = f"insert into {db}.ct_{i} values"
+            for d in range(self.numOfDays):
+                for j in range(self.numOfRows):
+                    ts = self.startTs + d * 86400000 + (j * 2 + round) * 1000
+                    sql += f"({ts}, {i * 100000 + d * 1000 + j + round}, {j * 0.25}, 'r{round}_{(i + j) % 5}')"
+            tdSql.execute(sql)
+
+    def prepareDb(self, db):
+        tdSql.execute(f"create database {db} vgroups 1 duration 1d keep 3650d stt_trigger 1 minrows 10 maxrows 200;")
+        tdSql.execute(f"create stable {db}.st (ts timestamp, c1 int, c2 double, c3 varchar(16)) tags(t1 int);")
+        for i in range(self.numOfTables):
+            tdSql.execute(f"create table {db}.ct_{i} using {db}.st tags({i});")
+
+    def commitRounds(self, db, threads):
+        tdSql.execute(f"alter all dnodes 'tsdbCommitThreads {threads}';")
+        for r in range(3):
+            self.insertRound(db, r)
+            if r == 2:
+                # the deletes of the last round go through the tomb data of every file set
+                tdSql.execute(f"delete from {db}.ct_1 where ts < {self.startTs + 3 * 86400000};")
+                tdSql.execute(f"delete from {db}.st where ts >= {self.startTs + 5 * 86400000} and "
+                              f"ts < {self.startTs + 5 * 86400000 + 60000};")
+            tdSql.execute(f"flush database {db};")
+        tdSql.execute("alter all dnodes 'tsdbCommitThreads 1';")
+
+    def tsdbFiles(self, db):
+        tdSql.query(f"select vgroup_id from information_schema.ins_vgroups where db_name = '{db}';")
+        vgId = tdSql.getData(0, 0)
+        rootPath = sc.clusterRootPath()
+        files = glob.glob(f"{rootPath}/dnode*/data/vnode/vnode{vgId}/tsdb/v{vgId}f*")
+        layout = {}
+        for file in files:
+            m = re.match(r"v\d+f(-?\d+)ver\d+\.(\w+)", os.path.basename(file))
+            if m is None:
+                continue
+            fid, ftype = int(m.group(1)), m.group(2)
+            layout.setdefault(fid, {})
+            layout[fid][ftype] = layout[fid].get(ftype, 0) + 1
+        return layout
+
+    def queryAll(self, db):
+        sqls = [
+            f"select count(*), sum(c1), max(c2), min(ts), max(ts) from {db}.st;",
+            f"select tbname, count(*), sum(c1), first(c3), last(c3) from {db}.st partition by tbname order by tbname;",
+            f"select _wstart, count(*), sum(c1) from {db}.st interval(1d) order by _wstart;",
+            f"select ts, c1, c3 from {db}.ct_1 order by ts;",
+            f"select ts, c1, c3 from {db}.ct_6 where c3 like 'r2%' order by ts;",
+        ]
+        results = []
+        for sql in sqls:
+            tdSql.query(sql)
+            results.append(copy.deepcopy(tdSql.res))
+        return results
+
+    def checkSame(self, serial, parallel, tag):
+        for i in range(len(serial)):
+            if serial[i] != parallel[i]:
+                tdLog.exit(f"{tag}: parallel commit returns different result for query {i}, "
+                           f"rows:{len(serial[i])} vs {len(parallel[i])}")
+
+    def run(self):
+        self.prepareDb("db_serial")
+        self.prepareDb("db_para")
+
+        self.commitRounds("db_serial", 1)
+        self.commitRounds("db_para", 4)
+
+        # the rows
+        serial = self.queryAll("db_serial")
+        parallel = self.queryAll("db_para")
+        self.checkSame(serial, parallel, "after commit")
+
+        tdSql.query("select count(*) from db_para.st;")
+        if tdSql.getData(0, 0) <= 0:
+            tdLog.exit("no rows committed")
+
+        # the file operations: every file set is committed once and the replaced files are removed
+        time.sleep(2)
+        serialFiles = self.tsdbFiles("db_serial")
+        paraFiles = self.tsdbFiles("db_para")
+        tdLog.info(f"serial file sets:{serialFiles}")
+        tdLog.info(f"parallel file sets:{paraFiles}")
+        if len(paraFiles) != self.numOfDays:
+            tdLog.exit(f"parallel commit writes {len(paraFiles)} file sets, expect {self.numOfDays}")
+        if sorted(paraFiles.keys()) != sorted(serialFiles.keys()):
+            tdLog.exit("parallel commit writes different file sets from the serial commit")
+        for fid, ftypes in paraFiles.items():
+            for ftype in ("head", "data"):
+                if ftypes.get(ftype, 0) != 1:
+                    tdLog.exit(f"fid:{fid} has {ftypes.get(ftype, 0)} {ftype} files after parallel commit")
+
+        # the file system state written by the commit survives a restart
+        sc.dnodeStop(1)
+        sc.dnodeStart(1)
+        time.sleep(3)
+        self.checkSame(serial, self.queryAll("db_para"), "after restart")
+
+    def stop(self):
+        tdSql.execute("drop database if exists db_serial;")
+        tdSql.execute("drop database if exists db_para;")
+        tdSql.close()
+        tdLog.success("%s successfully executed" % __file__)
+
+
+tdCases.addWindows(__file__, TDTestCase())
+tdCases.addLinux(__file__, TDTestCase())
@@ -0,0 +1,127 @@
+###################################################################
+#           Copyright (c) 2016 by TAOS Technologies, Inc.
+#                     All rights reserved.
+#
+#  This file is proprietary and confidential to TAOS Technologies.
+#  No part of this file may be reproduced, stored, transmitted,
+#  disclosed or used in any form or by any means other than as
+#  expressly provided by the written permission from Jianhui Tao
+#
+###################################################################
+
+# -*- coding: utf-8 -*-
+
+import glob
+import re
+import time
+import copy
+
+from frame.log import *
+from frame.cases import *
+from frame.sql import *
+from frame.caseBase import *
+from frame.srvCtl import *
+from frame import *
+from frame.eos import *
+
+
+class TDTestCase(TBase):
+    """Verify that data file blocks cut at the boundaries of tsdbRollupInterval let aligned INTERVAL queries load the
+       block SMA only, and return the same rows as blocks written without it
+    """
+    updatecfgDict = {
+        "tsdbRollupInterval": "0",
+        "tsdbDebugFlag": "143",
+    }
+
+    def init(self, conn, logSql, replicaVar=1):
+        self.replicaVar = int(replicaVar)
+        tdLog.debug("start to execute %s" % __file__)
+        tdSql.init(conn.cursor())
+        self.startTs = 1700000000000
+
+    def prepareDb(self, db, rollup):
+        tdSql.execute(f"alter all dnodes 'tsdbRollupInterval {rollup}';")
+        tdSql.execute(f"create database {db} vgroups 1 duration 10d stt_trigger 1 minrows 10 maxrows 4096;")
+        tdSql.execute(f"create stable {db}.st (ts timestamp, c1 int, c2 double) tags(t1 int);")
+        for i in range(2):
+            tdSql.execute(f"create table {db}.ct_{i} using {db}.st tags({i});")
+
+        # a row a minute over 3 days, so blocks of 4096 rows span several hours and days unless they are cut
+        for i in range(2):
+            for k in range(0, 3 * 1440, 1000):
+                sql = f"insert into {db}.ct_{i} values"
+                for j in range(k, min(k + 1000, 3 * 1440)):
+                    sql += f"({self.startTs + j * 60000}, {i * 10000 + j}, {j * 0.5})"
+                tdSql.execute(sql)
+        tdSql.execute(f"flush database {db};")
+        tdSql.execute("alter all dnodes 'tsdbRollupInterval 0';")
+
+    def ioCosts(self):
+        # (SMA loads, file block loads) of every reader, from the io-cost summary logged when a reader is closed
+        time.sleep(2)
+        costs = []
+        for file in sorted(glob.glob(f"{sc.clusterRootPath()}/dnode*/log/taosdlog.*")):
+            with open(file, errors="ignore") as f:
+                for line in f:
+                    m = re.search(r"io-cost summary:.* SMA:(\d+) SMA-time.*fileBlocks:(\d+)", line)
+                    if m is not None:
+                        costs.append((int(m.group(1)), int(m.group(2))))
+        return costs
+
+    def queryCost(self, sql):
+        before = len(self.ioCosts())
+        tdSql.query(sql)
+        res = copy.deepcopy(tdSql.res)
+        costs = self.ioCosts()[before:]
+        sma = sum(c[0] for c in costs)
+        blocks = sum(c[1] for c in costs)
+        tdLog.info(f"{sql} sma:{sma} file blocks:{blocks}")
+        return res, sma, blocks
+
+    def checkAligned(self, db, interval, plainDb):
+        sql = f"select _wstart, count(*), sum(c1), min(c1), max(c1), avg(c2) from {{}}.ct_1 interval({interval});"
+        plain, _, plainBlocks = self.queryCost(sql.format(plainDb))
+        rollup, sma, blocks = self.queryCost(sql.format(db))
+        if plain != rollup:
+            tdLog.exit(f"interval({interval}) returns different result on blocks cut at the rollup interval")
+        if plainBlocks == 0:
+            tdLog.exit(f"interval({interval}) loads no data on blocks written without the rollup interval")
+        if sma == 0 or blocks != 0:
+            tdLog.exit(f"interval({interval}) loads sma:{sma} file blocks:{blocks}, expect the SMA only")
+
+        # a filter or an unaligned window needs the data
+        filtered, _, blocks = self.queryCost(f"select _wstart, count(*) from {db}.ct_1 where c1 % 2 = 0 "
+                                             f"interval({interval});")
+        if blocks == 0:
+            tdLog.exit(f"interval({interval}) with a filter loads no data")
+        tdSql.query(f"select _wstart, count(*) from {plainDb}.ct_1 where c1 % 2 = 0 interval({interval});")
+        if tdSql.res != filtered:
+            tdLog.exit(f"interval({interval}) with a filter returns different result")
+
+    def run(self):
+        self.prepareDb("db_plain", 0)
+        self.prepareDb("db_hour", 3600)
+        self.prepareDb("db_day", 86400)
+
+        self.checkAligned("db_hour", "1h", "db_plain")
+        self.checkAligned("db_hour", "2h", "db_plain")
+        self.checkAligned("db_day", "1d", "db_plain")
+
+        res, _, blocks = self.queryCost("select _wstart, count(*), sum(c1) from db_hour.ct_1 interval(1h, 30m);")
+        tdSql.query("select _wstart, count(*), sum(c1) from db_plain.ct_1 interval(1h, 30m);")
+        if tdSql.res != res:
+            tdLog.exit("interval with offset returns different result")
+        if blocks == 0:
+            tdLog.exit("interval with offset loads no data")
+
+    def stop(self):
+        tdSql.execute("drop database if exists db_plain;")
+        tdSql.execute("drop database if exists db_hour;")
+        tdSql.execute("drop database if exists db_day;")
+        tdSql.close()
+        tdLog.success("%s successfully executed" % __file__)
+
+
+tdCases.addWindows(__file__, TDTestCase())
+tdCases.addLinux(__file__, TDTestCase())